@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Division of dividends twice as long as a divisor of 100 to 100000 limbs, doubling, with trivial division and
+ * Burnikel-Ziegler division over Karatsuba and automatic multiplication:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_Burnikel_Ziegler_dvsn [max divisor limbs = 100000] [max trivial limbs = 6400] [seconds per case = 0.2]
+ *
+ * Times are seconds per division; each growth column is the time over the previous size's, about 4 for quadratic
+ * division, 3 for Karatsuba's and a little over 2 for the transform's.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Runs the division at least once and for about the given time; returns seconds per division.
+     */
+    double measure(
+        double seconds,
+        big_integer const &dividend,
+        big_integer const &divisor,
+        big_integer::division_rule division_rule,
+        big_integer::multiplication_rule multiplication_rule)
+    {
+        size_t divisions_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            auto const quotient = big_integer::divide(dividend, divisor, nullptr, division_rule, multiplication_rule);
+            ++divisions_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(divisions_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 100000;
+    size_t const max_trivial_limbs_count = argc > 2
+        ? std::strtoul(argv[2], nullptr, 10)
+        : 6400;
+    double const seconds = argc > 3
+        ? std::strtod(argv[3], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(10) << "limbs"
+        << std::right << std::setw(14) << "trivial, s"
+        << std::setw(8) << "growth"
+        << std::setw(14) << "Karatsuba, s"
+        << std::setw(8) << "growth"
+        << std::setw(14) << "automatic, s"
+        << std::setw(8) << "growth" << std::endl;
+
+    struct
+    {
+        big_integer::division_rule division_rule;
+        big_integer::multiplication_rule multiplication_rule;
+        double previous;
+    } cases[] = {
+        { big_integer::division_rule::trivial, big_integer::multiplication_rule::trivial, 0 },
+        { big_integer::division_rule::BurnikelZiegler, big_integer::multiplication_rule::Karatsuba, 0 },
+        { big_integer::division_rule::BurnikelZiegler, big_integer::multiplication_rule::automatic, 0 }
+    };
+
+    for (size_t limbs_count = 100; limbs_count <= max_limbs_count; limbs_count *= 2)
+    {
+        auto const divisor = random_value(engine, limbs_count);
+        auto const dividend = random_value(engine, 2 * limbs_count);
+
+        std::cout << std::left << std::setw(10) << limbs_count << std::right;
+        for (auto &current: cases)
+        {
+            if (current.division_rule == big_integer::division_rule::trivial && limbs_count > max_trivial_limbs_count)
+            {
+                std::cout << std::setw(14) << "-" << std::setw(8) << "-";
+                continue;
+            }
+
+            auto const time = measure(seconds, dividend, divisor, current.division_rule, current.multiplication_rule);
+            std::cout << std::scientific << std::setprecision(3) << std::setw(14) << time;
+            if (current.previous == 0)
+            {
+                std::cout << std::setw(8) << "-";
+            }
+            else
+            {
+                std::cout << std::fixed << std::setprecision(2) << std::setw(8) << time / current.previous;
+            }
+            current.previous = time;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Trivial and Karatsuba multiplication of operands from 10 to 100000 limbs, balanced and with
+ * the second operand eight times shorter:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_Karatsuba_mltplctn [max limbs = 100000] [seconds per case = 0.2]
+ *
+ * Trivial multiplication of the largest operands takes seconds per product.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Runs the multiplication at least once and for about the given time; returns seconds per product.
+     */
+    double measure(
+        double seconds,
+        big_integer const &first,
+        big_integer const &second,
+        big_integer::multiplication_rule rule)
+    {
+        size_t products_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            auto const product = big_integer::multiply(first, second, nullptr, rule);
+            ++products_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(products_count);
+    }
+
+    void print_row(
+        std::mt19937_64 &engine,
+        double seconds,
+        size_t first_limbs_count,
+        size_t second_limbs_count)
+    {
+        auto const first = random_value(engine, first_limbs_count);
+        auto const second = random_value(engine, second_limbs_count);
+
+        auto const trivial = measure(seconds, first, second, big_integer::multiplication_rule::trivial);
+        auto const Karatsuba = measure(seconds, first, second, big_integer::multiplication_rule::Karatsuba);
+
+        std::cout << std::left << std::setw(16) << std::to_string(first_limbs_count) + "x" + std::to_string(second_limbs_count)
+            << std::right << std::scientific << std::setprecision(3)
+            << std::setw(14) << trivial
+            << std::setw(14) << Karatsuba
+            << std::fixed << std::setprecision(2)
+            << std::setw(10) << trivial / Karatsuba << std::endl;
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 100000;
+    double const seconds = argc > 2
+        ? std::strtod(argv[2], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(16) << "limbs"
+        << std::right << std::setw(14) << "trivial, s"
+        << std::setw(14) << "Karatsuba, s"
+        << std::setw(10) << "speedup" << std::endl;
+
+    for (size_t limbs_count: { 10, 16, 24, 32, 48, 64, 100, 300, 1000, 3000, 10000, 30000, 100000 })
+    {
+        if (limbs_count <= max_limbs_count)
+        {
+            print_row(engine, seconds, limbs_count, limbs_count);
+        }
+    }
+    for (size_t limbs_count: { 1000, 10000, 100000 })
+    {
+        if (limbs_count <= max_limbs_count)
+        {
+            print_row(engine, seconds, limbs_count, limbs_count / 8);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <big_integer.h>
+
+/*
+ * Division of dividends twice as long as a divisor of 2 to 10000 limbs, a batch of different dividends per divisor
+ * as in modular reduction: trivial division, Newton division with automatic multiplication, which prepares
+ * the divisor on every call, and the divisor prepared once with trivial and with automatic multiplication:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_Newton_dvsn [max divisor limbs = 10000] [seconds per case = 0.2]
+ *
+ * Times are seconds per division.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Divides each dividend at least once and for about the given time; returns seconds per division.
+     */
+    template<
+        typename operation>
+    double measure(
+        double seconds,
+        std::vector<big_integer> const &dividends,
+        operation const &divide)
+    {
+        size_t divisions_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            for (auto const &dividend: dividends)
+            {
+                auto const quotient = divide(dividend);
+            }
+            divisions_count += dividends.size();
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(divisions_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 10000;
+    double const seconds = argc > 2
+        ? std::strtod(argv[2], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(10) << "limbs"
+        << std::right << std::setw(14) << "trivial, s"
+        << std::setw(14) << "Newton, s"
+        << std::setw(16) << "prepared, s"
+        << std::setw(18) << "prepared auto, s"
+        << std::setw(10) << "speedup" << std::endl;
+
+    for (size_t limbs_count: { 2, 8, 32, 100, 300, 1000, 3000, 10000 })
+    {
+        if (limbs_count > max_limbs_count)
+        {
+            break;
+        }
+
+        auto const divisor = random_value(engine, limbs_count);
+        std::vector<big_integer> dividends;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            dividends.push_back(random_value(engine, 2 * limbs_count));
+        }
+
+        big_integer::precomputed_divisor const prepared(divisor);
+        big_integer::precomputed_divisor const prepared_automatic(divisor, big_integer::multiplication_rule::automatic);
+
+        auto const trivial = measure(seconds, dividends, [&divisor](big_integer const &dividend)
+        {
+            return big_integer::divide(dividend, divisor);
+        });
+        auto const Newton = measure(seconds, dividends, [&divisor](big_integer const &dividend)
+        {
+            return big_integer::divide(dividend, divisor, nullptr, big_integer::division_rule::Newton,
+                big_integer::multiplication_rule::automatic);
+        });
+        auto const reused = measure(seconds, dividends, [&prepared](big_integer const &dividend)
+        {
+            return big_integer::divide(dividend, prepared);
+        });
+        auto const reused_automatic = measure(seconds, dividends, [&prepared_automatic](big_integer const &dividend)
+        {
+            return big_integer::divide(dividend, prepared_automatic);
+        });
+
+        std::cout << std::left << std::setw(10) << limbs_count
+            << std::right << std::scientific << std::setprecision(3)
+            << std::setw(14) << trivial
+            << std::setw(14) << Newton
+            << std::setw(16) << reused
+            << std::setw(18) << reused_automatic
+            << std::fixed << std::setprecision(2)
+            << std::setw(10) << trivial / std::min(reused, reused_automatic) << std::endl;
+    }
+
+    return 0;
+}
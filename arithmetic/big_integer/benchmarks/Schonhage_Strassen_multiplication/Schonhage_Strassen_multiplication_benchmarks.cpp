@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Karatsuba and number theoretic transform (Schonhage_Strassen rule) multiplication of balanced operands
+ * doubling from 500 limbs to the given maximum, with the growth of the transform's time per doubling:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_Schonhage_Strassen_mltplctn [max limbs = 1048576] [max Karatsuba limbs = 131072] [seconds per case = 0.2]
+ *
+ * A growth close to 2 is the n log n scaling; Karatsuba's is 3.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Runs the multiplication at least once and for about the given time; returns seconds per product.
+     */
+    double measure(
+        double seconds,
+        big_integer const &first,
+        big_integer const &second,
+        big_integer::multiplication_rule rule)
+    {
+        size_t products_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            auto const product = big_integer::multiply(first, second, nullptr, rule);
+            ++products_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(products_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 1048576;
+    size_t const max_Karatsuba_limbs_count = argc > 2
+        ? std::strtoul(argv[2], nullptr, 10)
+        : 131072;
+    double const seconds = argc > 3
+        ? std::strtod(argv[3], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+    auto const decimal_digits_per_limb = sizeof(big_integer::limb) * 8 * std::log10(2.0);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(10) << "limbs"
+        << std::right << std::setw(14) << "decimal"
+        << std::setw(14) << "Karatsuba, s"
+        << std::setw(14) << "NTT, s"
+        << std::setw(10) << "speedup"
+        << std::setw(10) << "growth" << std::endl;
+
+    double previous = 0;
+    for (size_t limbs_count = 500; limbs_count <= max_limbs_count; limbs_count *= 2)
+    {
+        auto const first = random_value(engine, limbs_count);
+        auto const second = random_value(engine, limbs_count);
+
+        auto const transformed = measure(seconds, first, second, big_integer::multiplication_rule::SchonhageStrassen);
+
+        std::cout << std::left << std::setw(10) << limbs_count
+            << std::right << std::setw(14) << static_cast<size_t>(limbs_count * decimal_digits_per_limb)
+            << std::scientific << std::setprecision(3);
+        if (limbs_count <= max_Karatsuba_limbs_count)
+        {
+            auto const Karatsuba = measure(seconds, first, second, big_integer::multiplication_rule::Karatsuba);
+            std::cout << std::setw(14) << Karatsuba << std::setw(14) << transformed
+                << std::fixed << std::setprecision(2) << std::setw(10) << Karatsuba / transformed;
+        }
+        else
+        {
+            std::cout << std::setw(14) << "-" << std::setw(14) << transformed << std::setw(10) << "-";
+        }
+
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10);
+        if (previous == 0)
+        {
+            std::cout << "-";
+        }
+        else
+        {
+            std::cout << transformed / previous;
+        }
+        std::cout << std::endl;
+
+        previous = transformed;
+    }
+
+    return 0;
+}
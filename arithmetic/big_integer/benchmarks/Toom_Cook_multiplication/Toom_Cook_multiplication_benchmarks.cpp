@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Karatsuba, Toom-3, Toom-4, number theoretic transform (Schonhage_Strassen rule) and automatic multiplication
+ * of balanced operands from 50 to 50000 limbs, for placing the thresholds between the algorithms:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_Toom_Cook_mltplctn [max limbs = 50000] [seconds per case = 0.2]
+ *
+ * The automatic column should follow the smallest of the others.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Runs the multiplication at least once and for about the given time; returns seconds per product.
+     */
+    double measure(
+        double seconds,
+        big_integer const &first,
+        big_integer const &second,
+        big_integer::multiplication_rule rule)
+    {
+        size_t products_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            auto const product = big_integer::multiply(first, second, nullptr, rule);
+            ++products_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(products_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 50000;
+    double const seconds = argc > 2
+        ? std::strtod(argv[2], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(10) << "limbs"
+        << std::right << std::setw(14) << "Karatsuba, s"
+        << std::setw(14) << "Toom-3, s"
+        << std::setw(14) << "Toom-4, s"
+        << std::setw(14) << "NTT, s"
+        << std::setw(14) << "automatic, s" << std::endl;
+
+    for (size_t limbs_count: { 50, 100, 150, 200, 300, 400, 600, 800, 1200, 2000, 3000, 5000, 8000, 12000, 20000, 50000 })
+    {
+        if (limbs_count > max_limbs_count)
+        {
+            break;
+        }
+
+        auto const first = random_value(engine, limbs_count);
+        auto const second = random_value(engine, limbs_count);
+
+        std::cout << std::left << std::setw(10) << limbs_count
+            << std::right << std::scientific << std::setprecision(3);
+        for (auto rule: {
+            big_integer::multiplication_rule::Karatsuba,
+            big_integer::multiplication_rule::Toom3,
+            big_integer::multiplication_rule::Toom4,
+            big_integer::multiplication_rule::SchonhageStrassen,
+            big_integer::multiplication_rule::automatic })
+        {
+            std::cout << std::setw(14) << measure(seconds, first, second, rule);
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
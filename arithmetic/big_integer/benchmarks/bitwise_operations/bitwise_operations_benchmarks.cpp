@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Bitwise operations and shifts of a positive and a negative value of 16 to 100000 limbs. The same source is built
+ * against the configured library, whose limb-wise kernels run in AVX2 or AVX-512 vectors where the processor has
+ * them, and against a copy of it with the scalar kernels only:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_btws_oprtns [max limbs = 100000] [seconds per case = 0.2]
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_btws_oprtns_sclr [max limbs = 100000] [seconds per case = 0.2]
+ *
+ * Times are seconds per operation, including the copies in and out of the values.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Runs the operation at least once and for about the given time; returns seconds per operation.
+     */
+    template<
+        typename operation>
+    double measure(
+        double seconds,
+        operation const &evaluate)
+    {
+        size_t operations_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            auto const result = evaluate();
+            ++operations_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(operations_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 100000;
+    double const seconds = argc > 2
+        ? std::strtod(argv[2], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(10) << "limbs"
+        << std::right << std::setw(12) << "and, s"
+        << std::setw(12) << "or, s"
+        << std::setw(12) << "xor, s"
+        << std::setw(12) << "not, s"
+        << std::setw(12) << "<< 13, s"
+        << std::setw(12) << ">> 13, s" << std::endl;
+
+    for (size_t limbs_count: { 16, 100, 1000, 10000, 100000 })
+    {
+        if (limbs_count > max_limbs_count)
+        {
+            break;
+        }
+
+        auto const first = random_value(engine, limbs_count);
+        auto const second = -random_value(engine, limbs_count);
+
+        std::cout << std::left << std::setw(10) << limbs_count
+            << std::right << std::scientific << std::setprecision(3)
+            << std::setw(12) << measure(seconds, [&]() { return first & second; })
+            << std::setw(12) << measure(seconds, [&]() { return first | second; })
+            << std::setw(12) << measure(seconds, [&]() { return first ^ second; })
+            << std::setw(12) << measure(seconds, [&]() { return ~second; })
+            << std::setw(12) << measure(seconds, [&]() { return second << 13; })
+            << std::setw(12) << measure(seconds, [&]() { return second >> 13; }) << std::endl;
+    }
+
+    return 0;
+}
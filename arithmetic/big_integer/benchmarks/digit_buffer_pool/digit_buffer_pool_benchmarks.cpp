@@ -0,0 +1,161 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <big_integer.h>
+
+/*
+ * The multiplication and division test workloads with digits drawn from digit_buffer_pool
+ * (no allocator) and from a plain operator new allocator.
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_dgt_bffr_pl [max threads = 8] [rounds per thread = 20000]
+ *
+ * Scratch digits of the operations come from the pool in both cases, so the difference is
+ * what recycling the values' own digits saves.
+ */
+namespace
+{
+
+    class heap_allocator final:
+        public allocator
+    {
+
+    public:
+
+        void *allocate(
+            size_t value_size,
+            size_t values_count) override
+        {
+            return ::operator new(value_size * values_count);
+        }
+
+        void deallocate(
+            void *at) override
+        {
+            ::operator delete(at);
+        }
+
+    };
+
+    std::vector<std::pair<char const *, char const *>> const multiplication_operands =
+    {
+        { "2423545763", "3657687978" },
+        { "-28958888309635818", "-234567" },
+        { "8062112134235893450865580976575", "5224253464575690753458936456445353" },
+        { "123424353464389587244387927589346894576464343235445645674563532464675467425", "2354893245937465784937542389428935349086840957804985309763636567574564" },
+        { "999999999999999999999999999977777", "-0000000000000000000000000000000000000000000000000059" }
+    };
+
+    std::vector<std::pair<char const *, char const *>> const division_operands =
+    {
+        { "-28958888309635818", "-234567" },
+        { "806211213", "52" },
+        { "123424353464389587244387927589346894576464343235445645674563532464675467425", "2354893245937465784937542389428935349086840957804985309763636567574564" },
+        { "12342435346438958724438792758934689457646434323544564567456353246467546742553890454890356745895343687456894678934854493068450697557345353", "42389428935349086840957804985309763636567574564" }
+    };
+
+    /*
+     * Runs the workload and returns the number of operations done.
+     */
+    size_t run_rounds(
+        allocator *values_allocator,
+        size_t rounds_count)
+    {
+        std::vector<std::pair<big_integer, big_integer>> multiplied;
+        std::vector<std::pair<big_integer, big_integer>> divided;
+        for (auto &operands: multiplication_operands)
+        {
+            multiplied.emplace_back(big_integer(operands.first, 10, values_allocator), big_integer(operands.second, 10, values_allocator));
+        }
+        for (auto &operands: division_operands)
+        {
+            divided.emplace_back(big_integer(operands.first, 10, values_allocator), big_integer(operands.second, 10, values_allocator));
+        }
+
+        size_t operations_count = 0;
+        for (size_t i = 0; i < rounds_count; ++i)
+        {
+            for (auto &operands: multiplied)
+            {
+                auto product = operands.first * operands.second;
+                product += operands.first;
+                product -= operands.second;
+                operations_count += 3;
+            }
+            for (auto &operands: divided)
+            {
+                auto const quotient = operands.first / operands.second;
+                auto const remainder = operands.first % operands.second;
+                operations_count += 2;
+            }
+        }
+
+        return operations_count;
+    }
+
+    double measure(
+        allocator *values_allocator,
+        size_t threads_count,
+        size_t rounds_per_thread)
+    {
+        std::vector<size_t> operations_counts(threads_count);
+        std::vector<std::thread> threads;
+
+        auto const started = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < threads_count; ++i)
+        {
+            threads.emplace_back([values_allocator, rounds_per_thread, &operations_count = operations_counts[i]]()
+            {
+                operations_count = run_rounds(values_allocator, rounds_per_thread);
+            });
+        }
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        size_t operations_count = 0;
+        for (auto count: operations_counts)
+        {
+            operations_count += count;
+        }
+
+        return static_cast<double>(operations_count) / seconds;
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_threads_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 8;
+    size_t const rounds_per_thread = argc > 2
+        ? std::strtoul(argv[2], nullptr, 10)
+        : 20000;
+
+    heap_allocator heap;
+
+    std::cout << std::left << std::setw(8) << "digits"
+        << std::right << std::setw(4) << "thr"
+        << std::setw(16) << "operations/s" << std::endl;
+
+    for (size_t threads_count = 1; threads_count <= max_threads_count; threads_count *= 2)
+    {
+        std::cout << std::left << std::setw(8) << "pool"
+            << std::right << std::setw(4) << threads_count
+            << std::setw(16) << static_cast<size_t>(measure(nullptr, threads_count, rounds_per_thread)) << std::endl;
+        std::cout << std::left << std::setw(8) << "heap"
+            << std::right << std::setw(4) << threads_count
+            << std::setw(16) << static_cast<size_t>(measure(&heap, threads_count, rounds_per_thread)) << std::endl;
+    }
+
+    return 0;
+}
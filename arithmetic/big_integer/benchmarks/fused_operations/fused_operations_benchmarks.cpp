@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+#include <fraction.h>
+
+/*
+ * Compound expressions on operands of 1 to 1000 limbs, written with operators, which take a temporary per
+ * operator, against the fused mul_add, addmul and submul: a * b + c, the pair x -= a * b, x += a * b, and the
+ * cross sum a * d + c * b of fraction addition. The last column is a whole fraction addition, which accumulates
+ * its numerator with addmul and then reduces the sum:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_fsd_oprtns [max limbs = 1000] [seconds per case = 0.2]
+ *
+ * Times are seconds per expression.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Evaluates the expression at least once and for about the given time; returns seconds per evaluation.
+     */
+    template<
+        typename operation>
+    double measure(
+        double seconds,
+        operation const &evaluate)
+    {
+        size_t evaluations_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            evaluate();
+            ++evaluations_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(evaluations_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 1000;
+    double const seconds = argc > 2
+        ? std::strtod(argv[2], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(8) << "limbs"
+        << std::right << std::setw(12) << "a*b+c, s"
+        << std::setw(12) << "mul_add, s"
+        << std::setw(12) << "x-+=a*b, s"
+        << std::setw(14) << "sub/addmul, s"
+        << std::setw(12) << "ad+cb, s"
+        << std::setw(12) << "fused, s"
+        << std::setw(14) << "fraction +, s" << std::endl;
+
+    for (size_t limbs_count: { 1, 2, 4, 8, 16, 32, 64, 256, 1000 })
+    {
+        if (limbs_count > max_limbs_count)
+        {
+            break;
+        }
+
+        auto const a = random_value(engine, limbs_count);
+        auto const b = random_value(engine, limbs_count);
+        auto const c = random_value(engine, limbs_count);
+        auto const d = random_value(engine, limbs_count);
+        auto x = random_value(engine, 2 * limbs_count);
+        big_integer result("0");
+
+        auto const operators = measure(seconds, [&]()
+        {
+            result = a * b + c;
+        });
+        auto const fused = measure(seconds, [&]()
+        {
+            big_integer::mul_add(result, a, b, c);
+        });
+        auto const accumulated = measure(seconds, [&]()
+        {
+            x -= a * b;
+            x += a * b;
+        }) / 2;
+        auto const fused_accumulated = measure(seconds, [&]()
+        {
+            big_integer::submul(x, a, b);
+            big_integer::addmul(x, a, b);
+        }) / 2;
+        auto const cross_sum = measure(seconds, [&]()
+        {
+            result = a * d + c * b;
+        });
+        auto const fused_cross_sum = measure(seconds, [&]()
+        {
+            big_integer::multiply(result = a, d);
+            big_integer::addmul(result, c, b);
+        });
+
+        fraction const first { big_integer(a), big_integer(b) };
+        fraction const second { big_integer(c), big_integer(d) };
+        auto const fraction_sum = measure(seconds, [&]()
+        {
+            auto const sum = first + second;
+        });
+
+        std::cout << std::left << std::setw(8) << limbs_count
+            << std::right << std::scientific << std::setprecision(3)
+            << std::setw(12) << operators
+            << std::setw(12) << fused
+            << std::setw(12) << accumulated
+            << std::setw(14) << fused_accumulated
+            << std::setw(12) << cross_sum
+            << std::setw(12) << fused_cross_sum
+            << std::setw(14) << fraction_sum << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Addition, schoolbook multiplication and division of values of a few sizes. The same source is built
+ * against the configured library and against a copy of it with 32-bit limbs:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_lmbs [seconds per case = 0.2]
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_lmbs_32 [seconds per case = 0.2]
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t bits)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(bits / 4, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Repeats the operation for about the given time and returns operations per second.
+     */
+    template<
+        typename operation>
+    double measure(
+        double seconds,
+        operation const &run)
+    {
+        size_t operations_count = 0;
+        size_t batch = 1;
+
+        auto const started = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        while (elapsed < seconds)
+        {
+            for (size_t i = 0; i < batch; ++i)
+            {
+                run();
+            }
+            operations_count += batch;
+            batch *= 2;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+
+        return static_cast<double>(operations_count) / elapsed;
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    double const seconds = argc > 1
+        ? std::strtod(argv[1], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(8) << "bits"
+        << std::right << std::setw(16) << "add/s"
+        << std::setw(16) << "multiply/s"
+        << std::setw(16) << "divide/s" << std::endl;
+
+    for (size_t bits: { 256, 1024, 4096, 16384 })
+    {
+        auto const first = random_value(engine, bits);
+        auto const second = random_value(engine, bits);
+        auto const dividend = first * second + first;
+
+        auto sum = first;
+        auto const added = measure(seconds, [&sum, &second]()
+        {
+            sum += second;
+        });
+
+        auto const multiplied = measure(seconds, [&first, &second]()
+        {
+            auto const product = first * second;
+        });
+
+        auto const divided = measure(seconds, [&dividend, &second]()
+        {
+            auto const quotient = dividend / second;
+        });
+
+        std::cout << std::left << std::setw(8) << bits
+            << std::right << std::setw(16) << static_cast<size_t>(added)
+            << std::setw(16) << static_cast<size_t>(multiplied)
+            << std::setw(16) << static_cast<size_t>(divided) << std::endl;
+    }
+
+    return 0;
+}
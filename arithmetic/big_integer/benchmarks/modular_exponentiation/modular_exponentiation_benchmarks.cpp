@@ -0,0 +1,154 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Modular exponentiation with exponents as long as moduli of 256 to 8192 bits: square and multiply with
+ * a product and a trivial division per step, against pow_mod with Montgomery's reduction for an odd modulus,
+ * and Barrett's for the same modulus and for an even one:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_mdlr_xpnnttn [max modulus bits = 8192] [seconds per case = 0.2]
+ *
+ * Times are seconds per exponentiation.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t bits_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(bits_count / 4, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    big_integer power_by_squaring(
+        big_integer const &base,
+        big_integer const &exponent,
+        big_integer const &modulus)
+    {
+        big_integer const zero("0");
+        big_integer const one("1");
+
+        std::vector<bool> bits;
+        for (auto rest = exponent; rest != zero; rest >>= 1)
+        {
+            bits.push_back((rest & one) == one);
+        }
+
+        auto result = one;
+        for (auto bit = bits.size(); bit-- > 0;)
+        {
+            result = big_integer::modulo(result * result, modulus);
+            if (bits[bit])
+            {
+                result = big_integer::modulo(result * base, modulus);
+            }
+        }
+
+        return result;
+    }
+
+    /*
+     * Runs the exponentiation at least once and for about the given time; returns seconds per exponentiation.
+     */
+    template<
+        typename operation>
+    double measure(
+        double seconds,
+        operation const &power)
+    {
+        size_t powers_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            auto const result = power();
+            ++powers_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(powers_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_bits_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 8192;
+    double const seconds = argc > 2
+        ? std::strtod(argv[2], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(10) << "bits"
+        << std::right << std::setw(16) << "multiply+mod, s"
+        << std::setw(16) << "Montgomery, s"
+        << std::setw(14) << "Barrett, s"
+        << std::setw(16) << "even Barrett, s"
+        << std::setw(10) << "speedup" << std::endl;
+
+    for (size_t bits_count: { 256, 512, 1024, 2048, 4096, 8192 })
+    {
+        if (bits_count > max_bits_count)
+        {
+            break;
+        }
+
+        auto const odd_modulus = random_value(engine, bits_count) | big_integer("1");
+        auto const even_modulus = odd_modulus + big_integer("1");
+        auto const base = big_integer::modulo(random_value(engine, bits_count), odd_modulus);
+        auto const exponent = random_value(engine, bits_count);
+
+        big_integer::Barrett_context const Barrett(odd_modulus);
+
+        auto const trivial = measure(seconds, [&]()
+        {
+            return power_by_squaring(base, exponent, odd_modulus);
+        });
+        auto const Montgomery = measure(seconds, [&]()
+        {
+            return big_integer::pow_mod(base, exponent, odd_modulus);
+        });
+        auto const odd_Barrett = measure(seconds, [&]()
+        {
+            return Barrett.pow(base, exponent);
+        });
+        auto const even_Barrett = measure(seconds, [&]()
+        {
+            return big_integer::pow_mod(base, exponent, even_modulus);
+        });
+
+        std::cout << std::left << std::setw(10) << bits_count
+            << std::right << std::scientific << std::setprecision(3)
+            << std::setw(16) << trivial
+            << std::setw(16) << Montgomery
+            << std::setw(14) << odd_Barrett
+            << std::setw(16) << even_Barrett
+            << std::fixed << std::setprecision(2)
+            << std::setw(10) << trivial / Montgomery << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <big_integer.h>
+#include <work_stealing_pool.h>
+
+/*
+ * Strong scaling of the parallel multiplication rule: the same product of two operands of the given length, and
+ * of two of 20000 limbs, which the Karatsuba split spreads instead of the transform, on 1 to max threads of
+ * the pool against the automatic rule in the calling thread:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_prlll_mltplctn [limbs = 1000000] [max threads = hardware concurrency] [seconds per case = 1]
+ *
+ * Speedup is the automatic rule's time over the parallel one's, efficiency is the speedup per thread.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Multiplies at least once and for about the given time; returns the best seconds per product, as the
+     * threads of the other processes on the machine slow some products down.
+     */
+    double measure(
+        double seconds,
+        big_integer const &first,
+        big_integer const &second,
+        big_integer::multiplication_rule rule)
+    {
+        auto best = 0.0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            auto const product_started = std::chrono::steady_clock::now();
+            auto const product = big_integer::multiply(first, second, nullptr, rule);
+            auto const product_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - product_started).count();
+
+            best = best == 0
+                ? product_seconds
+                : std::min(best, product_seconds);
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return best;
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 1000000;
+    size_t const max_threads_count = argc > 2
+        ? std::strtoul(argv[2], nullptr, 10)
+        : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    double const seconds = argc > 3
+        ? std::strtod(argv[3], nullptr)
+        : 1;
+
+    std::mt19937_64 engine(42);
+    auto &pool = work_stealing_pool::instance();
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+
+    for (size_t operands_count: { size_t(20000), limbs_count })
+    {
+        auto const first = random_value(engine, operands_count);
+        auto const second = random_value(engine, operands_count);
+
+        auto const automatic = measure(seconds, first, second, big_integer::multiplication_rule::automatic);
+
+        std::cout << std::endl << "limbs: " << operands_count << ", automatic: "
+            << std::scientific << std::setprecision(3) << automatic << " s" << std::endl;
+        std::cout << std::left << std::setw(10) << "threads"
+            << std::right << std::setw(14) << "parallel, s"
+            << std::setw(10) << "speedup"
+            << std::setw(12) << "efficiency" << std::endl;
+
+        for (size_t threads_count = 1; threads_count <= max_threads_count; ++threads_count)
+        {
+            pool.set_threads_count(threads_count);
+            auto const parallel = measure(seconds, first, second, big_integer::multiplication_rule::parallel);
+            auto const speedup = automatic / parallel;
+
+            std::cout << std::left << std::setw(10) << threads_count
+                << std::right << std::scientific << std::setprecision(3)
+                << std::setw(14) << parallel
+                << std::fixed << std::setprecision(2)
+                << std::setw(10) << speedup
+                << std::setw(12) << speedup / static_cast<double>(threads_count) << std::endl;
+        }
+    }
+
+    return 0;
+}
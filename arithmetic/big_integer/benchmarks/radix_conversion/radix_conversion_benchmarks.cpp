@@ -0,0 +1,130 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Decimal and hexadecimal printing and parsing of values from 1000 to 1000000 decimal digits, next to a product
+ * of two such values with automatic multiplication, which conversion should not take much longer than:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_rdx_cnvrsn [max decimal digits = 1000000] [seconds per case = 0.2]
+ *
+ * Times are seconds per conversion.
+ */
+namespace
+{
+
+    std::string random_decimal(
+        std::mt19937_64 &engine,
+        size_t symbols_count)
+    {
+        std::string decimal(symbols_count, '0');
+        for (auto &symbol: decimal)
+        {
+            symbol = static_cast<char>('0' + engine() % 10);
+        }
+        decimal[0] = '7';
+
+        return decimal;
+    }
+
+    /*
+     * Runs the operation at least once and for about the given time; returns seconds per run.
+     */
+    template<
+        typename operation>
+    double measure(
+        double seconds,
+        operation const &run)
+    {
+        size_t runs_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            run();
+            ++runs_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(runs_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_symbols_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 1000000;
+    double const seconds = argc > 2
+        ? std::strtod(argv[2], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(10) << "digits"
+        << std::right << std::setw(14) << "print 10, s"
+        << std::setw(14) << "parse 10, s"
+        << std::setw(14) << "print 16, s"
+        << std::setw(14) << "parse 16, s"
+        << std::setw(14) << "product, s" << std::endl;
+
+    for (size_t symbols_count: { 1000, 3000, 10000, 30000, 100000, 300000, 1000000 })
+    {
+        if (symbols_count > max_symbols_count)
+        {
+            break;
+        }
+
+        auto const decimal = random_decimal(engine, symbols_count);
+        big_integer const value(decimal);
+        big_integer const other(random_decimal(engine, symbols_count));
+        std::ostringstream hexadecimal_stream;
+        hexadecimal_stream << std::hex << value;
+        auto const hexadecimal = hexadecimal_stream.str();
+
+        auto const print_decimal = measure(seconds, [&value]()
+        {
+            std::ostringstream stream;
+            stream << value;
+        });
+        auto const parse_decimal = measure(seconds, [&decimal]()
+        {
+            big_integer const parsed(decimal);
+        });
+        auto const print_hexadecimal = measure(seconds, [&value]()
+        {
+            std::ostringstream stream;
+            stream << std::hex << value;
+        });
+        auto const parse_hexadecimal = measure(seconds, [&hexadecimal]()
+        {
+            big_integer const parsed(hexadecimal, 16);
+        });
+        auto const product = measure(seconds, [&value, &other]()
+        {
+            auto const result = big_integer::multiply(value, other, nullptr, big_integer::multiplication_rule::automatic);
+        });
+
+        std::cout << std::left << std::setw(10) << symbols_count
+            << std::right << std::scientific << std::setprecision(3)
+            << std::setw(14) << print_decimal
+            << std::setw(14) << parse_decimal
+            << std::setw(14) << print_hexadecimal
+            << std::setw(14) << parse_hexadecimal
+            << std::setw(14) << product << std::endl;
+    }
+
+    return 0;
+}
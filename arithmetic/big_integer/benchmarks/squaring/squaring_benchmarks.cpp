@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <big_integer.h>
+
+/*
+ * Products of distinct operands against squares of one of them, from 16 to 100000 limbs, with trivial,
+ * Karatsuba and number theoretic transform (Schonhage_Strassen rule) multiplication:
+ *
+ *     mp_os_arthmtc_bg_intgr_bnchmrks_sqrng [max limbs = 100000] [max trivial limbs = 4000] [seconds per case = 0.2]
+ *
+ * Each rule's ratio is the product's time over the square's; schoolbook squaring computes about half of the
+ * partial products, and the transform of a square transforms one operand instead of two.
+ */
+namespace
+{
+
+    big_integer random_value(
+        std::mt19937_64 &engine,
+        size_t limbs_count)
+    {
+        static char const symbols[] = "0123456789abcdef";
+
+        std::string hexadecimal(limbs_count * sizeof(big_integer::limb) * 2, '0');
+        for (auto &symbol: hexadecimal)
+        {
+            symbol = symbols[engine() % 16];
+        }
+        hexadecimal[0] = '8';
+
+        return big_integer(hexadecimal, 16);
+    }
+
+    /*
+     * Runs the multiplication at least once and for about the given time; returns seconds per product.
+     */
+    double measure(
+        double seconds,
+        big_integer const &first,
+        big_integer const &second,
+        big_integer::multiplication_rule rule)
+    {
+        size_t products_count = 0;
+        double elapsed = 0;
+
+        auto const started = std::chrono::steady_clock::now();
+        do
+        {
+            auto const product = big_integer::multiply(first, second, nullptr, rule);
+            ++products_count;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        }
+        while (elapsed < seconds);
+
+        return elapsed / static_cast<double>(products_count);
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_limbs_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 100000;
+    size_t const max_trivial_limbs_count = argc > 2
+        ? std::strtoul(argv[2], nullptr, 10)
+        : 4000;
+    double const seconds = argc > 3
+        ? std::strtod(argv[3], nullptr)
+        : 0.2;
+
+    std::mt19937_64 engine(42);
+
+    std::cout << "limb bits: " << sizeof(big_integer::limb) * 8 << std::endl;
+    std::cout << std::left << std::setw(10) << "limbs"
+        << std::right << std::setw(14) << "trivial, s"
+        << std::setw(14) << "square, s"
+        << std::setw(8) << "ratio"
+        << std::setw(14) << "Karatsuba, s"
+        << std::setw(14) << "square, s"
+        << std::setw(8) << "ratio"
+        << std::setw(14) << "NTT, s"
+        << std::setw(14) << "square, s"
+        << std::setw(8) << "ratio" << std::endl;
+
+    for (size_t limbs_count: { 16, 24, 32, 48, 64, 96, 128, 300, 1000, 4000, 10000, 30000, 100000 })
+    {
+        if (limbs_count > max_limbs_count)
+        {
+            break;
+        }
+
+        auto const first = random_value(engine, limbs_count);
+        auto const second = random_value(engine, limbs_count);
+
+        std::cout << std::left << std::setw(10) << limbs_count << std::right;
+        for (auto rule: {
+            big_integer::multiplication_rule::trivial,
+            big_integer::multiplication_rule::Karatsuba,
+            big_integer::multiplication_rule::SchonhageStrassen })
+        {
+            if (rule == big_integer::multiplication_rule::trivial && limbs_count > max_trivial_limbs_count)
+            {
+                std::cout << std::setw(14) << "-" << std::setw(14) << "-" << std::setw(8) << "-";
+                continue;
+            }
+
+            auto const product = measure(seconds, first, second, rule);
+            auto const square = measure(seconds, first, first, rule);
+            std::cout << std::scientific << std::setprecision(3)
+                << std::setw(14) << product
+                << std::setw(14) << square
+                << std::fixed << std::setprecision(2)
+                << std::setw(8) << product / square;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
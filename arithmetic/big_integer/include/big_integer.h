@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <map>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <allocator.h>
@@ -13,13 +15,34 @@ class big_integer final:
     allocator_guardant
 {
 
+public:
+
+    /*
+     * The unit values are stored in. 64-bit limbs halve the iterations of every digit loop
+     * and need unsigned __int128 for their carries, so they are only used when it exists.
+     */
+#if defined(BIG_INTEGER_64_BIT_LIMBS) && defined(__SIZEOF_INT128__)
+    using limb = unsigned long long;
+#else
+    using limb = unsigned int;
+#endif
+
+private:
+
+    using signed_limb = std::make_signed<limb>::type;
+
 public:
     
     enum class multiplication_rule
     {
         trivial,
         Karatsuba,
-        SchonhageStrassen
+        Toom3,
+        Toom4,
+        SchonhageStrassen,
+        automatic,
+        // the automatic choice with long products spread over the threads of work_stealing_pool
+        parallel
     };
 
 private:
@@ -63,6 +86,30 @@ private:
         
     };
     
+    class Toom3_multiplication final:
+        public multiplication
+    {
+
+    public:
+
+        big_integer &multiply(
+            big_integer &first_multiplier,
+            big_integer const &second_multiplier) const override;
+
+    };
+
+    class Toom4_multiplication final:
+        public multiplication
+    {
+
+    public:
+
+        big_integer &multiply(
+            big_integer &first_multiplier,
+            big_integer const &second_multiplier) const override;
+
+    };
+
     class Schonhage_Strassen_multiplication final:
         public multiplication
     {
@@ -75,6 +122,30 @@ private:
         
     };
 
+    class automatic_multiplication final:
+        public multiplication
+    {
+
+    public:
+
+        big_integer &multiply(
+            big_integer &first_multiplier,
+            big_integer const &second_multiplier) const override;
+
+    };
+
+    class parallel_multiplication final:
+        public multiplication
+    {
+
+    public:
+
+        big_integer &multiply(
+            big_integer &first_multiplier,
+            big_integer const &second_multiplier) const override;
+
+    };
+
 public:
     
     enum class division_rule
@@ -104,6 +175,15 @@ private:
             big_integer &dividend,
             big_integer const &divisor,
             big_integer::multiplication_rule multiplication_rule) const = 0;
+
+        /*
+         * The quotient replaces the dividend and the remainder is assigned to remainder, another object than the dividend.
+         */
+        virtual big_integer &divmod(
+            big_integer &dividend,
+            big_integer const &divisor,
+            big_integer &remainder,
+            big_integer::multiplication_rule multiplication_rule) const = 0;
         
     };
     
@@ -122,6 +202,12 @@ private:
             big_integer &dividend,
             big_integer const &divisor,
             big_integer::multiplication_rule multiplication_rule) const override;
+
+        big_integer &divmod(
+            big_integer &dividend,
+            big_integer const &divisor,
+            big_integer &remainder,
+            big_integer::multiplication_rule multiplication_rule) const override;
         
     };
     
@@ -140,6 +226,12 @@ private:
             big_integer &dividend,
             big_integer const &divisor,
             big_integer::multiplication_rule multiplication_rule) const override;
+
+        big_integer &divmod(
+            big_integer &dividend,
+            big_integer const &divisor,
+            big_integer &remainder,
+            big_integer::multiplication_rule multiplication_rule) const override;
         
     };
     
@@ -158,17 +250,63 @@ private:
             big_integer &dividend,
             big_integer const &divisor,
             big_integer::multiplication_rule multiplication_rule) const override;
+
+        big_integer &divmod(
+            big_integer &dividend,
+            big_integer const &divisor,
+            big_integer &remainder,
+            big_integer::multiplication_rule multiplication_rule) const override;
         
     };
 
+public:
+
+    /*
+     * A divisor prepared once for many divisions by it: its normalized magnitude and the reciprocal of its top digit,
+     * which replaces hardware division in algorithm D, and for long divisors with a multiplication rule other than
+     * trivial, its Newton reciprocal, which turns each division into a few multiplications by that rule.
+     */
+    class precomputed_divisor;
+
+    /*
+     * Multiplication modulo an odd modulus in Montgomery form, x * R mod modulus for R = B^n, B = 2^limb bits and
+     * a modulus of n limbs, where reduction takes multiplications by the limbs of the modulus instead of a division.
+     */
+    class Montgomery_context;
+
+    /*
+     * Multiplication modulo any positive modulus with Barrett reduction, which replaces the division by the modulus
+     * with multiplications by its precomputed reciprocal.
+     */
+    class Barrett_context;
+
 private:
 
-    int _oldest_digit;
-    unsigned int *_other_digits;
+    // values of up to this many digits, 128 bits, are kept in the object itself
+    static constexpr size_t inline_digits_count = 128 / (sizeof(limb) * 8);
+
+    /*
+     * Two's complement digits, the least significant first. _oldest_digit is the most significant one
+     * and carries the sign; the other _digits_count - 1 ones are kept inline for small values and
+     * in _other_digits otherwise. Values never keep redundant sign digits, so equal values have
+     * equal representations.
+     *
+     * Without an explicit allocator, _other_digits come from digit_buffer_pool.
+     */
+    signed_limb _oldest_digit;
+    unsigned int _digits_count;
+    union
+    {
+        limb *_other_digits;
+        limb _inline_digits[inline_digits_count - 1];
+    };
     allocator *_allocator;
 
 public:
 
+    /*
+     * 32-bit two's complement digits, the least significant first, whatever the limb size is.
+     */
     big_integer(
         int const *digits,
         size_t digits_count,
@@ -333,6 +471,32 @@ public:
         allocator *allocator = nullptr,
         big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
 
+    /*
+     * Fused multiply and add into one destination, which any operand may be: destination += first * second,
+     * destination -= first * second and destination = first * second + addend, without a temporary for the product.
+     */
+    static big_integer &addmul(
+        big_integer &destination,
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+
+    static big_integer &submul(
+        big_integer &destination,
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+
+    static big_integer &mul_add(
+        big_integer &destination,
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier,
+        big_integer const &addend,
+        allocator *allocator = nullptr,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+
     static big_integer &divide(
         big_integer &dividend,
         big_integer const &divisor,
@@ -361,6 +525,69 @@ public:
         big_integer::division_rule division_rule = big_integer::division_rule::trivial,
         big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
 
+    /*
+     * The truncated quotient and the remainder, which takes the dividend's sign, of a single division: the quotient
+     * replaces the dividend and the remainder is assigned to remainder, another object than the dividend.
+     */
+    static big_integer &divmod(
+        big_integer &dividend,
+        big_integer const &divisor,
+        big_integer &remainder,
+        allocator *allocator = nullptr,
+        big_integer::division_rule division_rule = big_integer::division_rule::trivial,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+
+    /*
+     * The quotient and the remainder, in this order.
+     */
+    static std::pair<big_integer, big_integer> divmod(
+        big_integer const &dividend,
+        big_integer const &divisor,
+        allocator *allocator = nullptr,
+        big_integer::division_rule division_rule = big_integer::division_rule::trivial,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+
+    static big_integer &divide(
+        big_integer &dividend,
+        precomputed_divisor const &divisor,
+        allocator *allocator = nullptr);
+
+    static big_integer divide(
+        big_integer const &dividend,
+        precomputed_divisor const &divisor,
+        allocator *allocator = nullptr);
+
+    static big_integer &modulo(
+        big_integer &dividend,
+        precomputed_divisor const &divisor,
+        allocator *allocator = nullptr);
+
+    static big_integer modulo(
+        big_integer const &dividend,
+        precomputed_divisor const &divisor,
+        allocator *allocator = nullptr);
+
+    static big_integer &divmod(
+        big_integer &dividend,
+        precomputed_divisor const &divisor,
+        big_integer &remainder,
+        allocator *allocator = nullptr);
+
+    static std::pair<big_integer, big_integer> divmod(
+        big_integer const &dividend,
+        precomputed_divisor const &divisor,
+        allocator *allocator = nullptr);
+
+    /*
+     * base^exponent mod modulus, in [0, modulus), for a positive modulus and a non-negative exponent: with Montgomery
+     * multiplication for an odd modulus and Barrett reduction for an even one.
+     */
+    static big_integer pow_mod(
+        big_integer const &base,
+        big_integer const &exponent,
+        big_integer const &modulus,
+        allocator *allocator = nullptr);
+
 public:
     
     friend std::ostream &operator<<(
@@ -371,10 +598,249 @@ public:
         std::istream &stream,
         big_integer &value);
 
+private:
+
+    big_integer(
+        big_integer const &other,
+        allocator *allocator);
+
+private:
+
+    /*
+     * result = first * second for magnitudes without leading zeros; result holds first_count + second_count
+     * digits and aliases neither operand.
+     */
+    using magnitudes_multiplier = void (*)(
+        limb *result,
+        limb const *first,
+        size_t first_count,
+        limb const *second,
+        size_t second_count);
+
+    /*
+     * The sign and storage handling shared by multiplication rules. Equal magnitudes, including
+     * a value multiplied by itself, reach the multiplier as one operand, which it squares.
+     */
+    static big_integer &multiply_magnitudes(
+        big_integer &first_multiplier,
+        big_integer const &second_multiplier,
+        magnitudes_multiplier multiplier);
+
+    static division const &choose_division(
+        big_integer::division_rule division_rule) noexcept;
+
+    /*
+     * destination = addend + first * second, or addend - first * second; any operand may be the destination.
+     */
+    static big_integer &multiply_accumulate(
+        big_integer &destination,
+        big_integer const &addend,
+        big_integer const &first_multiplier,
+        big_integer const &second_multiplier,
+        bool is_subtracted,
+        big_integer::multiplication_rule multiplication_rule);
+
 private:
 
     [[nodiscard]] allocator *get_allocator() const noexcept override;
-    
+
+private:
+
+    [[nodiscard]] size_t get_digits_count() const noexcept;
+
+    [[nodiscard]] bool is_inline() const noexcept;
+
+    /*
+     * All digits but the oldest one.
+     */
+    [[nodiscard]] limb const *get_other_digits() const noexcept;
+
+#if defined(__SIZEOF_INT128__)
+
+    /*
+     * Fast paths for values that are kept inline: they are computed in native 128-bit arithmetic.
+     */
+    [[nodiscard]] __int128 get_inline_value() const noexcept;
+
+    big_integer &assign_inline_value(
+        __int128 value) noexcept;
+
+#endif
+
+    [[nodiscard]] bool is_negative() const noexcept;
+
+    [[nodiscard]] bool is_zero() const noexcept;
+
+    /*
+     * Writes the digits sign-extended to digits_count, which is not less than get_digits_count().
+     */
+    void load_digits(
+        limb *destination,
+        size_t digits_count) const noexcept;
+
+    /*
+     * Writes the absolute value, which takes at most get_digits_count() digits,
+     * and returns its digits count without leading zeros.
+     */
+    size_t load_magnitude(
+        limb *destination) const noexcept;
+
+    /*
+     * result[i] = result[i] op operand[i] for i < count.
+     */
+    using limbs_combiner = void (*)(
+        limb *result,
+        limb const *operand,
+        size_t count);
+
+    /*
+     * Combines destination with the digits sign-extended to digits_count, which is not less than get_digits_count(),
+     * straight from the storage: the combiner sees the sign digits in blocks.
+     */
+    void combine_digits(
+        limb *destination,
+        size_t digits_count,
+        limbs_combiner combiner) const noexcept;
+
+    /*
+     * Writes value mod modulus, in [0, modulus), to as many digits as the modulus has; the modulus has no leading zeros.
+     */
+    static void load_residue(
+        big_integer const &value,
+        std::vector<limb> const &modulus,
+        limb *residue);
+
+    big_integer &assign_digits(
+        limb const *digits,
+        size_t digits_count);
+
+    big_integer &assign_magnitude(
+        limb const *magnitude,
+        size_t digits_count,
+        bool is_negative);
+
+    void release_digits() noexcept;
+
+};
+
+class big_integer::precomputed_divisor final
+{
+
+    friend class big_integer;
+
+private:
+
+    big_integer _divisor;
+
+    size_t _shift;
+
+    // the magnitude shifted left by _shift bits, so that its top bit is set
+    std::vector<big_integer::limb> _normalized_digits;
+
+    big_integer::limb _top_reciprocal;
+
+    // floor((B^(2n) - 1) / normalized divisor) for B = 2^limb bits and n normalized digits; empty when not used
+    std::vector<big_integer::limb> _reciprocal;
+
+    big_integer::multiplication_rule _multiplication_rule;
+
+public:
+
+    explicit precomputed_divisor(
+        big_integer const &divisor,
+        big_integer::multiplication_rule multiplication_rule = big_integer::multiplication_rule::trivial);
+
+private:
+
+    /*
+     * Truncated quotient and remainder; either destination may be nullptr or the dividend itself.
+     */
+    void divide(
+        big_integer const &dividend,
+        big_integer *quotient,
+        big_integer *remainder) const;
+
+};
+
+class big_integer::Montgomery_context final
+{
+
+    friend class big_integer;
+
+private:
+
+    big_integer _modulus;
+
+    std::vector<big_integer::limb> _modulus_digits;
+
+    // -1 / modulus mod B
+    big_integer::limb _inverse;
+
+    // R mod modulus and R^2 mod modulus
+    std::vector<big_integer::limb> _one;
+    std::vector<big_integer::limb> _square;
+
+public:
+
+    explicit Montgomery_context(
+        big_integer const &modulus);
+
+public:
+
+    [[nodiscard]] big_integer to_form(
+        big_integer const &value) const;
+
+    [[nodiscard]] big_integer from_form(
+        big_integer const &value) const;
+
+    /*
+     * The Montgomery form of the product of two values in Montgomery form.
+     */
+    [[nodiscard]] big_integer multiply(
+        big_integer const &first,
+        big_integer const &second) const;
+
+    /*
+     * base^exponent mod modulus by sliding windows; base is an ordinary value, not in Montgomery form.
+     */
+    [[nodiscard]] big_integer pow(
+        big_integer const &base,
+        big_integer const &exponent) const;
+
+};
+
+class big_integer::Barrett_context final
+{
+
+    friend class big_integer;
+
+private:
+
+    big_integer _modulus;
+
+    std::vector<big_integer::limb> _modulus_digits;
+
+    // floor(B^(2n) / modulus) for a modulus of n limbs, in n + 2 limbs
+    std::vector<big_integer::limb> _reciprocal;
+
+public:
+
+    explicit Barrett_context(
+        big_integer const &modulus);
+
+public:
+
+    [[nodiscard]] big_integer multiply(
+        big_integer const &first,
+        big_integer const &second) const;
+
+    /*
+     * base^exponent mod modulus by sliding windows.
+     */
+    [[nodiscard]] big_integer pow(
+        big_integer const &base,
+        big_integer const &exponent) const;
+
 };
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BIGINT_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_DIGIT_BUFFER_POOL_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_DIGIT_BUFFER_POOL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/*
+ * Recycles big_integer digit buffers that are not bound to an explicit allocator.
+ *
+ * Buffers are grouped into size classes of 2^k words. A released buffer goes to the calling thread's
+ * free list of its class; a list that grows past its limit hands half of its buffers to one of the
+ * shared shards, where threads that run out pick them up. Shards are lock-free stacks: a batch is
+ * pushed with a compare-and-swap and taken whole with an exchange, so no pop ever reads a node
+ * another thread may be reusing.
+ *
+ * Buffers larger than the biggest class bypass the pool.
+ */
+class digit_buffer_pool final
+{
+
+private:
+
+    struct free_buffer final
+    {
+
+        free_buffer *next;
+
+    };
+
+    // the smallest class holds a free_buffer link
+    static constexpr size_t min_size_class = 1;
+
+    static constexpr size_t max_size_class = 16;
+
+    static constexpr size_t size_classes_count = max_size_class + 1;
+
+    static constexpr size_t shards_count = 8;
+
+    // a thread keeps at most this many bytes of free buffers in each class
+    static constexpr size_t max_cached_bytes = 64 * 1024;
+
+    class thread_cache final
+    {
+
+    public:
+
+        std::array<free_buffer *, size_classes_count> heads;
+
+        std::array<size_t, size_classes_count> counts;
+
+        size_t shard_index;
+
+    public:
+
+        thread_cache() noexcept;
+
+        ~thread_cache() noexcept;
+
+    };
+
+    struct shard final
+    {
+
+        std::array<std::atomic<free_buffer *>, size_classes_count> heads;
+
+    };
+
+private:
+
+    std::array<shard, shards_count> _shards;
+
+    std::atomic<size_t> _next_shard_index;
+
+private:
+
+    digit_buffer_pool() noexcept;
+
+public:
+
+    digit_buffer_pool(
+        digit_buffer_pool const &other) = delete;
+
+    digit_buffer_pool &operator=(
+        digit_buffer_pool const &other) = delete;
+
+public:
+
+    [[nodiscard]] unsigned int *allocate(
+        size_t words_count);
+
+    /*
+     * words_count must be the one the buffer was allocated with.
+     */
+    void deallocate(
+        unsigned int *buffer,
+        size_t words_count) noexcept;
+
+public:
+
+    static digit_buffer_pool &instance();
+
+private:
+
+    static size_t size_class_of(
+        size_t words_count) noexcept;
+
+    static size_t max_cached_count(
+        size_t size_class) noexcept;
+
+    thread_cache *get_thread_cache() noexcept;
+
+    /*
+     * Moves all buffers but the first kept_count ones of the class list to the thread's shard.
+     */
+    void spill(
+        thread_cache &cache,
+        size_t size_class,
+        size_t kept_count) noexcept;
+
+    /*
+     * Takes every buffer of the class from the thread's own shard, or from the other ones if it is empty.
+     */
+    bool refill(
+        thread_cache &cache,
+        size_t size_class) noexcept;
+
+    void push(
+        size_t shard_index,
+        size_t size_class,
+        free_buffer *first,
+        free_buffer *last) noexcept;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_DIGIT_BUFFER_POOL_H
@@ -0,0 +1,166 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_WORK_STEALING_POOL_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Runs the independent parts of big_integer's parallel multiplication.
+ *
+ * Every worker thread owns a deque of tasks. It runs its own newest task first, whose data is still in its caches;
+ * a worker left without tasks steals the oldest task of another deque, the biggest part of a recursive split.
+ * A thread that waits for a group of tasks runs queued tasks meanwhile instead of blocking, so groups nest
+ * without running out of threads. Threads outside the pool queue their tasks in one shared deque.
+ */
+class work_stealing_pool final
+{
+
+public:
+
+    /*
+     * Tasks run by the pool's threads or by the one waiting for them. wait() returns once every task has finished
+     * and rethrows the first exception a task has thrown; a group is also waited for on destruction.
+     */
+    class task_group final
+    {
+
+        friend class work_stealing_pool;
+
+    private:
+
+        work_stealing_pool &_pool;
+
+        std::atomic<size_t> _pending_count;
+
+        std::mutex _exception_mutex;
+
+        std::exception_ptr _exception;
+
+    public:
+
+        explicit task_group(
+            work_stealing_pool &pool) noexcept;
+
+        task_group(
+            task_group const &other) = delete;
+
+        task_group &operator=(
+            task_group const &other) = delete;
+
+        ~task_group() noexcept;
+
+    public:
+
+        void run(
+            std::function<void()> function);
+
+        void wait();
+
+    private:
+
+        void wait_for_tasks() noexcept;
+
+    };
+
+private:
+
+    struct task final
+    {
+
+        std::function<void()> function;
+
+        task_group *group;
+
+    };
+
+    struct task_deque final
+    {
+
+        std::mutex mutex;
+
+        std::deque<task> tasks;
+
+    };
+
+private:
+
+    // one deque per worker, and the last one for threads outside the pool
+    std::vector<std::unique_ptr<task_deque>> _deques;
+
+    std::vector<std::thread> _workers;
+
+    // tasks in the deques; it is raised before a task is queued, so it never falls below the real count
+    std::atomic<size_t> _queued_count;
+
+    std::mutex _sleep_mutex;
+
+    std::condition_variable _wakeup;
+
+    bool _is_stopping;
+
+private:
+
+    work_stealing_pool();
+
+public:
+
+    work_stealing_pool(
+        work_stealing_pool const &other) = delete;
+
+    work_stealing_pool &operator=(
+        work_stealing_pool const &other) = delete;
+
+public:
+
+    /*
+     * The threads that run tasks, the waiting one included: a pool of one thread runs every task in the caller.
+     */
+    [[nodiscard]] size_t get_threads_count() const noexcept;
+
+    /*
+     * Replaces the workers with threads_count - 1 new ones, or as many as the hardware runs at once for zero.
+     * No group may be running meanwhile.
+     */
+    void set_threads_count(
+        size_t threads_count);
+
+public:
+
+    static work_stealing_pool &instance();
+
+private:
+
+    void start(
+        size_t threads_count);
+
+    void stop() noexcept;
+
+    /*
+     * The deque of the calling thread: its own for a worker, the shared one for any other thread.
+     */
+    size_t get_deque_index() const noexcept;
+
+    void push(
+        task queued);
+
+    /*
+     * Runs the newest task of the deque or, if it is empty, the oldest one of another deque; returns whether
+     * there was a task.
+     */
+    bool run_one(
+        size_t deque_index) noexcept;
+
+    void work(
+        size_t worker_index) noexcept;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_WORK_STEALING_POOL_H
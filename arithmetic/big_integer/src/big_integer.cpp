@@ -1,425 +1,5280 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "../include/big_integer.h"
+#include "../include/digit_buffer_pool.h"
+#include "../include/work_stealing_pool.h"
+
+// limb-wise kernels in AVX2 and AVX-512 vectors besides the scalar ones, chosen by the processor at run time
+#if defined(BIG_INTEGER_VECTOR_KERNELS) && defined(__x86_64__) && defined(__GNUC__)
+#define BIG_INTEGER_X86_VECTOR_KERNELS
+#endif
+
+namespace
+{
+
+    using digit = big_integer::limb;
+
+#if defined(BIG_INTEGER_64_BIT_LIMBS) && defined(__SIZEOF_INT128__)
+    using double_digit = unsigned __int128;
+#else
+    using double_digit = unsigned long long;
+#endif
+
+    static_assert(sizeof(double_digit) == 2 * sizeof(digit), "a double digit must hold the product of two digits");
+
+    constexpr size_t digit_bits = sizeof(digit) * 8;
+
+    constexpr digit max_digit = std::numeric_limits<digit>::max();
+
+    // digit_buffer_pool counts in 32-bit words
+    constexpr size_t words_per_digit = sizeof(digit) / sizeof(unsigned int);
+
+#if defined(__SIZEOF_INT128__)
+
+    constexpr __int128 min_inline_value = -(static_cast<__int128>(1) << 126) - (static_cast<__int128>(1) << 126);
+
+#endif
+
+    digit *allocate_digits(
+        size_t count)
+    {
+        return reinterpret_cast<digit *>(digit_buffer_pool::instance().allocate(count * words_per_digit));
+    }
+
+    void deallocate_digits(
+        digit *digits,
+        size_t count) noexcept
+    {
+        digit_buffer_pool::instance().deallocate(reinterpret_cast<unsigned int *>(digits), count * words_per_digit);
+    }
+
+    /*
+     * Scratch digits for the duration of one operation, taken from the pool.
+     */
+    class digits_buffer final
+    {
+
+    private:
+
+        size_t _count;
+
+        digit *_digits;
+
+    public:
+
+        explicit digits_buffer(
+            size_t count):
+                _count(std::max<size_t>(count, 1)),
+                _digits(allocate_digits(_count))
+        {
+
+        }
+
+        ~digits_buffer() noexcept
+        {
+            deallocate_digits(_digits, _count);
+        }
+
+        digits_buffer(
+            digits_buffer const &other) = delete;
+
+        digits_buffer &operator=(
+            digits_buffer const &other) = delete;
+
+    public:
+
+        [[nodiscard]] digit *get() const noexcept
+        {
+            return _digits;
+        }
+
+    };
+
+    size_t significant_count(
+        digit const *digits,
+        size_t count) noexcept
+    {
+        while (count != 0 && digits[count - 1] == 0)
+        {
+            --count;
+        }
+
+        return count;
+    }
+
+    size_t leading_zeros(
+        digit value) noexcept
+    {
+        if (value == 0)
+        {
+            return digit_bits;
+        }
+
+        return sizeof(digit) == sizeof(unsigned int)
+            ? static_cast<size_t>(__builtin_clz(static_cast<unsigned int>(value)))
+            : static_cast<size_t>(__builtin_clzll(static_cast<unsigned long long>(value)));
+    }
+
+    /*
+     * Two's complement negation in place.
+     */
+    void negate_digits(
+        digit *digits,
+        size_t count) noexcept
+    {
+        double_digit carry = 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            carry += static_cast<digit>(~digits[i]);
+            digits[i] = static_cast<digit>(carry);
+            carry >>= digit_bits;
+        }
+    }
+
+    /*
+     * result = first + second, first_count >= second_count; result may alias either operand.
+     * Returns the carry out of the first_count digits.
+     */
+    digit add_digits(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count) noexcept
+    {
+        double_digit carry = 0;
+        size_t i = 0;
+
+        for (; i < second_count; ++i)
+        {
+            carry += static_cast<double_digit>(first[i]) + second[i];
+            result[i] = static_cast<digit>(carry);
+            carry >>= digit_bits;
+        }
+        for (; i < first_count; ++i)
+        {
+            carry += first[i];
+            result[i] = static_cast<digit>(carry);
+            carry >>= digit_bits;
+        }
+
+        return static_cast<digit>(carry);
+    }
+
+    /*
+     * result = first - second, first_count >= second_count; result may alias either operand.
+     * Returns the borrow out of the first_count digits.
+     */
+    digit subtract_digits(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count) noexcept
+    {
+        double_digit borrow = 0;
+        size_t i = 0;
+
+        for (; i < second_count; ++i)
+        {
+            auto const difference = static_cast<double_digit>(first[i]) - second[i] - borrow;
+            result[i] = static_cast<digit>(difference);
+            borrow = (difference >> digit_bits) & 1;
+        }
+        for (; i < first_count; ++i)
+        {
+            auto const difference = static_cast<double_digit>(first[i]) - borrow;
+            result[i] = static_cast<digit>(difference);
+            borrow = (difference >> digit_bits) & 1;
+        }
+
+        return static_cast<digit>(borrow);
+    }
+
+    /*
+     * result[0..count) += digits * multiplier; returns the carry out.
+     */
+    digit add_multiplied(
+        digit *result,
+        digit const *digits,
+        size_t count,
+        digit multiplier) noexcept
+    {
+        double_digit carry = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            carry += static_cast<double_digit>(digits[i]) * multiplier + result[i];
+            result[i] = static_cast<digit>(carry);
+            carry >>= digit_bits;
+        }
+
+        return static_cast<digit>(carry);
+    }
+
+    /*
+     * result[0..count) -= digits * multiplier; returns the borrow out.
+     */
+    digit subtract_multiplied(
+        digit *result,
+        digit const *digits,
+        size_t count,
+        digit multiplier) noexcept
+    {
+        double_digit carry = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto const product = static_cast<double_digit>(digits[i]) * multiplier + carry;
+            auto const low = static_cast<digit>(product);
+            carry = (product >> digit_bits) + (result[i] < low
+                ? 1
+                : 0);
+            result[i] -= low;
+        }
+
+        return static_cast<digit>(carry);
+    }
+
+    /*
+     * result[0..count) += or -= first * second, count > first_count + second_count, by schoolbook rows added
+     * in place: the product never takes a buffer of its own.
+     */
+    void accumulate_schoolbook(
+        digit *result,
+        size_t count,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count,
+        bool is_subtracted) noexcept
+    {
+        // the carry or borrow of the rows so far into digit i + first_count
+        digit pending = 0;
+        for (size_t i = 0; i < second_count; ++i)
+        {
+            auto &top = result[i + first_count];
+            if (is_subtracted)
+            {
+                auto const borrow = static_cast<double_digit>(pending) + subtract_multiplied(result + i, first, first_count, second[i]);
+                pending = top < borrow
+                    ? 1
+                    : 0;
+                top = static_cast<digit>(top - borrow);
+            }
+            else
+            {
+                auto const sum = static_cast<double_digit>(top) + pending + add_multiplied(result + i, first, first_count, second[i]);
+                top = static_cast<digit>(sum);
+                pending = static_cast<digit>(sum >> digit_bits);
+            }
+        }
+
+        auto *rest = result + first_count + second_count;
+        if (is_subtracted)
+        {
+            subtract_digits(rest, rest, count - first_count - second_count, &pending, 1);
+        }
+        else
+        {
+            add_digits(rest, rest, count - first_count - second_count, &pending, 1);
+        }
+    }
+
+    /*
+     * result = digits * digits, result holds 2 * count digits and does not alias digits.
+     *
+     * Each product of two distinct digits is computed once and doubled by adding the sum to itself;
+     * the squares of the digits are added afterwards.
+     */
+    void square_schoolbook(
+        digit *result,
+        digit const *digits,
+        size_t count) noexcept
+    {
+        std::fill(result, result + 2 * count, 0);
+        for (size_t i = 0; i + 1 < count; ++i)
+        {
+            result[count + i] = add_multiplied(result + 2 * i + 1, digits + i + 1, count - i - 1, digits[i]);
+        }
+        add_digits(result, result, 2 * count, result, 2 * count);
+
+        double_digit carry = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto const square = static_cast<double_digit>(digits[i]) * digits[i];
+            carry += static_cast<double_digit>(result[2 * i]) + static_cast<digit>(square);
+            result[2 * i] = static_cast<digit>(carry);
+            carry = (carry >> digit_bits) + result[2 * i + 1] + (square >> digit_bits);
+            result[2 * i + 1] = static_cast<digit>(carry);
+            carry >>= digit_bits;
+        }
+    }
+
+    /*
+     * result = first * second, result holds first_count + second_count digits and aliases neither operand.
+     * The same operand passed twice is squared.
+     */
+    void multiply_schoolbook(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count) noexcept
+    {
+        if (first == second && first_count == second_count)
+        {
+            square_schoolbook(result, first, first_count);
+            return;
+        }
+
+        std::fill(result, result + first_count, 0);
+        for (size_t i = 0; i < second_count; ++i)
+        {
+            result[first_count + i] = add_multiplied(result + i, first, first_count, second[i]);
+        }
+    }
+
+    /*
+     * quotient = dividend / divisor, quotient may alias dividend; returns the remainder.
+     */
+    digit divide_by_digit(
+        digit *quotient,
+        digit const *dividend,
+        size_t count,
+        digit divisor) noexcept
+    {
+        double_digit remainder = 0;
+        for (size_t i = count; i-- > 0;)
+        {
+            auto const current = (remainder << digit_bits) | dividend[i];
+            quotient[i] = static_cast<digit>(current / divisor);
+            remainder = current % divisor;
+        }
+
+        return static_cast<digit>(remainder);
+    }
+
+    /*
+     * Compares magnitudes that may have leading zeros: negative, zero or positive as first is less, equal or greater.
+     */
+    int compare_magnitudes(
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count) noexcept
+    {
+        first_count = significant_count(first, first_count);
+        second_count = significant_count(second, second_count);
+        if (first_count != second_count)
+        {
+            return first_count < second_count
+                ? -1
+                : 1;
+        }
+
+        for (size_t i = first_count; i-- > 0;)
+        {
+            if (first[i] != second[i])
+            {
+                return first[i] < second[i]
+                    ? -1
+                    : 1;
+            }
+        }
+
+        return 0;
+    }
+
+    /*
+     * result = |first - second| in count digits, which hold both operands; returns whether first < second.
+     */
+    bool subtract_absolute(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count,
+        size_t count) noexcept
+    {
+        first_count = significant_count(first, first_count);
+        second_count = significant_count(second, second_count);
+
+        auto const is_negative = compare_magnitudes(first, first_count, second, second_count) < 0;
+        if (is_negative)
+        {
+            std::swap(first, second);
+            std::swap(first_count, second_count);
+        }
+
+        subtract_digits(result, first, first_count, second, second_count);
+        std::fill(result + first_count, result + count, 0);
+
+        return is_negative;
+    }
+
+    // below this many digits of the shorter operand, schoolbook multiplication is faster
+    constexpr size_t Karatsuba_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 48
+        : 32;
+
+    // schoolbook squaring computes half of the products, so it stays faster up to longer operands,
+    // about as long for both digit widths
+    constexpr size_t Karatsuba_square_threshold = 64;
+
+    static_assert(Karatsuba_square_threshold >= Karatsuba_threshold, "squaring uses the scratch of multiplication");
+
+    /*
+     * Scratch digits needed by multiply_Karatsuba for a first operand of count digits.
+     */
+    size_t Karatsuba_scratch_count(
+        size_t count) noexcept
+    {
+        size_t scratch_count = 0;
+        while (count >= Karatsuba_threshold)
+        {
+            count = (count + 1) / 2;
+            scratch_count += 6 * count + 1;
+        }
+
+        return scratch_count;
+    }
+
+    /*
+     * result = digits * digits, result holds 2 * count digits and does not alias digits; scratch holds
+     * Karatsuba_scratch_count(count) digits. The middle product (a0 - a1)^2 is itself a square and never negative.
+     */
+    void square_Karatsuba(
+        digit *result,
+        digit const *digits,
+        size_t count,
+        digit *scratch) noexcept
+    {
+        if (count < Karatsuba_square_threshold)
+        {
+            square_schoolbook(result, digits, count);
+            return;
+        }
+
+        auto const half_count = (count + 1) / 2;
+        auto const high_count = count - half_count;
+
+        auto *difference = scratch;
+        auto *middle = difference + half_count;
+        auto *middle_sum = middle + 2 * half_count;
+        auto *next_scratch = middle_sum + 2 * half_count + 1;
+
+        subtract_absolute(difference, digits, half_count, digits + half_count, high_count, half_count);
+
+        square_Karatsuba(middle, difference, half_count, next_scratch);
+        square_Karatsuba(result, digits, half_count, next_scratch);
+        square_Karatsuba(result + 2 * half_count, digits + half_count, high_count, next_scratch);
+
+        // 2 * a0 * a1 = a0^2 + a1^2 - (a0 - a1)^2
+        middle_sum[2 * half_count] = add_digits(middle_sum, result, 2 * half_count, result + 2 * half_count, 2 * high_count);
+        subtract_digits(middle_sum, middle_sum, 2 * half_count + 1, middle, 2 * half_count);
+
+        auto const shifted_count = 2 * count - half_count;
+        add_digits(result + half_count, result + half_count, shifted_count, middle_sum, std::min(shifted_count, 2 * half_count + 1));
+    }
+
+    /*
+     * result = first * second, first_count >= second_count, result holds first_count + second_count digits
+     * and aliases neither operand. scratch holds Karatsuba_scratch_count(first_count) digits; the same
+     * operand passed twice is squared.
+     *
+     * Operands are split at half of the longer one; the middle product is (a0 - a1)(b0 - b1), so no
+     * part grows by a carry digit. A second operand of at most half the first one's length is
+     * multiplied by the first one's slices of its own length instead.
+     */
+    void multiply_Karatsuba(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count,
+        digit *scratch)
+    {
+        if (first == second && first_count == second_count)
+        {
+            square_Karatsuba(result, first, first_count, scratch);
+            return;
+        }
+
+        if (second_count < Karatsuba_threshold)
+        {
+            multiply_schoolbook(result, first, first_count, second, second_count);
+            return;
+        }
+
+        auto const half_count = (first_count + 1) / 2;
+        auto const product_count = first_count + second_count;
+
+        if (second_count <= half_count)
+        {
+            std::fill(result, result + product_count, 0);
+
+            auto *slice_product = scratch;
+            for (size_t offset = 0; offset < first_count; offset += second_count)
+            {
+                auto const slice_count = std::min(second_count, first_count - offset);
+                if (slice_count == second_count)
+                {
+                    multiply_Karatsuba(slice_product, first + offset, slice_count, second, second_count, scratch + 2 * second_count);
+                }
+                else
+                {
+                    multiply_Karatsuba(slice_product, second, second_count, first + offset, slice_count, scratch + 2 * second_count);
+                }
+
+                add_digits(result + offset, result + offset, product_count - offset, slice_product, slice_count + second_count);
+            }
+
+            return;
+        }
+
+        auto const first_high_count = first_count - half_count;
+        auto const second_high_count = second_count - half_count;
+
+        auto *first_difference = scratch;
+        auto *second_difference = first_difference + half_count;
+        auto *middle = second_difference + half_count;
+        auto *middle_sum = middle + 2 * half_count;
+        auto *next_scratch = middle_sum + 2 * half_count + 1;
+
+        auto const is_middle_negative =
+            subtract_absolute(first_difference, first, half_count, first + half_count, first_high_count, half_count)
+            != subtract_absolute(second_difference, second, half_count, second + half_count, second_high_count, half_count);
+
+        multiply_Karatsuba(middle, first_difference, half_count, second_difference, half_count, next_scratch);
+        multiply_Karatsuba(result, first, half_count, second, half_count, next_scratch);
+        multiply_Karatsuba(result + 2 * half_count, first + half_count, first_high_count, second + half_count, second_high_count, next_scratch);
+
+        // a0 * b1 + a1 * b0 = a0 * b0 + a1 * b1 - (a0 - a1)(b0 - b1)
+        auto const high_count = first_high_count + second_high_count;
+        middle_sum[2 * half_count] = add_digits(middle_sum, result, 2 * half_count, result + 2 * half_count, high_count);
+        if (is_middle_negative)
+        {
+            add_digits(middle_sum, middle_sum, 2 * half_count + 1, middle, 2 * half_count);
+        }
+        else
+        {
+            subtract_digits(middle_sum, middle_sum, 2 * half_count + 1, middle, 2 * half_count);
+        }
+
+        // the digits of the sum beyond the product's length are zeros
+        auto const shifted_count = product_count - half_count;
+        add_digits(result + half_count, result + half_count, shifted_count, middle_sum, std::min(shifted_count, 2 * half_count + 1));
+    }
+
+    void multiply_Karatsuba(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count)
+    {
+        if (first_count < second_count)
+        {
+            std::swap(first, second);
+            std::swap(first_count, second_count);
+        }
+
+        // the whole recursion works in one scratch buffer
+        digits_buffer scratch(Karatsuba_scratch_count(first_count));
+        multiply_Karatsuba(result, first, first_count, second, second_count, scratch.get());
+    }
+
+    /*
+     * result = digits * multiplier, result may alias digits; returns the carry out.
+     */
+    digit multiply_by_digit(
+        digit *result,
+        digit const *digits,
+        size_t count,
+        digit multiplier) noexcept
+    {
+        double_digit carry = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            carry += static_cast<double_digit>(digits[i]) * multiplier;
+            result[i] = static_cast<digit>(carry);
+            carry >>= digit_bits;
+        }
+
+        return static_cast<digit>(carry);
+    }
+
+    /*
+     * A signed magnitude of a width fixed by the caller, for the evaluation and interpolation steps of Toom-Cook.
+     */
+    struct signed_digits final
+    {
+
+        digit *digits;
+
+        bool is_negative;
+
+    };
+
+    /*
+     * result = first + second, or first - second; result may alias either operand.
+     */
+    void add_signed(
+        signed_digits &result,
+        signed_digits first,
+        signed_digits second,
+        size_t width,
+        bool is_subtraction = false) noexcept
+    {
+        if (is_subtraction)
+        {
+            second.is_negative = !second.is_negative;
+        }
+
+        if (first.is_negative == second.is_negative)
+        {
+            add_digits(result.digits, first.digits, width, second.digits, width);
+            result.is_negative = first.is_negative;
+            return;
+        }
+
+        // the result takes the sign of the larger magnitude
+        result.is_negative = subtract_absolute(result.digits, first.digits, width, second.digits, width, width)
+            ? second.is_negative
+            : first.is_negative;
+    }
+
+    void copy_padded(
+        digit *destination,
+        digit const *digits,
+        size_t count,
+        size_t width) noexcept
+    {
+        std::copy(digits, digits + count, destination);
+        std::fill(destination + count, destination + width, 0);
+    }
+
+    // below this many digits of the shorter operand, the next simpler algorithm is faster
+    constexpr size_t Toom3_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 200
+        : 100;
+
+    constexpr size_t Toom4_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 600
+        : 300;
+
+    // the evaluated pieces, of count / ways + 2 digits, must be shorter than the operand for the recursion to end
+    static_assert(Toom3_threshold >= 8 && Toom4_threshold >= 8, "Toom-Cook thresholds are too low");
+
+    size_t Toom_threshold(
+        size_t ways) noexcept
+    {
+        return ways == 4
+            ? Toom4_threshold
+            : Toom3_threshold;
+    }
+
+    /*
+     * Scratch digits needed by multiply_Toom for a first operand of count digits.
+     */
+    size_t Toom_scratch_count(
+        size_t count,
+        size_t ways) noexcept
+    {
+        auto const simpler_scratch_count = ways == 4
+            ? Toom_scratch_count(count, 3)
+            : Karatsuba_scratch_count(count);
+        if (count < Toom_threshold(ways))
+        {
+            return simpler_scratch_count;
+        }
+
+        // evaluations of both operands at 2 * ways - 3 points besides 0 and infinity, and their products
+        // with four temporaries, which are twice as wide
+        auto const evaluated_count = (count + ways - 1) / ways + 2;
+        auto const points_count = 2 * ways - 3;
+        auto const level_count = (4 * points_count + 8) * evaluated_count;
+
+        return std::max(simpler_scratch_count, level_count + Toom_scratch_count(evaluated_count, ways));
+    }
+
+    void multiply_Toom(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count,
+        size_t ways,
+        digit *scratch);
+
+    /*
+     * result = first * second in 2 * width digits.
+     */
+    void multiply_signed(
+        signed_digits &result,
+        signed_digits const &first,
+        signed_digits const &second,
+        size_t width,
+        size_t ways,
+        digit *scratch)
+    {
+        auto const *first_digits = first.digits;
+        auto const *second_digits = second.digits;
+        auto first_count = significant_count(first_digits, width);
+        auto second_count = significant_count(second_digits, width);
+
+        std::fill(result.digits, result.digits + 2 * width, 0);
+        result.is_negative = first.is_negative != second.is_negative;
+        if (first_count == 0 || second_count == 0)
+        {
+            return;
+        }
+
+        if (first_count < second_count)
+        {
+            std::swap(first_digits, second_digits);
+            std::swap(first_count, second_count);
+        }
+        multiply_Toom(result.digits, first_digits, first_count, second_digits, second_count, ways, scratch);
+    }
+
+    /*
+     * Evaluates a polynomial of 3 pieces at 1, -1 and -2 (Bodrato's sequence); values has 3 slots of width digits
+     * and temporary one.
+     */
+    void evaluate_Toom3(
+        signed_digits *values,
+        digit const *digits,
+        size_t count,
+        size_t piece_count,
+        size_t width,
+        digit *temporary) noexcept
+    {
+        auto const *low = digits;
+        auto const *middle = digits + piece_count;
+        auto const *high = digits + 2 * piece_count;
+        auto const middle_count = std::min(piece_count, count - piece_count);
+        auto const high_count = count - 2 * piece_count;
+
+        auto &at_one = values[0];
+        auto &at_minus_one = values[1];
+        auto &at_minus_two = values[2];
+
+        // a0 + a2 is shared by both values at +-1
+        copy_padded(temporary, low, piece_count, width);
+        add_digits(temporary, temporary, width, high, high_count);
+
+        add_digits(at_one.digits, temporary, width, middle, middle_count);
+        at_one.is_negative = false;
+        at_minus_one.is_negative = subtract_absolute(at_minus_one.digits, temporary, width, middle, middle_count, width);
+
+        // p(-2) = 2 * (p(-1) + a2) - a0
+        copy_padded(temporary, high, high_count, width);
+        add_signed(at_minus_two, at_minus_one, { temporary, false }, width);
+        multiply_by_digit(at_minus_two.digits, at_minus_two.digits, width, 2);
+        copy_padded(temporary, low, piece_count, width);
+        add_signed(at_minus_two, at_minus_two, { temporary, false }, width, true);
+    }
+
+    /*
+     * Evaluates a polynomial of 4 pieces at 1, -1, 2, -2 and 1/2, the last one scaled by 8; values has 5 slots
+     * of width digits and temporaries two.
+     */
+    void evaluate_Toom4(
+        signed_digits *values,
+        digit const *digits,
+        size_t count,
+        size_t piece_count,
+        size_t width,
+        digit *temporaries) noexcept
+    {
+        digit const *pieces[4];
+        size_t pieces_counts[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            auto const offset = std::min(i * piece_count, count);
+            pieces[i] = digits + offset;
+            pieces_counts[i] = std::min(piece_count, count - offset);
+        }
+
+        auto *even = temporaries;
+        auto *odd = temporaries + width;
+        for (size_t i = 0; i < 5; ++i)
+        {
+            values[i].is_negative = false;
+        }
+
+        // a0 + a2 +- (a1 + a3)
+        copy_padded(even, pieces[0], pieces_counts[0], width);
+        add_digits(even, even, width, pieces[2], pieces_counts[2]);
+        copy_padded(odd, pieces[1], pieces_counts[1], width);
+        add_digits(odd, odd, width, pieces[3], pieces_counts[3]);
+        add_digits(values[0].digits, even, width, odd, width);
+        values[1].is_negative = subtract_absolute(values[1].digits, even, width, odd, width, width);
+
+        // a0 + 4 * a2 +- (2 * a1 + 8 * a3)
+        copy_padded(even, pieces[2], pieces_counts[2], width);
+        multiply_by_digit(even, even, width, 4);
+        add_digits(even, even, width, pieces[0], pieces_counts[0]);
+        copy_padded(odd, pieces[3], pieces_counts[3], width);
+        multiply_by_digit(odd, odd, width, 4);
+        add_digits(odd, odd, width, pieces[1], pieces_counts[1]);
+        multiply_by_digit(odd, odd, width, 2);
+        add_digits(values[2].digits, even, width, odd, width);
+        values[3].is_negative = subtract_absolute(values[3].digits, even, width, odd, width, width);
+
+        // 8 * p(1/2) = ((2 * a0 + a1) * 2 + a2) * 2 + a3
+        auto *at_half = values[4].digits;
+        copy_padded(at_half, pieces[0], pieces_counts[0], width);
+        for (size_t i = 1; i < 4; ++i)
+        {
+            multiply_by_digit(at_half, at_half, width, 2);
+            add_digits(at_half, at_half, width, pieces[i], pieces_counts[i]);
+        }
+    }
+
+    void divide_signed(
+        signed_digits &value,
+        size_t width,
+        digit divisor) noexcept
+    {
+        // every division of the interpolation is exact
+        divide_by_digit(value.digits, value.digits, width, divisor);
+    }
+
+    void multiply_signed_by_digit(
+        signed_digits &result,
+        signed_digits const &value,
+        size_t width,
+        digit multiplier) noexcept
+    {
+        multiply_by_digit(result.digits, value.digits, width, multiplier);
+        result.is_negative = value.is_negative;
+    }
+
+    /*
+     * Turns the products at 1, -1 and -2 into the coefficients of x, x^2 and x^3 (Bodrato's sequence),
+     * given those of 1 and x^4 padded in constant_term and leading_term. The coefficients are left
+     * in the products' slots, in order.
+     */
+    void interpolate_Toom3(
+        signed_digits *products,
+        signed_digits const &constant_term,
+        signed_digits const &leading_term,
+        size_t width,
+        digit *temporary) noexcept
+    {
+        auto &at_one = products[0];
+        auto &at_minus_one = products[1];
+        auto &at_minus_two = products[2];
+
+        add_signed(at_minus_two, at_minus_two, at_one, width, true);
+        divide_signed(at_minus_two, width, 3);
+        add_signed(at_one, at_one, at_minus_one, width, true);
+        divide_signed(at_one, width, 2);
+        add_signed(at_minus_one, at_minus_one, constant_term, width, true);
+
+        add_signed(at_minus_two, at_minus_one, at_minus_two, width, true);
+        divide_signed(at_minus_two, width, 2);
+        signed_digits doubled_leading_term { temporary, false };
+        multiply_signed_by_digit(doubled_leading_term, leading_term, width, 2);
+        add_signed(at_minus_two, at_minus_two, doubled_leading_term, width);
+
+        add_signed(at_minus_one, at_minus_one, at_one, width);
+        add_signed(at_minus_one, at_minus_one, leading_term, width, true);
+        add_signed(at_one, at_one, at_minus_two, width, true);
+    }
+
+    /*
+     * Turns the products at 1, -1, 2, -2 and 1/2 (scaled by 64) into the coefficients of x to x^5, given those
+     * of 1 and x^6 padded in constant_term and leading_term. The odd and even halves of the values at +-1
+     * and +-2 are separated first; the even coefficients follow from them, and the odd ones from a 3 by 3
+     * system with the value at 1/2. coefficients receives x to x^4 in the products' slots and x^5
+     * in the second temporary.
+     */
+    void interpolate_Toom4(
+        signed_digits *products,
+        signed_digits const &constant_term,
+        signed_digits const &leading_term,
+        size_t width,
+        digit *temporaries,
+        signed_digits *coefficients) noexcept
+    {
+        auto &at_one = products[0];
+        auto &at_minus_one = products[1];
+        auto &at_two = products[2];
+        auto &at_minus_two = products[3];
+        auto &at_half = products[4];
+        signed_digits scaled { temporaries, false };
+        signed_digits fifth { temporaries + width, false };
+
+        // O1 = c1 + c3 + c5 and E1 = c0 + c2 + c4 + c6
+        add_signed(at_minus_one, at_one, at_minus_one, width, true);
+        divide_signed(at_minus_one, width, 2);
+        add_signed(at_one, at_one, at_minus_one, width, true);
+
+        // O2 = c1 + 4 * c3 + 16 * c5 and E2 = c0 + 4 * c2 + 16 * c4 + 64 * c6
+        add_signed(at_minus_two, at_two, at_minus_two, width, true);
+        divide_signed(at_minus_two, width, 2);
+        add_signed(at_two, at_two, at_minus_two, width, true);
+        divide_signed(at_minus_two, width, 2);
+
+        // c2 + c4 and c2 + 4 * c4
+        add_signed(at_one, at_one, constant_term, width, true);
+        add_signed(at_one, at_one, leading_term, width, true);
+        add_signed(at_two, at_two, constant_term, width, true);
+        multiply_signed_by_digit(scaled, leading_term, width, 64);
+        add_signed(at_two, at_two, scaled, width, true);
+        divide_signed(at_two, width, 4);
+
+        // c4 and c2
+        add_signed(at_two, at_two, at_one, width, true);
+        divide_signed(at_two, width, 3);
+        add_signed(at_one, at_one, at_two, width, true);
+
+        // H = 16 * c1 + 4 * c3 + c5
+        multiply_signed_by_digit(scaled, constant_term, width, 64);
+        add_signed(at_half, at_half, scaled, width, true);
+        multiply_signed_by_digit(scaled, at_one, width, 16);
+        add_signed(at_half, at_half, scaled, width, true);
+        multiply_signed_by_digit(scaled, at_two, width, 4);
+        add_signed(at_half, at_half, scaled, width, true);
+        add_signed(at_half, at_half, leading_term, width, true);
+        divide_signed(at_half, width, 2);
+
+        // P = (O2 - O1) / 3 = c3 + 5 * c5 and Q = (H - O1) / 3 = 5 * c1 + c3
+        add_signed(at_minus_two, at_minus_two, at_minus_one, width, true);
+        divide_signed(at_minus_two, width, 3);
+        add_signed(at_half, at_half, at_minus_one, width, true);
+        divide_signed(at_half, width, 3);
+
+        // c5 = (Q + 4 * P - 5 * O1) / 15, c3 = P - 5 * c5, c1 = O1 - c3 - c5
+        multiply_signed_by_digit(fifth, at_minus_two, width, 4);
+        add_signed(fifth, fifth, at_half, width);
+        multiply_signed_by_digit(scaled, at_minus_one, width, 5);
+        add_signed(fifth, fifth, scaled, width, true);
+        divide_signed(fifth, width, 15);
+        multiply_signed_by_digit(scaled, fifth, width, 5);
+        add_signed(at_minus_two, at_minus_two, scaled, width, true);
+        add_signed(at_minus_one, at_minus_one, at_minus_two, width, true);
+        add_signed(at_minus_one, at_minus_one, fifth, width, true);
+
+        coefficients[0] = at_minus_one;
+        coefficients[1] = at_one;
+        coefficients[2] = at_minus_two;
+        coefficients[3] = at_two;
+        coefficients[4] = fifth;
+    }
+
+    /*
+     * result = first * second by Toom-Cook splitting into ways (3 or 4) pieces, first_count >= second_count;
+     * result holds first_count + second_count digits and aliases neither operand. scratch holds
+     * Toom_scratch_count(first_count, ways) digits.
+     *
+     * Below the threshold, or when the second operand is too short to have all of its pieces, Toom-4
+     * passes the operands to Toom-3 and Toom-3 to Karatsuba.
+     */
+    void multiply_Toom(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count,
+        size_t ways,
+        digit *scratch)
+    {
+        auto const piece_count = (first_count + ways - 1) / ways;
+        if (second_count < Toom_threshold(ways) || second_count <= (ways - 1) * piece_count)
+        {
+            if (ways == 4)
+            {
+                multiply_Toom(result, first, first_count, second, second_count, 3, scratch);
+            }
+            else
+            {
+                multiply_Karatsuba(result, first, first_count, second, second_count, scratch);
+            }
+
+            return;
+        }
+
+        auto const width = piece_count + 2;
+        auto const product_width = 2 * width;
+        auto const points_count = 2 * ways - 3;
+
+        signed_digits first_values[5];
+        signed_digits second_values[5];
+        signed_digits products[5];
+        auto *current = scratch;
+        for (size_t i = 0; i < points_count; ++i)
+        {
+            first_values[i] = { current, false };
+            second_values[i] = { current + width, false };
+            current += 2 * width;
+        }
+        auto *temporaries = current;
+        current += 4 * product_width;
+        for (size_t i = 0; i < points_count; ++i)
+        {
+            products[i] = { current, false };
+            current += product_width;
+        }
+        auto *next_scratch = current;
+
+        // a square evaluates its operand once, and its products at the points are squares again
+        auto const is_square = first == second && first_count == second_count;
+        if (ways == 4)
+        {
+            evaluate_Toom4(first_values, first, first_count, piece_count, width, temporaries);
+            if (!is_square)
+            {
+                evaluate_Toom4(second_values, second, second_count, piece_count, width, temporaries);
+            }
+        }
+        else
+        {
+            evaluate_Toom3(first_values, first, first_count, piece_count, width, temporaries);
+            if (!is_square)
+            {
+                evaluate_Toom3(second_values, second, second_count, piece_count, width, temporaries);
+            }
+        }
+        if (is_square)
+        {
+            std::copy(first_values, first_values + points_count, second_values);
+        }
+
+        for (size_t i = 0; i < points_count; ++i)
+        {
+            multiply_signed(products[i], first_values[i], second_values[i], width, ways, next_scratch);
+        }
+
+        // the values at 0 and infinity are the lowest and the highest coefficients, which go to their places at once
+        auto const leading_offset = (ways - 1) * piece_count;
+        auto const leading_count = first_count + second_count - 2 * leading_offset;
+        auto const product_count = first_count + second_count;
+
+        multiply_Toom(result, first, piece_count, second, piece_count, ways, next_scratch);
+        std::fill(result + 2 * piece_count, result + 2 * leading_offset, 0);
+        multiply_Toom(result + 2 * leading_offset, first + leading_offset, first_count - leading_offset,
+            second + leading_offset, second_count - leading_offset, ways, next_scratch);
+
+        signed_digits constant_term { temporaries, false };
+        signed_digits leading_term { temporaries + product_width, false };
+        copy_padded(constant_term.digits, result, 2 * piece_count, product_width);
+        copy_padded(leading_term.digits, result + 2 * leading_offset, leading_count, product_width);
+
+        signed_digits coefficients[5];
+        if (ways == 4)
+        {
+            interpolate_Toom4(products, constant_term, leading_term, product_width, temporaries + 2 * product_width, coefficients);
+        }
+        else
+        {
+            interpolate_Toom3(products, constant_term, leading_term, product_width, temporaries + 2 * product_width);
+            std::copy(products, products + points_count, coefficients);
+        }
+
+        // the coefficients are not negative, and their digits beyond the product's length are zeros
+        for (size_t i = 0; i < points_count; ++i)
+        {
+            auto const offset = (i + 1) * piece_count;
+            auto const shifted_count = product_count - offset;
+            auto const coefficient_count = std::min(significant_count(coefficients[i].digits, product_width), shifted_count);
+            add_digits(result + offset, result + offset, shifted_count, coefficients[i].digits, coefficient_count);
+        }
+    }
+
+    void multiply_Toom3(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count)
+    {
+        if (first_count < second_count)
+        {
+            std::swap(first, second);
+            std::swap(first_count, second_count);
+        }
+
+        digits_buffer scratch(Toom_scratch_count(first_count, 3));
+        multiply_Toom(result, first, first_count, second, second_count, 3, scratch.get());
+    }
+
+    void multiply_Toom4(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count)
+    {
+        if (first_count < second_count)
+        {
+            std::swap(first, second);
+            std::swap(first_count, second_count);
+        }
+
+        digits_buffer scratch(Toom_scratch_count(first_count, 4));
+        multiply_Toom(result, first, first_count, second, second_count, 4, scratch.get());
+    }
+
+    /*
+     * Arithmetic modulo an odd prime below 2^31 in Montgomery form, where a is kept as a * 2^32 mod p.
+     */
+    class Montgomery_field final
+    {
+
+    private:
+
+        std::uint32_t _modulus;
+
+        // -p^-1 mod 2^32
+        std::uint32_t _negated_inverse;
+
+        // 2^64 mod p
+        std::uint32_t _r_squared;
+
+    public:
+
+        explicit Montgomery_field(
+            std::uint32_t modulus) noexcept:
+                _modulus(modulus)
+        {
+            // each Newton step doubles the number of correct low bits of p^-1
+            std::uint32_t inverse = modulus;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                inverse *= 2 - modulus * inverse;
+            }
+            _negated_inverse = 0u - inverse;
+
+            auto const r = (static_cast<std::uint64_t>(1) << 32) % modulus;
+            _r_squared = static_cast<std::uint32_t>(r * r % modulus);
+        }
+
+    public:
+
+        [[nodiscard]] std::uint32_t get_modulus() const noexcept
+        {
+            return _modulus;
+        }
+
+        /*
+         * value < p * 2^32; returns value * 2^-32 mod p.
+         */
+        [[nodiscard]] std::uint32_t reduce(
+            std::uint64_t value) const noexcept
+        {
+            auto const multiple = static_cast<std::uint32_t>(value) * _negated_inverse;
+            auto const reduced = static_cast<std::uint32_t>((value + static_cast<std::uint64_t>(multiple) * _modulus) >> 32);
+
+            return reduced >= _modulus
+                ? reduced - _modulus
+                : reduced;
+        }
+
+        [[nodiscard]] std::uint32_t multiply(
+            std::uint32_t first,
+            std::uint32_t second) const noexcept
+        {
+            return reduce(static_cast<std::uint64_t>(first) * second);
+        }
+
+        /*
+         * Any 32-bit value, not only a residue, may be brought to the form.
+         */
+        [[nodiscard]] std::uint32_t to_form(
+            std::uint32_t value) const noexcept
+        {
+            return multiply(value, _r_squared);
+        }
+
+        [[nodiscard]] std::uint32_t from_form(
+            std::uint32_t value) const noexcept
+        {
+            return reduce(value);
+        }
+
+        [[nodiscard]] std::uint32_t add(
+            std::uint32_t first,
+            std::uint32_t second) const noexcept
+        {
+            auto const sum = first + second;
+
+            return sum >= _modulus
+                ? sum - _modulus
+                : sum;
+        }
+
+        [[nodiscard]] std::uint32_t subtract(
+            std::uint32_t first,
+            std::uint32_t second) const noexcept
+        {
+            return first >= second
+                ? first - second
+                : first + _modulus - second;
+        }
+
+        [[nodiscard]] std::uint32_t power(
+            std::uint32_t base,
+            std::uint64_t exponent) const noexcept
+        {
+            auto result = to_form(1);
+            for (; exponent != 0; exponent >>= 1)
+            {
+                if ((exponent & 1) != 0)
+                {
+                    result = multiply(result, base);
+                }
+                base = multiply(base, base);
+            }
+
+            return result;
+        }
+
+    };
+
+    struct NTT_prime final
+    {
+
+        std::uint32_t modulus;
+
+        std::uint32_t primitive_root;
+
+    };
+
+    /*
+     * p - 1 of every prime is divisible by 2^26, and their product exceeds 2^90, which bounds
+     * the convolution of two transforms' worth of 32-bit words.
+     */
+    constexpr NTT_prime NTT_primes[] =
+    {
+        { 469762049, 3 },
+        { 1811939329, 13 },
+        { 2013265921, 31 }
+    };
+
+    constexpr size_t max_NTT_length = size_t(1) << 26;
+
+    // below this many digits of the shorter operand, Karatsuba multiplication is faster
+    constexpr size_t NTT_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 3000
+        : 8000;
+
+    // shorter transforms run in one thread, and the steps of longer ones are split in blocks of at least half as many words
+    constexpr size_t parallel_NTT_length = size_t(1) << 14;
+
+    /*
+     * Runs body(begin, end) over [0, count) as a few tasks of the pool per thread, so that stolen blocks even out
+     * the threads' loads, in blocks of at least block_count items; without a pool, in one call.
+     */
+    template<
+        typename body>
+    void for_each_block(
+        work_stealing_pool *pool,
+        size_t count,
+        size_t block_count,
+        body const &run)
+    {
+        auto const threads_count = pool == nullptr
+            ? 1
+            : pool->get_threads_count();
+        if (threads_count == 1 || count <= block_count)
+        {
+            run(0, count);
+            return;
+        }
+
+        auto const blocks_count = std::min((count + block_count - 1) / block_count, 4 * threads_count);
+        auto const step = (count + blocks_count - 1) / blocks_count;
+
+        work_stealing_pool::task_group group(*pool);
+        for (size_t begin = step; begin < count; begin += step)
+        {
+            auto const end = std::min(begin + step, count);
+            group.run([&run, begin, end]()
+            {
+                run(begin, end);
+            });
+        }
+        run(0, step);
+        group.wait();
+    }
+
+    /*
+     * Runs both functions, the first one as a task of the pool if there is one.
+     */
+    template<
+        typename first_function,
+        typename second_function>
+    void run_both(
+        work_stealing_pool *pool,
+        first_function const &first,
+        second_function const &second)
+    {
+        if (pool == nullptr || pool->get_threads_count() == 1)
+        {
+            first();
+            second();
+            return;
+        }
+
+        work_stealing_pool::task_group group(*pool);
+        group.run([&first]()
+        {
+            first();
+        });
+        second();
+        group.wait();
+    }
+
+    /*
+     * roots[half + j] = w^j for every power of two half below length, w of order 2 * half.
+     */
+    void fill_NTT_roots(
+        Montgomery_field const &field,
+        std::uint32_t primitive_root,
+        bool is_inverse,
+        std::uint32_t *roots,
+        size_t length) noexcept
+    {
+        auto const modulus = field.get_modulus();
+        for (size_t half = 1; half < length; half *= 2)
+        {
+            auto root = field.power(field.to_form(primitive_root), (modulus - 1) / (2 * half));
+            if (is_inverse)
+            {
+                root = field.power(root, modulus - 2);
+            }
+
+            auto current = field.to_form(1);
+            for (size_t j = 0; j < half; ++j)
+            {
+                roots[half + j] = current;
+                current = field.multiply(current, root);
+            }
+        }
+    }
+
+    /*
+     * The butterflies of one decimation in frequency stage for the pairs j in [begin, end) of a block whose
+     * halves are low and high. The field is taken by value: the modulus of a copy stays in a register, while
+     * that of a reference could change with any store to the values as far as the compiler knows, and would be
+     * reloaded in every butterfly.
+     */
+    void forward_butterflies(
+        Montgomery_field const field,
+        std::uint32_t *low,
+        std::uint32_t *high,
+        std::uint32_t const *roots,
+        size_t begin,
+        size_t end) noexcept
+    {
+        for (size_t j = begin; j < end; ++j)
+        {
+            auto const first = low[j];
+            auto const second = high[j];
+            low[j] = field.add(first, second);
+            high[j] = field.multiply(field.subtract(first, second), roots[j]);
+        }
+    }
+
+    /*
+     * The butterflies of one decimation in time stage, as forward_butterflies.
+     */
+    void inverse_butterflies(
+        Montgomery_field const field,
+        std::uint32_t *low,
+        std::uint32_t *high,
+        std::uint32_t const *inverse_roots,
+        size_t begin,
+        size_t end) noexcept
+    {
+        for (size_t j = begin; j < end; ++j)
+        {
+            auto const first = low[j];
+            auto const second = field.multiply(high[j], inverse_roots[j]);
+            low[j] = field.add(first, second);
+            high[j] = field.subtract(first, second);
+        }
+    }
+
+    /*
+     * Decimation in frequency: natural order in, bit-reversed order out.
+     */
+    void forward_NTT(
+        Montgomery_field const &field,
+        std::uint32_t *values,
+        size_t length,
+        std::uint32_t const *roots) noexcept
+    {
+        for (size_t half = length / 2; half != 0; half /= 2)
+        {
+            for (size_t start = 0; start < length; start += 2 * half)
+            {
+                forward_butterflies(field, values + start, values + start + half, roots + half, 0, half);
+            }
+        }
+    }
+
+    /*
+     * The first stage's butterflies in blocks, then the two halves it leaves, which are transforms of their own,
+     * at once; down to parallel_NTT_length words.
+     */
+    void forward_NTT(
+        Montgomery_field const &field,
+        std::uint32_t *values,
+        size_t length,
+        std::uint32_t const *roots,
+        work_stealing_pool *pool)
+    {
+        if (pool == nullptr || length < parallel_NTT_length)
+        {
+            forward_NTT(field, values, length, roots);
+            return;
+        }
+
+        auto const half = length / 2;
+        for_each_block(pool, half, parallel_NTT_length / 2, [&field, values, half, roots](size_t begin, size_t end)
+        {
+            forward_butterflies(field, values, values + half, roots + half, begin, end);
+        });
+
+        run_both(pool, [&field, values, half, roots, pool]()
+        {
+            forward_NTT(field, values, half, roots, pool);
+        }, [&field, values, half, roots, pool]()
+        {
+            forward_NTT(field, values + half, half, roots, pool);
+        });
+    }
+
+    /*
+     * Decimation in time with inverse roots: bit-reversed order in, natural order out, scaled by length.
+     */
+    void inverse_NTT(
+        Montgomery_field const &field,
+        std::uint32_t *values,
+        size_t length,
+        std::uint32_t const *inverse_roots) noexcept
+    {
+        for (size_t half = 1; half < length; half *= 2)
+        {
+            for (size_t start = 0; start < length; start += 2 * half)
+            {
+                inverse_butterflies(field, values + start, values + start + half, inverse_roots + half, 0, half);
+            }
+        }
+    }
+
+    /*
+     * The two halves at once, then the last stage's butterflies in blocks; down to parallel_NTT_length words.
+     */
+    void inverse_NTT(
+        Montgomery_field const &field,
+        std::uint32_t *values,
+        size_t length,
+        std::uint32_t const *inverse_roots,
+        work_stealing_pool *pool)
+    {
+        if (pool == nullptr || length < parallel_NTT_length)
+        {
+            inverse_NTT(field, values, length, inverse_roots);
+            return;
+        }
+
+        auto const half = length / 2;
+        run_both(pool, [&field, values, half, inverse_roots, pool]()
+        {
+            inverse_NTT(field, values, half, inverse_roots, pool);
+        }, [&field, values, half, inverse_roots, pool]()
+        {
+            inverse_NTT(field, values + half, half, inverse_roots, pool);
+        });
+
+        for_each_block(pool, half, parallel_NTT_length / 2, [&field, values, half, inverse_roots](size_t begin, size_t end)
+        {
+            inverse_butterflies(field, values, values + half, inverse_roots + half, begin, end);
+        });
+    }
+
+    std::uint32_t word_at(
+        digit const *digits,
+        size_t position) noexcept
+    {
+        return static_cast<std::uint32_t>(digits[position / words_per_digit] >> (32 * (position % words_per_digit)));
+    }
+
+    std::uint64_t power_modulo(
+        std::uint64_t base,
+        std::uint64_t exponent,
+        std::uint64_t modulus) noexcept
+    {
+        std::uint64_t result = 1;
+        for (base %= modulus; exponent != 0; exponent >>= 1)
+        {
+            if ((exponent & 1) != 0)
+            {
+                result = result * base % modulus;
+            }
+            base = base * base % modulus;
+        }
+
+        return result;
+    }
+
+    /*
+     * result = first * second through number theoretic transforms of the operands' 32-bit words modulo
+     * three primes; the exact convolution is recovered with the Chinese remainder theorem (Garner's form)
+     * and its carries are propagated. Operands too long for the transforms go to Toom-4. result holds
+     * first_count + second_count digits and aliases neither operand; the same operand passed twice is
+     * transformed once.
+     *
+     * With a pool, the primes are still taken one after another, so the memory stays that of one thread, while
+     * each one's loads, butterflies and pointwise products, and the recovery, are spread over the pool's threads;
+     * only the carries are propagated by one thread.
+     */
+    void multiply_transformed(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count,
+        work_stealing_pool *pool)
+    {
+        auto const first_words_count = first_count * words_per_digit;
+        auto const second_words_count = second_count * words_per_digit;
+        auto const product_words_count = first_words_count + second_words_count;
+
+        size_t length = 1;
+        while (length < product_words_count - 1)
+        {
+            length *= 2;
+        }
+
+        if (length > max_NTT_length)
+        {
+            multiply_Toom4(result, first, first_count, second, second_count);
+            return;
+        }
+
+        auto const is_square = first == second && first_count == second_count;
+
+        std::vector<std::uint32_t> residues(3 * length);
+        std::vector<std::uint32_t> transformed(is_square
+            ? 0
+            : length);
+        std::vector<std::uint32_t> roots(length);
+        std::vector<std::uint32_t> inverse_roots(length);
+
+        for (size_t prime = 0; prime < 3; ++prime)
+        {
+            Montgomery_field const field(NTT_primes[prime].modulus);
+            auto const primitive_root = NTT_primes[prime].primitive_root;
+            run_both(pool, [&field, primitive_root, &roots, length]()
+            {
+                fill_NTT_roots(field, primitive_root, false, roots.data(), length);
+            }, [&field, primitive_root, &inverse_roots, length]()
+            {
+                fill_NTT_roots(field, primitive_root, true, inverse_roots.data(), length);
+            });
+
+            auto const load_and_transform = [&field, &roots, length, pool](std::uint32_t *values, digit const *digits, size_t words_count)
+            {
+                for_each_block(pool, length, parallel_NTT_length, [field, values, digits, words_count](size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        values[i] = i < words_count
+                            ? field.to_form(word_at(digits, i))
+                            : 0;
+                    }
+                });
+                forward_NTT(field, values, length, roots.data(), pool);
+            };
+
+            // a square transforms its operand once
+            auto *first_transformed = residues.data() + prime * length;
+            auto const *second_transformed = first_transformed;
+            if (is_square)
+            {
+                load_and_transform(first_transformed, first, first_words_count);
+            }
+            else
+            {
+                run_both(pool, [&load_and_transform, first_transformed, first, first_words_count]()
+                {
+                    load_and_transform(first_transformed, first, first_words_count);
+                }, [&load_and_transform, &transformed, second, second_words_count]()
+                {
+                    load_and_transform(transformed.data(), second, second_words_count);
+                });
+                second_transformed = transformed.data();
+            }
+
+            auto const inverse_length = field.power(field.to_form(static_cast<std::uint32_t>(length)), field.get_modulus() - 2);
+            for_each_block(pool, length, parallel_NTT_length, [field, first_transformed, second_transformed, inverse_length](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    first_transformed[i] = field.multiply(field.multiply(first_transformed[i], second_transformed[i]), inverse_length);
+                }
+            });
+
+            inverse_NTT(field, first_transformed, length, inverse_roots.data(), pool);
+            for_each_block(pool, length, parallel_NTT_length, [field, first_transformed](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    first_transformed[i] = field.from_form(first_transformed[i]);
+                }
+            });
+        }
+
+        auto const first_inverse = power_modulo(NTT_primes[0].modulus, NTT_primes[1].modulus - 2, NTT_primes[1].modulus);
+        auto const first_second_inverse = power_modulo(std::uint64_t(NTT_primes[0].modulus) * NTT_primes[1].modulus % NTT_primes[2].modulus,
+            NTT_primes[2].modulus - 2, NTT_primes[2].modulus);
+        std::uint64_t const mask = 0xFFFFFFFFull;
+
+        // each value of the convolution, three 32-bit words, replaces its residues
+        auto *values = residues.data();
+        for_each_block(pool, std::min(length, product_words_count), parallel_NTT_length,
+            [values, length, first_inverse, first_second_inverse](size_t begin, size_t end)
+        {
+            // constants, so that the remainders compile to multiplications
+            constexpr std::uint64_t first_modulus = NTT_primes[0].modulus;
+            constexpr std::uint64_t second_modulus = NTT_primes[1].modulus;
+            constexpr std::uint64_t third_modulus = NTT_primes[2].modulus;
+            constexpr std::uint64_t mask = 0xFFFFFFFFull;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                // value = r1 + p1 * (v2 + p2 * v3)
+                std::uint64_t const first_residue = values[i];
+                std::uint64_t const second_residue = values[length + i];
+                std::uint64_t const third_residue = values[2 * length + i];
+
+                auto const second_coefficient = (second_residue + second_modulus - first_residue % second_modulus) % second_modulus * first_inverse % second_modulus;
+                auto const known = (first_residue + second_coefficient % third_modulus * (first_modulus % third_modulus)) % third_modulus;
+                auto const third_coefficient = (third_residue + third_modulus - known) % third_modulus * first_second_inverse % third_modulus;
+                auto const upper = second_coefficient + second_modulus * third_coefficient;
+
+                auto word = first_residue + first_modulus * (upper & mask);
+                values[i] = static_cast<std::uint32_t>(word & mask);
+                word = (word >> 32) + first_modulus * (upper >> 32);
+                values[length + i] = static_cast<std::uint32_t>(word & mask);
+                values[2 * length + i] = static_cast<std::uint32_t>(word >> 32);
+            }
+        });
+
+        std::fill(result, result + first_count + second_count, 0);
+
+        // the carry is three 32-bit words
+        std::uint64_t carry[3] = { 0, 0, 0 };
+        for (size_t i = 0; i < product_words_count; ++i)
+        {
+            std::uint64_t value[3] = { 0, 0, 0 };
+            if (i < length)
+            {
+                value[0] = values[i];
+                value[1] = values[length + i];
+                value[2] = values[2 * length + i];
+            }
+
+            auto sum = carry[0] + value[0];
+            result[i / words_per_digit] |= static_cast<digit>(sum & mask) << (32 * (i % words_per_digit));
+            sum = (sum >> 32) + carry[1] + value[1];
+            carry[0] = sum & mask;
+            sum = (sum >> 32) + carry[2] + value[2];
+            carry[1] = sum & mask;
+            carry[2] = sum >> 32;
+        }
+    }
+
+    void multiply_transformed(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count)
+    {
+        multiply_transformed(result, first, first_count, second, second_count, nullptr);
+    }
+
+    /*
+     * The transform for operands whose shorter one has at least NTT_threshold digits, Karatsuba for the others.
+     */
+    void multiply_NTT(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count)
+    {
+        if (std::min(first_count, second_count) < NTT_threshold)
+        {
+            multiply_Karatsuba(result, first, first_count, second, second_count);
+            return;
+        }
+
+        multiply_transformed(result, first, first_count, second, second_count);
+    }
+
+    // from this many digits of the shorter operand on, the transform beats Toom-4
+    constexpr size_t automatic_NTT_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 10000
+        : 24000;
+
+    /*
+     * The fastest algorithm for the operands' size: Toom-4 cascades down to Toom-3, Karatsuba and schoolbook
+     * multiplication by its own thresholds.
+     */
+    void multiply_automatic(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count)
+    {
+        if (std::min(first_count, second_count) >= automatic_NTT_threshold)
+        {
+            multiply_transformed(result, first, first_count, second, second_count);
+            return;
+        }
+
+        multiply_Toom4(result, first, first_count, second, second_count);
+    }
+
+    using digits_multiplier = void (*)(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count);
+
+    /*
+     * result = first * second in first_count + second_count digits; the operands may have leading zeros or none
+     * at all, which the multipliers do not take.
+     */
+    void multiply_padded(
+        digits_multiplier multiplier,
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count)
+    {
+        auto const product_count = first_count + second_count;
+        first_count = significant_count(first, first_count);
+        second_count = significant_count(second, second_count);
+
+        if (first_count == 0 || second_count == 0)
+        {
+            std::fill(result, result + product_count, 0);
+            return;
+        }
+
+        multiplier(result, first, first_count, second, second_count);
+        std::fill(result + first_count + second_count, result + product_count, 0);
+    }
+
+    // the parallel rule multiplies operands whose shorter one is shorter than this in the calling thread,
+    // and so do its tasks with their own products
+    constexpr size_t parallel_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 4000
+        : 2000;
+
+    /*
+     * result = first * second by the Karatsuba split with its three products, or the products of the longer
+     * operand's slices by a much shorter one, run as tasks of the pool. The tasks split their products again
+     * until there are about parallelism of them or the products fall below parallel_threshold, and
+     * multiply_automatic computes the rest; each product has buffers of its own, as tasks cannot share a scratch.
+     * Operands may have leading zeros; result holds first_count + second_count digits and aliases neither
+     * operand, and the same operand passed twice is squared.
+     */
+    void multiply_Karatsuba(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count,
+        work_stealing_pool &pool,
+        size_t parallelism)
+    {
+        if (first_count < second_count)
+        {
+            std::swap(first, second);
+            std::swap(first_count, second_count);
+        }
+
+        if (parallelism <= 1 || second_count < parallel_threshold)
+        {
+            multiply_padded(multiply_automatic, result, first, first_count, second, second_count);
+            return;
+        }
+
+        auto const half_count = (first_count + 1) / 2;
+        auto const product_count = first_count + second_count;
+
+        if (second_count <= half_count)
+        {
+            auto const slices_count = (first_count + second_count - 1) / second_count;
+            auto const slice_parallelism = (parallelism + slices_count - 1) / slices_count;
+            digits_buffer slice_products(2 * second_count * slices_count);
+            auto *slice_product = slice_products.get();
+
+            {
+                work_stealing_pool::task_group group(pool);
+                for (size_t offset = 0; offset < first_count; offset += second_count)
+                {
+                    group.run([=, &pool]()
+                    {
+                        multiply_Karatsuba(slice_product + 2 * offset, first + offset, std::min(second_count, first_count - offset),
+                            second, second_count, pool, slice_parallelism);
+                    });
+                }
+                group.wait();
+            }
+
+            std::fill(result, result + product_count, 0);
+            for (size_t offset = 0; offset < first_count; offset += second_count)
+            {
+                auto const slice_count = std::min(second_count, first_count - offset);
+                add_digits(result + offset, result + offset, product_count - offset, slice_product + 2 * offset, slice_count + second_count);
+            }
+
+            return;
+        }
+
+        auto const first_high_count = first_count - half_count;
+        auto const second_high_count = second_count - half_count;
+        auto const is_square = first == second && first_count == second_count;
+
+        digits_buffer differences(2 * half_count);
+        auto *first_difference = differences.get();
+        auto *second_difference = first_difference + half_count;
+
+        // the middle product of a square is a square too
+        auto is_middle_negative = subtract_absolute(first_difference, first, half_count, first + half_count, first_high_count, half_count);
+        if (is_square)
+        {
+            second_difference = first_difference;
+            is_middle_negative = false;
+        }
+        else
+        {
+            is_middle_negative = is_middle_negative
+                != subtract_absolute(second_difference, second, half_count, second + half_count, second_high_count, half_count);
+        }
+
+        digits_buffer middle_product(2 * half_count);
+        auto *middle = middle_product.get();
+        auto const branch_parallelism = (parallelism + 2) / 3;
+
+        {
+            work_stealing_pool::task_group group(pool);
+            group.run([=, &pool]()
+            {
+                multiply_Karatsuba(middle, first_difference, half_count, second_difference, half_count, pool, branch_parallelism);
+            });
+            group.run([=, &pool]()
+            {
+                multiply_Karatsuba(result, first, half_count, second, half_count, pool, branch_parallelism);
+            });
+            multiply_Karatsuba(result + 2 * half_count, first + half_count, first_high_count, second + half_count, second_high_count,
+                pool, branch_parallelism);
+            group.wait();
+        }
+
+        // a0 * b1 + a1 * b0 = a0 * b0 + a1 * b1 - (a0 - a1)(b0 - b1)
+        digits_buffer middle_sum_digits(2 * half_count + 1);
+        auto *middle_sum = middle_sum_digits.get();
+        auto const high_count = first_high_count + second_high_count;
+        middle_sum[2 * half_count] = add_digits(middle_sum, result, 2 * half_count, result + 2 * half_count, high_count);
+        if (is_middle_negative)
+        {
+            add_digits(middle_sum, middle_sum, 2 * half_count + 1, middle, 2 * half_count);
+        }
+        else
+        {
+            subtract_digits(middle_sum, middle_sum, 2 * half_count + 1, middle, 2 * half_count);
+        }
+
+        // the digits of the sum beyond the product's length are zeros
+        auto const shifted_count = product_count - half_count;
+        add_digits(result + half_count, result + half_count, shifted_count, middle_sum, std::min(shifted_count, 2 * half_count + 1));
+    }
+
+    /*
+     * multiply_automatic with its work spread over the threads of the pool: the transform's steps for operands
+     * it takes, the Karatsuba split's products for shorter ones. Operands whose shorter one is below
+     * parallel_threshold, and any operands for a pool of one thread, are multiplied by multiply_automatic.
+     */
+    void multiply_parallel(
+        digit *result,
+        digit const *first,
+        size_t first_count,
+        digit const *second,
+        size_t second_count)
+    {
+        auto const shorter_count = std::min(first_count, second_count);
+        if (shorter_count < parallel_threshold)
+        {
+            multiply_automatic(result, first, first_count, second, second_count);
+            return;
+        }
+
+        auto &pool = work_stealing_pool::instance();
+        auto const threads_count = pool.get_threads_count();
+        if (threads_count == 1)
+        {
+            multiply_automatic(result, first, first_count, second, second_count);
+        }
+        else if (shorter_count >= automatic_NTT_threshold)
+        {
+            multiply_transformed(result, first, first_count, second, second_count, &pool);
+        }
+        else
+        {
+            multiply_Karatsuba(result, first, first_count, second, second_count, pool, threads_count);
+        }
+    }
+
+    /*
+     * Limb-wise kernels are written once over a vector type, GCC's vector extension of digits, and the wrappers'
+     * targets compile them to scalar code or to AVX2 or AVX-512 instructions; the processor's features choose the
+     * wrappers once, at the first call. Vectors are loaded and stored unaligned, through memcpy, and passed
+     * by reference only, as passing them by value has a different ABI in each target.
+     */
+    enum class limbwise_operation
+    {
+        conjunction,
+        disjunction,
+        exclusive_disjunction,
+        inversion
+    };
+
+    template<
+        limbwise_operation operation,
+        typename vector>
+    __attribute__((always_inline)) inline void apply_limbwise(
+        vector &result,
+        vector const &operand) noexcept
+    {
+        switch (operation)
+        {
+            case limbwise_operation::conjunction:
+                result &= operand;
+                break;
+            case limbwise_operation::disjunction:
+                result |= operand;
+                break;
+            case limbwise_operation::exclusive_disjunction:
+                result ^= operand;
+                break;
+            case limbwise_operation::inversion:
+                result = ~result;
+                break;
+        }
+    }
+
+    /*
+     * result[i] = result[i] operation operand[i] for i < count; inversion ignores the operand.
+     */
+    template<
+        typename vector,
+        limbwise_operation operation>
+    __attribute__((always_inline)) inline void combine_digits(
+        digit *result,
+        digit const *operand,
+        size_t count) noexcept
+    {
+        constexpr size_t lanes = sizeof(vector) / sizeof(digit);
+
+        size_t i = 0;
+        for (; i + lanes <= count; i += lanes)
+        {
+            vector current;
+            std::memcpy(&current, result + i, sizeof(vector));
+            auto other = current;
+            if (operation != limbwise_operation::inversion)
+            {
+                std::memcpy(&other, operand + i, sizeof(vector));
+            }
+            apply_limbwise<operation>(current, other);
+            std::memcpy(result + i, &current, sizeof(vector));
+        }
+        for (; i < count; ++i)
+        {
+            apply_limbwise<operation>(result[i], operation == limbwise_operation::inversion
+                ? result[i]
+                : operand[i]);
+        }
+    }
+
+    /*
+     * result = digits << bits, 0 < bits < digit_bits, count >= 1; result may alias digits, as the digits are
+     * shifted from the most significant down. Returns the bits shifted out.
+     */
+    template<
+        typename vector>
+    __attribute__((always_inline)) inline digit shift_digits_left(
+        digit *result,
+        digit const *digits,
+        size_t count,
+        size_t bits) noexcept
+    {
+        constexpr size_t lanes = sizeof(vector) / sizeof(digit);
+        auto const carry = digits[count - 1] >> (digit_bits - bits);
+
+        auto i = count;
+        for (; i > lanes; i -= lanes)
+        {
+            vector current;
+            vector lower;
+            std::memcpy(&current, digits + i - lanes, sizeof(vector));
+            std::memcpy(&lower, digits + i - lanes - 1, sizeof(vector));
+            current = (current << static_cast<digit>(bits)) | (lower >> static_cast<digit>(digit_bits - bits));
+            std::memcpy(result + i - lanes, &current, sizeof(vector));
+        }
+        for (; i > 1; --i)
+        {
+            result[i - 1] = (digits[i - 1] << bits) | (digits[i - 2] >> (digit_bits - bits));
+        }
+        result[0] = digits[0] << bits;
+
+        return carry;
+    }
+
+    /*
+     * result = digits >> bits, 0 < bits < digit_bits, with fill as the digit above the most significant one;
+     * result may alias digits or precede them, as the digits are shifted from the least significant up.
+     */
+    template<
+        typename vector>
+    __attribute__((always_inline)) inline void shift_digits_right(
+        digit *result,
+        digit const *digits,
+        size_t count,
+        size_t bits,
+        digit fill) noexcept
+    {
+        constexpr size_t lanes = sizeof(vector) / sizeof(digit);
+
+        size_t i = 0;
+        for (; i + lanes < count; i += lanes)
+        {
+            vector current;
+            vector upper;
+            std::memcpy(&current, digits + i, sizeof(vector));
+            std::memcpy(&upper, digits + i + 1, sizeof(vector));
+            current = (current >> static_cast<digit>(bits)) | (upper << static_cast<digit>(digit_bits - bits));
+            std::memcpy(result + i, &current, sizeof(vector));
+        }
+        for (; i < count; ++i)
+        {
+            auto const next = i + 1 < count
+                ? digits[i + 1]
+                : fill;
+            result[i] = (digits[i] >> bits) | (next << (digit_bits - bits));
+        }
+    }
+
+    /*
+     * The limb-wise kernels of one target.
+     */
+    struct limbwise_kernels final
+    {
+
+        void (*conjoin)(
+            digit *result,
+            digit const *operand,
+            size_t count);
+
+        void (*disjoin)(
+            digit *result,
+            digit const *operand,
+            size_t count);
+
+        void (*exclusively_disjoin)(
+            digit *result,
+            digit const *operand,
+            size_t count);
+
+        void (*invert)(
+            digit *result,
+            digit const *operand,
+            size_t count);
+
+        digit (*shift_left)(
+            digit *result,
+            digit const *digits,
+            size_t count,
+            size_t bits);
+
+        void (*shift_right)(
+            digit *result,
+            digit const *digits,
+            size_t count,
+            size_t bits,
+            digit fill);
+
+    };
+
+    template<
+        typename vector>
+    limbwise_kernels make_limbwise_kernels() noexcept
+    {
+        return limbwise_kernels
+        {
+            combine_digits<vector, limbwise_operation::conjunction>,
+            combine_digits<vector, limbwise_operation::disjunction>,
+            combine_digits<vector, limbwise_operation::exclusive_disjunction>,
+            combine_digits<vector, limbwise_operation::inversion>,
+            shift_digits_left<vector>,
+            shift_digits_right<vector>
+        };
+    }
+
+#if defined(BIG_INTEGER_X86_VECTOR_KERNELS)
+
+    typedef digit avx2_vector __attribute__((vector_size(32)));
+
+    typedef digit avx512_vector __attribute__((vector_size(64)));
+
+#define BIG_INTEGER_TARGET_KERNELS(target_name, vector, prefix) \
+    __attribute__((target(target_name))) void prefix##_conjoin(digit *result, digit const *operand, size_t count) \
+    { \
+        combine_digits<vector, limbwise_operation::conjunction>(result, operand, count); \
+    } \
+    __attribute__((target(target_name))) void prefix##_disjoin(digit *result, digit const *operand, size_t count) \
+    { \
+        combine_digits<vector, limbwise_operation::disjunction>(result, operand, count); \
+    } \
+    __attribute__((target(target_name))) void prefix##_exclusively_disjoin(digit *result, digit const *operand, size_t count) \
+    { \
+        combine_digits<vector, limbwise_operation::exclusive_disjunction>(result, operand, count); \
+    } \
+    __attribute__((target(target_name))) void prefix##_invert(digit *result, digit const *operand, size_t count) \
+    { \
+        combine_digits<vector, limbwise_operation::inversion>(result, operand, count); \
+    } \
+    __attribute__((target(target_name))) digit prefix##_shift_left(digit *result, digit const *digits, size_t count, size_t bits) \
+    { \
+        return shift_digits_left<vector>(result, digits, count, bits); \
+    } \
+    __attribute__((target(target_name))) void prefix##_shift_right(digit *result, digit const *digits, size_t count, size_t bits, \
+        digit fill) \
+    { \
+        shift_digits_right<vector>(result, digits, count, bits, fill); \
+    }
+
+    BIG_INTEGER_TARGET_KERNELS("avx2", avx2_vector, avx2)
+    BIG_INTEGER_TARGET_KERNELS("avx512f", avx512_vector, avx512)
+
+#undef BIG_INTEGER_TARGET_KERNELS
+
+#endif
+
+    limbwise_kernels const &choose_limbwise_kernels() noexcept
+    {
+        static limbwise_kernels const chosen = []()
+        {
+#if defined(BIG_INTEGER_X86_VECTOR_KERNELS)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return limbwise_kernels { avx512_conjoin, avx512_disjoin, avx512_exclusively_disjoin, avx512_invert,
+                    avx512_shift_left, avx512_shift_right };
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return limbwise_kernels { avx2_conjoin, avx2_disjoin, avx2_exclusively_disjoin, avx2_invert,
+                    avx2_shift_left, avx2_shift_right };
+            }
+#endif
+            return make_limbwise_kernels<digit>();
+        }();
+
+        return chosen;
+    }
+
+    /*
+     * result = digits << bits, bits < digit_bits; result may alias digits. Returns the bits shifted out.
+     */
+    digit shift_left(
+        digit *result,
+        digit const *digits,
+        size_t count,
+        size_t bits) noexcept
+    {
+        if (bits == 0 || count == 0)
+        {
+            std::memmove(result, digits, count * sizeof(digit));
+            return 0;
+        }
+
+        return choose_limbwise_kernels().shift_left(result, digits, count, bits);
+    }
+
+    /*
+     * result = digits >> bits, bits < digit_bits, with fill as the digit above the most significant one;
+     * result may alias digits or precede them.
+     */
+    void shift_right(
+        digit *result,
+        digit const *digits,
+        size_t count,
+        size_t bits,
+        digit fill) noexcept
+    {
+        if (bits == 0)
+        {
+            std::memmove(result, digits, count * sizeof(digit));
+            return;
+        }
+
+        choose_limbwise_kernels().shift_right(result, digits, count, bits, fill);
+    }
+
+    /*
+     * Moller and Granlund's reciprocal of a normalized digit, floor((B^2 - 1) / divisor) - B, where B is 2^digit_bits:
+     * with it, a double digit is divided by the divisor in two multiplications instead of a hardware division.
+     */
+    digit reciprocal_digit(
+        digit divisor) noexcept
+    {
+        return static_cast<digit>(~static_cast<double_digit>(0) / divisor);
+    }
+
+    /*
+     * (high * B + low) / divisor for a normalized divisor and high < divisor; returns the quotient digit.
+     */
+    digit divide_by_reciprocal_digit(
+        digit high,
+        digit low,
+        digit divisor,
+        digit reciprocal,
+        digit &remainder) noexcept
+    {
+        auto const estimate = static_cast<double_digit>(reciprocal) * high
+            + ((static_cast<double_digit>(high) << digit_bits) | low);
+        auto quotient = static_cast<digit>(estimate >> digit_bits) + 1;
+        auto rest = static_cast<digit>(low - quotient * divisor);
+
+        if (rest > static_cast<digit>(estimate))
+        {
+            --quotient;
+            rest += divisor;
+        }
+        if (rest >= divisor)
+        {
+            ++quotient;
+            rest -= divisor;
+        }
+
+        remainder = rest;
+        return quotient;
+    }
+
+    /*
+     * Knuth's algorithm D on a normalized divisor (its top bit set) of divisor_count digits, with reciprocal being
+     * reciprocal_digit of its top digit. window holds the normalized dividend in window_count > divisor_count digits,
+     * the top divisor_count of which are less than the divisor; it is left with the normalized remainder in its low
+     * divisor_count digits and zeros above. quotient receives window_count - divisor_count digits and may be nullptr.
+     */
+    void divide_normalized(
+        digit *quotient,
+        digit *window,
+        size_t window_count,
+        digit const *divisor,
+        size_t divisor_count,
+        digit reciprocal) noexcept
+    {
+        auto const top_digit = divisor[divisor_count - 1];
+
+        if (divisor_count == 1)
+        {
+            auto rest = window[window_count - 1];
+            for (size_t i = window_count - 1; i-- > 0;)
+            {
+                auto const quotient_digit = divide_by_reciprocal_digit(rest, window[i], top_digit, reciprocal, rest);
+                if (quotient != nullptr)
+                {
+                    quotient[i] = quotient_digit;
+                }
+            }
+            window[0] = rest;
+            std::fill(window + 1, window + window_count, 0);
+
+            return;
+        }
+
+        // with the top bit of the divisor set, each quotient digit estimate is off by at most 2
+        auto const next_digit = divisor[divisor_count - 2];
+
+        for (size_t i = window_count - divisor_count; i-- > 0;)
+        {
+            auto *current = window + i;
+
+            double_digit estimate = max_digit;
+            double_digit estimate_remainder;
+            if (current[divisor_count] >= top_digit)
+            {
+                estimate_remainder = static_cast<double_digit>(current[divisor_count - 1]) + top_digit;
+            }
+            else
+            {
+                digit rest;
+                estimate = divide_by_reciprocal_digit(current[divisor_count], current[divisor_count - 1], top_digit, reciprocal, rest);
+                estimate_remainder = rest;
+            }
+
+            while (estimate_remainder <= max_digit
+                && estimate * next_digit > ((estimate_remainder << digit_bits) | current[divisor_count - 2]))
+            {
+                --estimate;
+                estimate_remainder += top_digit;
+            }
+
+            auto const borrow = subtract_multiplied(current, divisor, divisor_count, static_cast<digit>(estimate));
+            if (current[divisor_count] < borrow)
+            {
+                // the estimate was one too big
+                --estimate;
+                current[divisor_count] -= borrow;
+                current[divisor_count] += add_digits(current, current, divisor_count, divisor, divisor_count);
+            }
+            else
+            {
+                current[divisor_count] -= borrow;
+            }
+
+            if (quotient != nullptr)
+            {
+                quotient[i] = static_cast<digit>(estimate);
+            }
+        }
+    }
+
+    /*
+     * Knuth's algorithm D for magnitudes without leading zeros, dividend_count >= divisor_count >= 1.
+     * quotient receives dividend_count - divisor_count + 1 digits and remainder divisor_count digits;
+     * either may be nullptr.
+     */
+    void divide_magnitudes(
+        digit *quotient,
+        digit *remainder,
+        digit const *dividend,
+        size_t dividend_count,
+        digit const *divisor,
+        size_t divisor_count)
+    {
+        auto const shift = leading_zeros(divisor[divisor_count - 1]);
+
+        digits_buffer normalized_divisor(divisor_count);
+        auto *normalized_divisor_digits = normalized_divisor.get();
+        shift_left(normalized_divisor_digits, divisor, divisor_count, shift);
+
+        digits_buffer window(dividend_count + 1);
+        auto *window_digits = window.get();
+        window_digits[dividend_count] = shift_left(window_digits, dividend, dividend_count, shift);
+
+        divide_normalized(quotient, window_digits, dividend_count + 1, normalized_divisor_digits, divisor_count,
+            reciprocal_digit(normalized_divisor_digits[divisor_count - 1]));
+
+        if (remainder != nullptr)
+        {
+            shift_right(remainder, window_digits, divisor_count, shift, 0);
+        }
+    }
+
+    // from this many digits of the divisor on, division through its Newton reciprocal and a subquadratic
+    // multiplication beats algorithm D
+    constexpr size_t Newton_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 200
+        : 150;
+
+    // the reciprocal of count / 2 + 1 top digits must be a shorter one for the recursion to end
+    static_assert(Newton_threshold >= 3, "the Newton threshold is too low");
+
+    digits_multiplier choose_multiplier(
+        big_integer::multiplication_rule multiplication_rule) noexcept
+    {
+        switch (multiplication_rule)
+        {
+            case big_integer::multiplication_rule::Karatsuba:
+                return multiply_Karatsuba;
+            case big_integer::multiplication_rule::Toom3:
+                return multiply_Toom3;
+            case big_integer::multiplication_rule::Toom4:
+                return multiply_Toom4;
+            case big_integer::multiplication_rule::SchonhageStrassen:
+                return multiply_NTT;
+            case big_integer::multiplication_rule::automatic:
+                return multiply_automatic;
+            case big_integer::multiplication_rule::parallel:
+                return multiply_parallel;
+            default:
+                return multiply_schoolbook;
+        }
+    }
+
+    /*
+     * reciprocal = floor((B^(2 * count) - 1) / divisor) for a normalized divisor of count digits; it takes count + 1
+     * digits, the top one being 1.
+     *
+     * The reciprocal of the divisor's top count / 2 + 1 digits, lowered to stay below the true value, is refined
+     * by one Newton step x + x * (B^(2 * count) - divisor * x) / B^(2 * count), which squares its relative error,
+     * and the few missing units are added by comparing the remainder with the divisor.
+     */
+    void compute_reciprocal(
+        digit *reciprocal,
+        digit const *divisor,
+        size_t count,
+        digits_multiplier multiplier)
+    {
+        if (count < Newton_threshold)
+        {
+            digits_buffer window(2 * count + 1);
+            std::fill(window.get(), window.get() + 2 * count, max_digit);
+            window.get()[2 * count] = 0;
+            divide_normalized(reciprocal, window.get(), 2 * count + 1, divisor, count, reciprocal_digit(divisor[count - 1]));
+
+            return;
+        }
+
+        auto const high_count = count / 2 + 1;
+        auto const low_count = count - high_count;
+        digit const four = 4;
+        digit const one = 1;
+
+        // x = (reciprocal of the top digits - 4) * B^low_count, 4 * B^low_count making up for the dropped digits
+        digits_buffer approximation(high_count + 1);
+        auto *approximation_digits = approximation.get();
+        compute_reciprocal(approximation_digits, divisor + low_count, high_count, multiplier);
+        subtract_digits(approximation_digits, approximation_digits, high_count + 1, &four, 1);
+
+        // (B^(2 * count) - divisor * x) / B^low_count = B^(count + high_count) - divisor * approximation
+        digits_buffer error(count + high_count + 1);
+        auto *error_digits = error.get();
+        multiply_padded(multiplier, error_digits, divisor, count, approximation_digits, high_count + 1);
+        negate_digits(error_digits, count + high_count);
+        auto const error_count = significant_count(error_digits, count + high_count);
+
+        // x * error / B^(2 * count) = approximation * error / B^(2 * high_count)
+        digits_buffer correction(high_count + 1 + error_count);
+        auto *correction_digits = correction.get();
+        multiply_padded(multiplier, correction_digits, approximation_digits, high_count + 1, error_digits, error_count);
+
+        std::fill(reciprocal, reciprocal + low_count, 0);
+        std::copy(approximation_digits, approximation_digits + high_count + 1, reciprocal + low_count);
+        if (high_count + 1 + error_count > 2 * high_count)
+        {
+            auto const shifted_count = std::min(high_count + 1 + error_count - 2 * high_count, count + 1);
+            add_digits(reciprocal, reciprocal, count + 1, correction_digits + 2 * high_count, shifted_count);
+        }
+
+        // remainder = B^(2 * count) - divisor * reciprocal, which is not negative
+        digits_buffer remainder(2 * count + 1);
+        auto *remainder_digits = remainder.get();
+        multiply_padded(multiplier, remainder_digits, divisor, count, reciprocal, count + 1);
+        if (remainder_digits[2 * count] != 0)
+        {
+            // divisor * reciprocal = B^(2 * count) for a power of two
+            subtract_digits(reciprocal, reciprocal, count + 1, &one, 1);
+            return;
+        }
+
+        negate_digits(remainder_digits, 2 * count);
+        while (compare_magnitudes(remainder_digits, 2 * count, divisor, count) > 0)
+        {
+            subtract_digits(remainder_digits, remainder_digits, 2 * count, divisor, count);
+            add_digits(reciprocal, reciprocal, count + 1, &one, 1);
+        }
+    }
+
+    /*
+     * divide_normalized by a divisor of count digits through its compute_reciprocal: the dividend is taken count
+     * digits at a time, and each block's quotient, estimated from the top count + 1 digits of the partial dividend
+     * times the reciprocal, falls short by at most 3, which subtractions of the divisor make up.
+     */
+    void divide_by_reciprocal(
+        digit *quotient,
+        digit *window,
+        size_t window_count,
+        digit const *divisor,
+        size_t count,
+        digit const *reciprocal,
+        digits_multiplier multiplier)
+    {
+        digit const one = 1;
+
+        digits_buffer estimate_product(2 * count + 2);
+        digits_buffer block_quotient(count + 1);
+        digits_buffer subtrahend(2 * count);
+        auto *estimate_product_digits = estimate_product.get();
+        auto *block_quotient_digits = block_quotient.get();
+        auto *subtrahend_digits = subtrahend.get();
+
+        for (auto position = window_count - count; position != 0;)
+        {
+            auto const block_count = std::min(count, position);
+            position -= block_count;
+            auto *partial = window + position;
+            auto const partial_count = count + block_count;
+
+            multiply_padded(multiplier, estimate_product_digits, partial + count - 1, block_count + 1, reciprocal, count + 1);
+            std::copy(estimate_product_digits + count + 1, estimate_product_digits + count + 1 + block_count, block_quotient_digits);
+
+            multiply_padded(multiplier, subtrahend_digits, block_quotient_digits, block_count, divisor, count);
+            subtract_digits(partial, partial, partial_count, subtrahend_digits, partial_count);
+            while (compare_magnitudes(partial, partial_count, divisor, count) >= 0)
+            {
+                subtract_digits(partial, partial, partial_count, divisor, count);
+                add_digits(block_quotient_digits, block_quotient_digits, block_count, &one, 1);
+            }
+
+            if (quotient != nullptr)
+            {
+                std::copy(block_quotient_digits, block_quotient_digits + block_count, quotient + position);
+            }
+        }
+    }
+
+    // below this many digits of a block's divisor, algorithm D divides the block
+    constexpr size_t Burnikel_Ziegler_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 60
+        : 40;
+
+    void divide_three_halves_by_two(
+        digit *quotient,
+        digit *window,
+        digit const *divisor,
+        size_t half_count,
+        digit reciprocal,
+        digits_multiplier multiplier,
+        digit *scratch);
+
+    /*
+     * window[0..2 * count) / divisor for a normalized divisor of count digits and the top count digits of the window
+     * less than the divisor: quotient receives count digits, and the window is left with the remainder in its low count
+     * digits and zeros above. reciprocal is reciprocal_digit of the divisor's top digit; scratch holds 2 * count digits.
+     */
+    void divide_two_by_one(
+        digit *quotient,
+        digit *window,
+        digit const *divisor,
+        size_t count,
+        digit reciprocal,
+        digits_multiplier multiplier,
+        digit *scratch)
+    {
+        if (count % 2 == 1 || count < Burnikel_Ziegler_threshold)
+        {
+            divide_normalized(quotient, window, 2 * count, divisor, count, reciprocal);
+            return;
+        }
+
+        // the top three halves, then the remainder with the last half
+        auto const half_count = count / 2;
+        divide_three_halves_by_two(quotient + half_count, window + half_count, divisor, half_count, reciprocal, multiplier, scratch);
+        divide_three_halves_by_two(quotient, window, divisor, half_count, reciprocal, multiplier, scratch);
+    }
+
+    /*
+     * window[0..3 * half_count) / divisor for a normalized divisor of 2 * half_count digits and the top 2 * half_count
+     * digits of the window less than the divisor: quotient receives half_count digits, and the window is left with
+     * the remainder in its low 2 * half_count digits and zeros above.
+     *
+     * The quotient is estimated by dividing the top two halves by the divisor's top half, which overestimates it
+     * by at most 2; the product of the estimate and the divisor's low half makes the remainder exact.
+     */
+    void divide_three_halves_by_two(
+        digit *quotient,
+        digit *window,
+        digit const *divisor,
+        size_t half_count,
+        digit reciprocal,
+        digits_multiplier multiplier,
+        digit *scratch)
+    {
+        auto const *divisor_high = divisor + half_count;
+        digit const one = 1;
+
+        if (compare_magnitudes(window + 2 * half_count, half_count, divisor_high, half_count) < 0)
+        {
+            divide_two_by_one(quotient, window + half_count, divisor_high, half_count, reciprocal, multiplier, scratch);
+        }
+        else
+        {
+            // the top half equals the divisor's, the estimate is B^half_count - 1, and the top two halves
+            // less the estimate times the divisor's top half are the second half plus the divisor's top half
+            std::fill(quotient, quotient + half_count, max_digit);
+            std::fill(window + 2 * half_count, window + 3 * half_count, 0);
+            add_digits(window + half_count, window + half_count, 2 * half_count, divisor_high, half_count);
+        }
+
+        multiply_padded(multiplier, scratch, quotient, half_count, divisor, half_count);
+        auto is_negative = subtract_digits(window, window, 3 * half_count, scratch, 2 * half_count) != 0;
+        while (is_negative)
+        {
+            is_negative = add_digits(window, window, 3 * half_count, divisor, 2 * half_count) == 0;
+            subtract_digits(quotient, quotient, half_count, &one, 1);
+        }
+    }
+
+    /*
+     * Burnikel and Ziegler's recursive division, with the contract of divide_magnitudes. The divisor is padded with
+     * low zero digits and normalized to a block of threshold-sized pieces times a power of two; the dividend, shifted
+     * alike, is divided a block at a time, two blocks by one.
+     */
+    void divide_recursively(
+        digit *quotient,
+        digit *remainder,
+        digit const *dividend,
+        size_t dividend_count,
+        digit const *divisor,
+        size_t divisor_count,
+        digits_multiplier multiplier)
+    {
+        size_t pieces_count = 1;
+        while (divisor_count > pieces_count * Burnikel_Ziegler_threshold)
+        {
+            pieces_count *= 2;
+        }
+        auto const block_count = (divisor_count + pieces_count - 1) / pieces_count * pieces_count;
+        auto const padding_count = block_count - divisor_count;
+        auto const shift = leading_zeros(divisor[divisor_count - 1]);
+
+        digits_buffer normalized_divisor(block_count);
+        auto *normalized_divisor_digits = normalized_divisor.get();
+        std::fill(normalized_divisor_digits, normalized_divisor_digits + padding_count, 0);
+        shift_left(normalized_divisor_digits + padding_count, divisor, divisor_count, shift);
+
+        // one more digit for the bits shifted out, and zeros up to whole blocks
+        auto const window_count = (dividend_count + padding_count + 1 + block_count - 1) / block_count * block_count;
+        digits_buffer window(window_count);
+        auto *window_digits = window.get();
+        std::fill(window_digits, window_digits + padding_count, 0);
+        window_digits[padding_count + dividend_count] = shift_left(window_digits + padding_count, dividend, dividend_count, shift);
+        std::fill(window_digits + padding_count + dividend_count + 1, window_digits + window_count, 0);
+
+        auto const reciprocal = reciprocal_digit(normalized_divisor_digits[block_count - 1]);
+        auto const quotient_count = window_count - block_count;
+        digits_buffer block_quotients(quotient_count);
+        digits_buffer scratch(2 * block_count);
+
+        for (auto position = quotient_count; position != 0;)
+        {
+            position -= block_count;
+            divide_two_by_one(block_quotients.get() + position, window_digits + position, normalized_divisor_digits, block_count,
+                reciprocal, multiplier, scratch.get());
+        }
+
+        if (quotient != nullptr)
+        {
+            std::copy(block_quotients.get(), block_quotients.get() + dividend_count - divisor_count + 1, quotient);
+        }
+        if (remainder != nullptr)
+        {
+            shift_right(remainder, window_digits + padding_count, divisor_count, shift, 0);
+        }
+    }
+
+    /*
+     * -1 / value mod B for an odd value. An odd value is its own inverse modulo 8, and each step of Newton's
+     * iteration x = x (2 - value x) doubles the correct low bits.
+     */
+    digit negated_inverse_digit(
+        digit value) noexcept
+    {
+        auto inverse = value;
+        for (size_t bits = 3; bits < digit_bits; bits *= 2)
+        {
+            inverse *= 2 - value * inverse;
+        }
+
+        return 0 - inverse;
+    }
+
+    /*
+     * Products modulo an odd modulus of count digits, on residues in Montgomery form x R mod modulus for R = B^count.
+     * The caller allocates the work digits once, so that no product allocates: products stop at Karatsuba's, as the
+     * faster multiplications take their scratch from the pool.
+     */
+    class Montgomery_reduction final
+    {
+
+    private:
+
+        digit const *_modulus;
+
+        size_t _count;
+
+        digit _inverse;
+
+    public:
+
+        Montgomery_reduction(
+            digit const *modulus,
+            size_t count,
+            digit inverse) noexcept:
+                _modulus(modulus),
+                _count(count),
+                _inverse(inverse)
+        {
+
+        }
+
+    public:
+
+        [[nodiscard]] size_t work_count() const noexcept
+        {
+            return 2 * _count + Karatsuba_scratch_count(_count);
+        }
+
+        /*
+         * result = first * second / R mod modulus for residues of count digits; result may alias either operand.
+         */
+        void multiply(
+            digit *result,
+            digit const *first,
+            digit const *second,
+            digit *work) const
+        {
+            multiply_Karatsuba(work, first, _count, second, _count, work + 2 * _count);
+            reduce(result, work);
+        }
+
+    private:
+
+        /*
+         * Montgomery's REDC: result = product / R mod modulus for a product below modulus * R in 2 * count digits,
+         * which are overwritten.
+         */
+        void reduce(
+            digit *result,
+            digit *product) const noexcept
+        {
+            // the carry into digit i + count of the rows so far
+            digit carry = 0;
+            for (size_t i = 0; i < _count; ++i)
+            {
+                // the multiple of the modulus that zeroes digit i
+                auto const sum = static_cast<double_digit>(product[i + _count]) + carry
+                    + add_multiplied(product + i, _modulus, _count, product[i] * _inverse);
+                product[i + _count] = static_cast<digit>(sum);
+                carry = static_cast<digit>(sum >> digit_bits);
+            }
+
+            // the quotient by R is below 2 * modulus; a carry out is cancelled by the borrow
+            if (carry != 0 || compare_magnitudes(product + _count, _count, _modulus, _count) >= 0)
+            {
+                subtract_digits(product + _count, product + _count, _count, _modulus, _count);
+            }
+            std::copy(product + _count, product + 2 * _count, result);
+        }
+
+    };
+
+    /*
+     * Products modulo any modulus of count digits, with Barrett's reduction by the precomputed reciprocal
+     * floor(B^(2 count) / modulus) of count + 2 digits. Work digits are allocated by the caller, as in
+     * Montgomery_reduction.
+     */
+    class Barrett_reduction final
+    {
+
+    private:
+
+        digit const *_modulus;
+
+        size_t _count;
+
+        digit const *_reciprocal;
+
+    public:
+
+        Barrett_reduction(
+            digit const *modulus,
+            size_t count,
+            digit const *reciprocal) noexcept:
+                _modulus(modulus),
+                _count(count),
+                _reciprocal(reciprocal)
+        {
+
+        }
+
+    public:
+
+        [[nodiscard]] size_t work_count() const noexcept
+        {
+            return 2 * _count + (2 * _count + 3) + (2 * _count + 1) + Karatsuba_scratch_count(_count + 2);
+        }
+
+        /*
+         * result = first * second mod modulus for residues of count digits; result may alias either operand.
+         */
+        void multiply(
+            digit *result,
+            digit const *first,
+            digit const *second,
+            digit *work) const
+        {
+            auto *product = work;
+            auto *estimate = product + 2 * _count;
+            auto *estimate_product = estimate + 2 * _count + 3;
+            auto *scratch = estimate_product + 2 * _count + 1;
+
+            multiply_Karatsuba(product, first, _count, second, _count, scratch);
+
+            // the quotient estimate floor(floor(product / B^(count - 1)) * reciprocal / B^(count + 1)) is short
+            // of the quotient by at most 2
+            multiply_Karatsuba(estimate, _reciprocal, _count + 2, product + _count - 1, _count + 1, scratch);
+            multiply_Karatsuba(estimate_product, estimate + _count + 1, _count + 1, _modulus, _count, scratch);
+
+            // the remainder estimate is below 3 * modulus < B^(count + 1), so the low count + 1 digits hold it
+            subtract_digits(product, product, _count + 1, estimate_product, _count + 1);
+            while (product[_count] != 0 || compare_magnitudes(product, _count, _modulus, _count) >= 0)
+            {
+                product[_count] -= subtract_digits(product, product, _count, _modulus, _count);
+            }
+            std::copy(product, product + _count, result);
+        }
+
+    };
+
+    /*
+     * Exponent bits per window of sliding window exponentiation, from which the table of odd powers pays off.
+     */
+    size_t window_bits(
+        size_t exponent_bits) noexcept
+    {
+        return exponent_bits > 671
+            ? 6
+            : exponent_bits > 239
+                ? 5
+                : exponent_bits > 79
+                    ? 4
+                    : exponent_bits > 23
+                        ? 3
+                        : 1;
+    }
+
+    /*
+     * result = base^exponent with the products of the reduction on residues of count digits; one is the residue of 1,
+     * work holds reduction.work_count() digits and result does not alias base.
+     *
+     * Left to right sliding windows: each window runs from a set bit down to a set bit at most window_bits below,
+     * and takes one product by an odd power base^1, base^3, ..., base^(2^window_bits - 1) from a table computed
+     * before the loop, which allocates nothing.
+     */
+    template<
+        typename reduction>
+    void power_by_windows(
+        digit *result,
+        digit const *base,
+        digit const *one,
+        digit const *exponent,
+        size_t exponent_count,
+        size_t count,
+        reduction const &modular,
+        digit *work)
+    {
+        if (exponent_count == 0)
+        {
+            std::copy(one, one + count, result);
+            return;
+        }
+
+        auto const bit_at = [exponent](size_t position)
+        {
+            return (exponent[position / digit_bits] >> position % digit_bits) & 1;
+        };
+
+        auto const bits_count = exponent_count * digit_bits - leading_zeros(exponent[exponent_count - 1]);
+        auto const window = window_bits(bits_count);
+
+        digits_buffer table(count << (window - 1));
+        auto *table_digits = table.get();
+        std::copy(base, base + count, table_digits);
+        if (window > 1)
+        {
+            modular.multiply(result, base, base, work);
+            for (size_t i = 1; i < static_cast<size_t>(1) << (window - 1); ++i)
+            {
+                modular.multiply(table_digits + i * count, table_digits + (i - 1) * count, result, work);
+            }
+        }
+
+        auto is_started = false;
+        for (auto position = bits_count; position != 0;)
+        {
+            if (bit_at(position - 1) == 0)
+            {
+                modular.multiply(result, result, result, work);
+                --position;
+                continue;
+            }
+
+            auto end = position > window
+                ? position - window
+                : 0;
+            while (bit_at(end) == 0)
+            {
+                ++end;
+            }
+
+            size_t odd_power = 0;
+            for (auto i = position; i-- > end;)
+            {
+                odd_power = odd_power << 1 | bit_at(i);
+            }
+            auto const *power = table_digits + (odd_power >> 1) * count;
+
+            if (is_started)
+            {
+                for (auto i = end; i < position; ++i)
+                {
+                    modular.multiply(result, result, result, work);
+                }
+                modular.multiply(result, result, power, work);
+            }
+            else
+            {
+                std::copy(power, power + count, result);
+                is_started = true;
+            }
+            position = end;
+        }
+    }
+
+    size_t digit_value(
+        char symbol) noexcept
+    {
+        if (symbol >= '0' && symbol <= '9')
+        {
+            return static_cast<size_t>(symbol - '0');
+        }
+        if (symbol >= 'a' && symbol <= 'z')
+        {
+            return static_cast<size_t>(symbol - 'a' + 10);
+        }
+        if (symbol >= 'A' && symbol <= 'Z')
+        {
+            return static_cast<size_t>(symbol - 'A' + 10);
+        }
+
+        return std::numeric_limits<size_t>::max();
+    }
+
+    char symbol_of(
+        digit value,
+        bool is_uppercase) noexcept
+    {
+        return static_cast<char>(value < 10
+            ? '0' + value
+            : (is_uppercase
+                ? 'A'
+                : 'a') + value - 10);
+    }
+
+    /*
+     * log2(base) for a power of two base, 0 otherwise.
+     */
+    size_t bits_per_symbol(
+        size_t base) noexcept
+    {
+        return (base & (base - 1)) == 0
+            ? static_cast<size_t>(__builtin_ctzll(base))
+            : 0;
+    }
+
+    // up to this many digits or chunks, values are converted a chunk at a time
+    constexpr size_t radix_conversion_threshold = sizeof(digit) == sizeof(unsigned int)
+        ? 120
+        : 80;
+
+    /*
+     * chunk_base^(2^level) for levels up to levels_count - 1, squared with the automatic multiplication.
+     */
+    std::vector<std::vector<digit>> radix_powers(
+        digit chunk_base,
+        size_t levels_count)
+    {
+        std::vector<std::vector<digit>> powers(levels_count);
+        for (size_t level = 0; level < levels_count; ++level)
+        {
+            auto &power = powers[level];
+            if (level == 0)
+            {
+                power.assign(1, chunk_base);
+                continue;
+            }
+
+            auto const &previous = powers[level - 1];
+            power.resize(2 * previous.size());
+            multiply_padded(multiply_automatic, power.data(), previous.data(), previous.size(), previous.data(), previous.size());
+            power.resize(significant_count(power.data(), power.size()));
+        }
+
+        return powers;
+    }
+
+    /*
+     * result[0..count) = the value of count chunks in base chunk_base, the most significant first, which is less than
+     * B^count: the high chunks times a power of chunk_base plus the low 2^level ones, recursively.
+     */
+    void chunks_to_digits(
+        digit *result,
+        digit const *chunks,
+        size_t count,
+        digit chunk_base,
+        std::vector<std::vector<digit>> const &powers)
+    {
+        if (count <= radix_conversion_threshold)
+        {
+            size_t result_count = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                result[result_count] = multiply_by_digit(result, result, result_count, chunk_base);
+                add_digits(result, result, result_count + 1, chunks + i, 1);
+                result_count = significant_count(result, result_count + 1);
+            }
+            std::fill(result + result_count, result + count, 0);
+
+            return;
+        }
+
+        size_t level = 0;
+        while ((static_cast<size_t>(2) << level) < count)
+        {
+            ++level;
+        }
+        auto const low_count = static_cast<size_t>(1) << level;
+        auto const high_count = count - low_count;
+        auto const &power = powers[level];
+
+        digits_buffer high(high_count);
+        chunks_to_digits(high.get(), chunks, high_count, chunk_base, powers);
+        chunks_to_digits(result, chunks + high_count, low_count, chunk_base, powers);
+        std::fill(result + low_count, result + count, 0);
+
+        digits_buffer product(high_count + power.size());
+        multiply_padded(multiply_automatic, product.get(), high.get(), high_count, power.data(), power.size());
+        add_digits(result, result, count, product.get(), significant_count(product.get(), high_count + power.size()));
+    }
+
+    /*
+     * chunks[0..2^level) = the chunks of value < chunk_base^(2^level), the most significant first: the quotient and
+     * the remainder by chunk_base^(2^(level - 1)), recursively. value is destroyed.
+     */
+    void digits_to_chunks(
+        digit *chunks,
+        size_t level,
+        digit *value,
+        size_t value_count,
+        digit chunk_base,
+        std::vector<std::vector<digit>> const &powers)
+    {
+        auto const chunks_count = static_cast<size_t>(1) << level;
+        value_count = significant_count(value, value_count);
+
+        if (value_count <= radix_conversion_threshold)
+        {
+            for (size_t i = chunks_count; i-- > 0;)
+            {
+                chunks[i] = divide_by_digit(value, value, value_count, chunk_base);
+                value_count = significant_count(value, value_count);
+            }
+
+            return;
+        }
+
+        auto const half_count = chunks_count / 2;
+        auto const &power = powers[level - 1];
+        auto const divisor_count = power.size();
+        if (value_count < divisor_count)
+        {
+            std::fill(chunks, chunks + half_count, 0);
+            digits_to_chunks(chunks + half_count, level - 1, value, value_count, chunk_base, powers);
+
+            return;
+        }
+
+        // recursive division needs no precomputation; Newton reciprocals of the powers measured slower even when reused
+        auto const quotient_count = value_count - divisor_count + 1;
+        digits_buffer quotient(quotient_count);
+        digits_buffer remainder(divisor_count);
+        divide_recursively(quotient.get(), remainder.get(), value, value_count, power.data(), divisor_count, multiply_automatic);
+
+        digits_to_chunks(chunks, level - 1, quotient.get(), quotient_count, chunk_base, powers);
+        digits_to_chunks(chunks + half_count, level - 1, remainder.get(), divisor_count, chunk_base, powers);
+    }
+
+    /*
+     * The symbols of a nonzero magnitude in base 2 to 36: bits straight from the digits for a power of two base,
+     * chunks of a digit's worth of symbols otherwise.
+     */
+    std::string magnitude_to_string(
+        digit const *magnitude,
+        size_t count,
+        size_t base,
+        bool is_uppercase)
+    {
+        std::string result;
+
+        auto const bits = bits_per_symbol(base);
+        if (bits != 0)
+        {
+            auto const total_bits = (count - 1) * digit_bits + (digit_bits - leading_zeros(magnitude[count - 1]));
+            auto const symbols_count = (total_bits + bits - 1) / bits;
+            result.resize(symbols_count);
+
+            for (size_t i = 0; i < symbols_count; ++i)
+            {
+                // a symbol may straddle two digits when bits does not divide digit_bits
+                auto const position = i * bits;
+                auto const index = position / digit_bits;
+                auto const offset = position % digit_bits;
+                auto value = magnitude[index] >> offset;
+                if (offset + bits > digit_bits && index + 1 < count)
+                {
+                    value |= magnitude[index + 1] << (digit_bits - offset);
+                }
+                result[symbols_count - 1 - i] = symbol_of(value & static_cast<digit>(base - 1), is_uppercase);
+            }
+
+            return result;
+        }
+
+        size_t chunk_length = 1;
+        double_digit chunk_base = base;
+        while (chunk_base * base <= max_digit)
+        {
+            chunk_base *= base;
+            ++chunk_length;
+        }
+
+        // 2^level chunks hold the value once chunk_base^(2^level) >= 2^(chunk_bits * 2^level) >= B^count
+        auto const chunk_bits = digit_bits - 1 - leading_zeros(static_cast<digit>(chunk_base));
+        size_t level = 0;
+        while ((chunk_bits << level) < count * digit_bits)
+        {
+            ++level;
+        }
+        auto const chunks_count = static_cast<size_t>(1) << level;
+
+        digits_buffer value(count);
+        std::copy(magnitude, magnitude + count, value.get());
+        digits_buffer chunks(chunks_count);
+        std::vector<std::vector<digit>> powers;
+        if (count > radix_conversion_threshold)
+        {
+            powers = radix_powers(static_cast<digit>(chunk_base), level);
+        }
+        digits_to_chunks(chunks.get(), level, value.get(), count, static_cast<digit>(chunk_base), powers);
+
+        auto const *chunks_digits = chunks.get();
+        size_t first = 0;
+        while (chunks_digits[first] == 0)
+        {
+            ++first;
+        }
+
+        result.reserve((chunks_count - first) * chunk_length);
+        for (auto i = first; i < chunks_count; ++i)
+        {
+            auto chunk = chunks_digits[i];
+            char symbols[std::numeric_limits<digit>::digits];
+            for (size_t j = chunk_length; j-- > 0;)
+            {
+                symbols[j] = symbol_of(chunk % base, is_uppercase);
+                chunk /= base;
+            }
+
+            // the leading chunk has no leading zeros
+            size_t skipped = 0;
+            if (i == first)
+            {
+                while (symbols[skipped] == '0')
+                {
+                    ++skipped;
+                }
+            }
+            result.append(symbols + skipped, symbols + chunk_length);
+        }
+
+        return result;
+    }
+
+}
+
+big_integer &big_integer::trivial_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return multiply_magnitudes(first_multiplier, second_multiplier, multiply_schoolbook);
+}
+
+big_integer &big_integer::Karatsuba_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return multiply_magnitudes(first_multiplier, second_multiplier, multiply_Karatsuba);
+}
+
+big_integer &big_integer::Toom3_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return multiply_magnitudes(first_multiplier, second_multiplier, multiply_Toom3);
+}
+
+big_integer &big_integer::Toom4_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return multiply_magnitudes(first_multiplier, second_multiplier, multiply_Toom4);
+}
+
+big_integer &big_integer::Schonhage_Strassen_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return multiply_magnitudes(first_multiplier, second_multiplier, multiply_NTT);
+}
+
+big_integer &big_integer::automatic_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return multiply_magnitudes(first_multiplier, second_multiplier, multiply_automatic);
+}
+
+big_integer &big_integer::parallel_multiplication::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier) const
+{
+    return multiply_magnitudes(first_multiplier, second_multiplier, multiply_parallel);
+}
+
+big_integer &big_integer::trivial_division::divide(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule) const
+{
+    digits_buffer dividend_magnitude(dividend.get_digits_count());
+    digits_buffer divisor_magnitude(divisor.get_digits_count());
+    auto const dividend_count = dividend.load_magnitude(dividend_magnitude.get());
+    auto const divisor_count = divisor.load_magnitude(divisor_magnitude.get());
+
+    if (dividend_count < divisor_count)
+    {
+        digit const zero = 0;
+        return dividend.assign_digits(&zero, 1);
+    }
+
+    auto const quotient_count = dividend_count - divisor_count + 1;
+    digits_buffer quotient(quotient_count);
+    divide_magnitudes(quotient.get(), nullptr, dividend_magnitude.get(), dividend_count, divisor_magnitude.get(), divisor_count);
+
+    return dividend.assign_magnitude(quotient.get(), quotient_count, dividend.is_negative() != divisor.is_negative());
+}
+
+big_integer &big_integer::trivial_division::modulo(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule) const
+{
+    digits_buffer dividend_magnitude(dividend.get_digits_count());
+    digits_buffer divisor_magnitude(divisor.get_digits_count());
+    auto const dividend_count = dividend.load_magnitude(dividend_magnitude.get());
+    auto const divisor_count = divisor.load_magnitude(divisor_magnitude.get());
+
+    if (dividend_count < divisor_count)
+    {
+        return dividend;
+    }
+
+    // the remainder takes the dividend's sign, as the quotient is truncated towards zero
+    digits_buffer remainder(divisor_count);
+    divide_magnitudes(nullptr, remainder.get(), dividend_magnitude.get(), dividend_count, divisor_magnitude.get(), divisor_count);
+
+    return dividend.assign_magnitude(remainder.get(), divisor_count, dividend.is_negative());
+}
+
+big_integer &big_integer::trivial_division::divmod(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer &remainder,
+    big_integer::multiplication_rule) const
+{
+    digits_buffer dividend_magnitude(dividend.get_digits_count());
+    digits_buffer divisor_magnitude(divisor.get_digits_count());
+    auto const dividend_count = dividend.load_magnitude(dividend_magnitude.get());
+    auto const divisor_count = divisor.load_magnitude(divisor_magnitude.get());
+    auto const is_negative = dividend.is_negative();
+    auto const is_quotient_negative = is_negative != divisor.is_negative();
+
+    if (dividend_count < divisor_count)
+    {
+        digit const zero = 0;
+        remainder.assign_magnitude(dividend_magnitude.get(), dividend_count, is_negative);
+        return dividend.assign_digits(&zero, 1);
+    }
+
+    auto const quotient_count = dividend_count - divisor_count + 1;
+    digits_buffer quotient(quotient_count);
+    digits_buffer remainder_magnitude(divisor_count);
+    divide_magnitudes(quotient.get(), remainder_magnitude.get(), dividend_magnitude.get(), dividend_count, divisor_magnitude.get(),
+        divisor_count);
+
+    remainder.assign_magnitude(remainder_magnitude.get(), divisor_count, is_negative);
+    return dividend.assign_magnitude(quotient.get(), quotient_count, is_quotient_negative);
+}
+
+big_integer::precomputed_divisor::precomputed_divisor(
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule):
+        _divisor(divisor),
+        _shift(0),
+        _top_reciprocal(0),
+        _multiplication_rule(multiplication_rule)
+{
+    if (divisor.is_zero())
+    {
+        throw std::logic_error("division by zero");
+    }
+
+    _normalized_digits.resize(divisor.get_digits_count());
+    auto const count = divisor.load_magnitude(_normalized_digits.data());
+    _normalized_digits.resize(count);
+
+    _shift = leading_zeros(_normalized_digits[count - 1]);
+    shift_left(_normalized_digits.data(), _normalized_digits.data(), count, _shift);
+    _top_reciprocal = reciprocal_digit(_normalized_digits[count - 1]);
+
+    // with schoolbook multiplication, the products cost more than algorithm D's steps
+    if (multiplication_rule != big_integer::multiplication_rule::trivial && count >= Newton_threshold)
+    {
+        _reciprocal.resize(count + 1);
+        compute_reciprocal(_reciprocal.data(), _normalized_digits.data(), count, choose_multiplier(multiplication_rule));
+    }
+}
+
+void big_integer::precomputed_divisor::divide(
+    big_integer const &dividend,
+    big_integer *quotient,
+    big_integer *remainder) const
+{
+    auto const divisor_count = _normalized_digits.size();
+    auto const is_negative = dividend.is_negative();
+    auto const is_quotient_negative = is_negative != _divisor.is_negative();
+
+    digits_buffer window(dividend.get_digits_count() + 1);
+    auto *window_digits = window.get();
+    auto const dividend_count = dividend.load_magnitude(window_digits);
+
+    if (dividend_count < divisor_count)
+    {
+        if (remainder != nullptr)
+        {
+            remainder->assign_magnitude(window_digits, dividend_count, is_negative);
+        }
+        if (quotient != nullptr)
+        {
+            digit const zero = 0;
+            quotient->assign_digits(&zero, 1);
+        }
+
+        return;
+    }
+
+    auto const window_count = dividend_count + 1;
+    window_digits[dividend_count] = shift_left(window_digits, window_digits, dividend_count, _shift);
+
+    auto const quotient_count = window_count - divisor_count;
+    digits_buffer quotient_digits(quotient_count);
+    auto *quotient_destination = quotient == nullptr
+        ? nullptr
+        : quotient_digits.get();
+
+    if (_reciprocal.empty())
+    {
+        divide_normalized(quotient_destination, window_digits, window_count, _normalized_digits.data(), divisor_count, _top_reciprocal);
+    }
+    else
+    {
+        divide_by_reciprocal(quotient_destination, window_digits, window_count, _normalized_digits.data(), divisor_count,
+            _reciprocal.data(), choose_multiplier(_multiplication_rule));
+    }
+
+    // both results are in buffers, so the dividend may be either of them
+    if (remainder != nullptr)
+    {
+        shift_right(window_digits, window_digits, divisor_count, _shift, 0);
+        remainder->assign_magnitude(window_digits, divisor_count, is_negative);
+    }
+    if (quotient != nullptr)
+    {
+        quotient->assign_magnitude(quotient_digits.get(), quotient_count, is_quotient_negative);
+    }
+}
+
+big_integer &big_integer::Newton_division::divide(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    precomputed_divisor(divisor, multiplication_rule).divide(dividend, &dividend, nullptr);
+
+    return dividend;
+}
+
+big_integer &big_integer::Newton_division::modulo(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    precomputed_divisor(divisor, multiplication_rule).divide(dividend, nullptr, &dividend);
+
+    return dividend;
+}
+
+big_integer &big_integer::Newton_division::divmod(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer &remainder,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    precomputed_divisor(divisor, multiplication_rule).divide(dividend, &dividend, &remainder);
+
+    return dividend;
+}
+
+big_integer &big_integer::Burnikel_Ziegler_division::divide(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    digits_buffer dividend_magnitude(dividend.get_digits_count());
+    digits_buffer divisor_magnitude(divisor.get_digits_count());
+    auto const dividend_count = dividend.load_magnitude(dividend_magnitude.get());
+    auto const divisor_count = divisor.load_magnitude(divisor_magnitude.get());
+
+    if (dividend_count < divisor_count)
+    {
+        digit const zero = 0;
+        return dividend.assign_digits(&zero, 1);
+    }
+
+    auto const quotient_count = dividend_count - divisor_count + 1;
+    digits_buffer quotient(quotient_count);
+    divide_recursively(quotient.get(), nullptr, dividend_magnitude.get(), dividend_count, divisor_magnitude.get(), divisor_count,
+        choose_multiplier(multiplication_rule));
+
+    return dividend.assign_magnitude(quotient.get(), quotient_count, dividend.is_negative() != divisor.is_negative());
+}
+
+big_integer &big_integer::Burnikel_Ziegler_division::modulo(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    digits_buffer dividend_magnitude(dividend.get_digits_count());
+    digits_buffer divisor_magnitude(divisor.get_digits_count());
+    auto const dividend_count = dividend.load_magnitude(dividend_magnitude.get());
+    auto const divisor_count = divisor.load_magnitude(divisor_magnitude.get());
+
+    if (dividend_count < divisor_count)
+    {
+        return dividend;
+    }
+
+    digits_buffer remainder(divisor_count);
+    divide_recursively(nullptr, remainder.get(), dividend_magnitude.get(), dividend_count, divisor_magnitude.get(), divisor_count,
+        choose_multiplier(multiplication_rule));
+
+    return dividend.assign_magnitude(remainder.get(), divisor_count, dividend.is_negative());
+}
+
+big_integer &big_integer::Burnikel_Ziegler_division::divmod(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer &remainder,
+    big_integer::multiplication_rule multiplication_rule) const
+{
+    digits_buffer dividend_magnitude(dividend.get_digits_count());
+    digits_buffer divisor_magnitude(divisor.get_digits_count());
+    auto const dividend_count = dividend.load_magnitude(dividend_magnitude.get());
+    auto const divisor_count = divisor.load_magnitude(divisor_magnitude.get());
+    auto const is_negative = dividend.is_negative();
+    auto const is_quotient_negative = is_negative != divisor.is_negative();
+
+    if (dividend_count < divisor_count)
+    {
+        digit const zero = 0;
+        remainder.assign_magnitude(dividend_magnitude.get(), dividend_count, is_negative);
+        return dividend.assign_digits(&zero, 1);
+    }
+
+    auto const quotient_count = dividend_count - divisor_count + 1;
+    digits_buffer quotient(quotient_count);
+    digits_buffer remainder_magnitude(divisor_count);
+    divide_recursively(quotient.get(), remainder_magnitude.get(), dividend_magnitude.get(), dividend_count, divisor_magnitude.get(),
+        divisor_count, choose_multiplier(multiplication_rule));
+
+    remainder.assign_magnitude(remainder_magnitude.get(), divisor_count, is_negative);
+    return dividend.assign_magnitude(quotient.get(), quotient_count, is_quotient_negative);
+}
+
+big_integer::big_integer(
+    int const *digits,
+    size_t digits_count,
+    allocator *allocator):
+        _oldest_digit(0),
+        _digits_count(1),
+        _other_digits(nullptr),
+        _allocator(allocator)
+{
+    if (digits == nullptr || digits_count == 0)
+    {
+        throw std::logic_error("big_integer can't be built from an empty digits array");
+    }
+
+    // the 32-bit digits are packed into limbs, the last one sign-extended
+    auto const converted_count = (digits_count + words_per_digit - 1) / words_per_digit;
+    digits_buffer converted(converted_count);
+    for (size_t i = 0; i < converted_count; ++i)
+    {
+        digit converted_digit = 0;
+        for (size_t j = words_per_digit; j-- > 0;)
+        {
+            auto const position = i * words_per_digit + j;
+            auto const word = position < digits_count
+                ? static_cast<unsigned int>(digits[position])
+                : (digits[digits_count - 1] < 0
+                    ? std::numeric_limits<unsigned int>::max()
+                    : 0u);
+            converted_digit = static_cast<digit>(static_cast<double_digit>(converted_digit) << (sizeof(unsigned int) * 8)) | word;
+        }
+        converted.get()[i] = converted_digit;
+    }
+
+    assign_digits(converted.get(), converted_count);
+}
+
+big_integer::big_integer(
+    std::vector<int> const &digits,
+    allocator *allocator):
+        big_integer(digits.data(), digits.size(), allocator)
+{
+
+}
+
+big_integer::big_integer(
+    std::string const &value_as_string,
+    size_t base,
+    allocator *allocator):
+        _oldest_digit(0),
+        _digits_count(1),
+        _other_digits(nullptr),
+        _allocator(allocator)
+{
+    if (base < 2 || base > 36)
+    {
+        throw std::logic_error("base " + std::to_string(base) + " is not in [2, 36]");
+    }
+
+    size_t position = 0;
+    bool is_negative = false;
+    if (!value_as_string.empty() && (value_as_string[0] == '-' || value_as_string[0] == '+'))
+    {
+        is_negative = value_as_string[0] == '-';
+        ++position;
+    }
+    if (position == value_as_string.size())
+    {
+        throw std::invalid_argument("\"" + value_as_string + "\" is not a number");
+    }
+
+    auto const symbols_count = value_as_string.size() - position;
+    auto const invalid_symbol = [&value_as_string, base]()
+    {
+        return std::invalid_argument("\"" + value_as_string + "\" is not a number in base " + std::to_string(base));
+    };
+
+    // a power of two base maps each symbol to bits of the value, the last symbol to the lowest ones
+    auto const bits = bits_per_symbol(base);
+    if (bits != 0)
+    {
+        auto const magnitude_count = (symbols_count * bits + digit_bits - 1) / digit_bits;
+        digits_buffer magnitude(magnitude_count);
+        auto *magnitude_digits = magnitude.get();
+        std::fill(magnitude_digits, magnitude_digits + magnitude_count, 0);
+
+        for (size_t i = 0; i < symbols_count; ++i)
+        {
+            auto const symbol_value = digit_value(value_as_string[value_as_string.size() - 1 - i]);
+            if (symbol_value >= base)
+            {
+                throw invalid_symbol();
+            }
+
+            auto const index = i * bits / digit_bits;
+            auto const offset = i * bits % digit_bits;
+            magnitude_digits[index] |= static_cast<digit>(symbol_value) << offset;
+            if (offset + bits > digit_bits)
+            {
+                magnitude_digits[index + 1] |= static_cast<digit>(symbol_value) >> (digit_bits - offset);
+            }
+        }
+
+        assign_magnitude(magnitude_digits, magnitude_count, is_negative);
+        return;
+    }
+
+    // other bases are read in chunks whose values fit in a digit, which are then combined by chunks_to_digits
+    size_t chunk_length = 1;
+    double_digit chunk_base = base;
+    while (chunk_base * base <= max_digit)
+    {
+        chunk_base *= base;
+        ++chunk_length;
+    }
+
+    auto const chunks_count = (symbols_count + chunk_length - 1) / chunk_length;
+    digits_buffer chunks(chunks_count);
+    auto *chunks_digits = chunks.get();
+
+    // the first chunk takes the symbols left over by whole chunks
+    auto length = symbols_count - (chunks_count - 1) * chunk_length;
+    for (size_t i = 0; i < chunks_count; ++i, length = chunk_length)
+    {
+        digit chunk = 0;
+        for (size_t j = 0; j < length; ++j, ++position)
+        {
+            auto const symbol_value = digit_value(value_as_string[position]);
+            if (symbol_value >= base)
+            {
+                throw invalid_symbol();
+            }
+
+            chunk = chunk * static_cast<digit>(base) + static_cast<digit>(symbol_value);
+        }
+        chunks_digits[i] = chunk;
+    }
+
+    std::vector<std::vector<digit>> powers;
+    if (chunks_count > radix_conversion_threshold)
+    {
+        // the top split is at the largest power of two below chunks_count
+        size_t level = 0;
+        while ((static_cast<size_t>(2) << level) < chunks_count)
+        {
+            ++level;
+        }
+        powers = radix_powers(static_cast<digit>(chunk_base), level + 1);
+    }
+
+    digits_buffer magnitude(chunks_count);
+    chunks_to_digits(magnitude.get(), chunks_digits, chunks_count, static_cast<digit>(chunk_base), powers);
+
+    assign_magnitude(magnitude.get(), chunks_count, is_negative);
+}
+
+big_integer::~big_integer()
+{
+    release_digits();
+}
+
+big_integer::big_integer(
+    big_integer const &other):
+        big_integer(other, other._allocator)
+{
+
+}
+
+big_integer &big_integer::operator=(
+    big_integer const &other)
+{
+    if (this != &other)
+    {
+        *this = big_integer(other);
+    }
+
+    return *this;
+}
+
+big_integer::big_integer(
+    big_integer &&other) noexcept:
+        _oldest_digit(other._oldest_digit),
+        _digits_count(other._digits_count),
+        _allocator(other._allocator)
+{
+    if (other.is_inline())
+    {
+        std::copy(other._inline_digits, other._inline_digits + inline_digits_count - 1, _inline_digits);
+    }
+    else
+    {
+        _other_digits = other._other_digits;
+    }
+
+    other._oldest_digit = 0;
+    other._digits_count = 1;
+}
+
+big_integer &big_integer::operator=(
+    big_integer &&other) noexcept
+{
+    if (this != &other)
+    {
+        release_digits();
+
+        if (other.is_inline())
+        {
+            std::copy(other._inline_digits, other._inline_digits + inline_digits_count - 1, _inline_digits);
+        }
+        else
+        {
+            _other_digits = other._other_digits;
+        }
+        _oldest_digit = other._oldest_digit;
+        _digits_count = other._digits_count;
+        _allocator = other._allocator;
+
+        other._oldest_digit = 0;
+        other._digits_count = 1;
+    }
+
+    return *this;
+}
+
+bool big_integer::operator==(
+    big_integer const &other) const
+{
+    if (_oldest_digit != other._oldest_digit || _digits_count != other._digits_count)
+    {
+        return false;
+    }
+
+    auto const *other_digits = get_other_digits();
+
+    return std::equal(other_digits, other_digits + _digits_count - 1, other.get_other_digits());
+}
+
+bool big_integer::operator!=(
+    big_integer const &other) const
+{
+    return !(*this == other);
+}
+
+bool big_integer::operator<(
+    big_integer const &other) const
+{
+#if defined(__SIZEOF_INT128__)
+    if (is_inline() && other.is_inline())
+    {
+        return get_inline_value() < other.get_inline_value();
+    }
+#endif
+
+    if (is_negative() != other.is_negative())
+    {
+        return is_negative();
+    }
+
+    // without redundant sign digits, a longer value is further from zero
+    auto const digits_count = get_digits_count();
+    auto const other_digits_count = other.get_digits_count();
+    if (digits_count != other_digits_count)
+    {
+        return is_negative()
+            ? digits_count > other_digits_count
+            : digits_count < other_digits_count;
+    }
+
+    if (_oldest_digit != other._oldest_digit)
+    {
+        return _oldest_digit < other._oldest_digit;
+    }
+
+    auto const *other_digits = get_other_digits();
+    auto const *compared_digits = other.get_other_digits();
+    for (size_t i = digits_count - 1; i-- > 0;)
+    {
+        if (other_digits[i] != compared_digits[i])
+        {
+            return other_digits[i] < compared_digits[i];
+        }
+    }
+
+    return false;
+}
+
+bool big_integer::operator>(
+    big_integer const &other) const
+{
+    return other < *this;
+}
+
+bool big_integer::operator<=(
+    big_integer const &other) const
+{
+    return !(other < *this);
+}
+
+bool big_integer::operator>=(
+    big_integer const &other) const
+{
+    return !(*this < other);
+}
+
+big_integer big_integer::operator-() const
+{
+#if defined(__SIZEOF_INT128__)
+    __int128 negated_value;
+    if (is_inline() && !__builtin_sub_overflow(static_cast<__int128>(0), get_inline_value(), &negated_value))
+    {
+        big_integer result(*this);
+        return result.assign_inline_value(negated_value);
+    }
+#endif
+
+    auto const digits_count = get_digits_count() + 1;
+    digits_buffer negated(digits_count);
+    load_digits(negated.get(), digits_count);
+    negate_digits(negated.get(), digits_count);
+
+    big_integer result(*this);
+    result.assign_digits(negated.get(), digits_count);
+
+    return result;
+}
+
+big_integer &big_integer::operator+=(
+    big_integer const &other)
+{
+#if defined(__SIZEOF_INT128__)
+    __int128 sum_value;
+    if (is_inline() && other.is_inline() && !__builtin_add_overflow(get_inline_value(), other.get_inline_value(), &sum_value))
+    {
+        return assign_inline_value(sum_value);
+    }
+#endif
+
+    // one more digit than the longer operand holds the sum without overflow
+    auto const digits_count = std::max(get_digits_count(), other.get_digits_count()) + 1;
+    digits_buffer sum(digits_count);
+    digits_buffer addend(digits_count);
+    load_digits(sum.get(), digits_count);
+    other.load_digits(addend.get(), digits_count);
+
+    add_digits(sum.get(), sum.get(), digits_count, addend.get(), digits_count);
+
+    return assign_digits(sum.get(), digits_count);
+}
+
+big_integer big_integer::operator+(
+    big_integer const &other) const
+{
+    big_integer result(*this);
+    result += other;
+
+    return result;
+}
+
+big_integer big_integer::operator+(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    big_integer result(*this, other.second);
+    result += other.first;
+
+    return result;
+}
 
-big_integer &big_integer::trivial_multiplication::multiply(
-    big_integer &first_multiplier,
-    big_integer const &second_multiplier) const
+big_integer &big_integer::operator-=(
+    big_integer const &other)
 {
-    throw not_implemented("big_integer &big_integer::trivial_multiplication::multiply(big_integer &, big_integer const &)", "your code should be here...");
+#if defined(__SIZEOF_INT128__)
+    __int128 difference_value;
+    if (is_inline() && other.is_inline() && !__builtin_sub_overflow(get_inline_value(), other.get_inline_value(), &difference_value))
+    {
+        return assign_inline_value(difference_value);
+    }
+#endif
+
+    auto const digits_count = std::max(get_digits_count(), other.get_digits_count()) + 1;
+    digits_buffer difference(digits_count);
+    digits_buffer subtrahend(digits_count);
+    load_digits(difference.get(), digits_count);
+    other.load_digits(subtrahend.get(), digits_count);
+
+    subtract_digits(difference.get(), difference.get(), digits_count, subtrahend.get(), digits_count);
+
+    return assign_digits(difference.get(), digits_count);
 }
 
-big_integer &big_integer::Karatsuba_multiplication::multiply(
-    big_integer &first_multiplier,
-    big_integer const &second_multiplier) const
+big_integer big_integer::operator-(
+    big_integer const &other) const
 {
-    throw not_implemented("big_integer &big_integer::Karatsuba_multiplication::multiply(big_integer &, big_integer const &)", "your code should be here...");
+    big_integer result(*this);
+    result -= other;
+
+    return result;
 }
 
-big_integer &big_integer::Schonhage_Strassen_multiplication::multiply(
-    big_integer &first_multiplier,
-    big_integer const &second_multiplier) const
+big_integer big_integer::operator-(
+    std::pair<big_integer, allocator *> const &other) const
 {
-    throw not_implemented("big_integer &big_integer::Schonhage_Strassen_multiplication::multiply(big_integer &, big_integer const &)", "your code should be here...");
+    big_integer result(*this, other.second);
+    result -= other.first;
+
+    return result;
 }
 
-big_integer &big_integer::trivial_division::divide(
-    big_integer &dividend,
-    big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+big_integer &big_integer::operator*=(
+    big_integer const &other)
 {
-    throw not_implemented("big_integer &big_integer::trivial_division::divide(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    return multiply(*this, other);
 }
 
-big_integer &big_integer::trivial_division::modulo(
-    big_integer &dividend,
-    big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+big_integer big_integer::operator*(
+    big_integer const &other) const
 {
-    throw not_implemented("big_integer &big_integer::trivial_division::modulo(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    return multiply(*this, other);
 }
 
-big_integer &big_integer::Newton_division::divide(
-    big_integer &dividend,
-    big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+big_integer big_integer::operator*(
+    std::pair<big_integer, allocator *> const &other) const
 {
-    throw not_implemented("big_integer &big_integer::Newton_division::divide(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    return multiply(*this, other.first, other.second);
 }
 
-big_integer &big_integer::Newton_division::modulo(
-    big_integer &dividend,
-    big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+big_integer &big_integer::operator/=(
+    big_integer const &other)
 {
-    throw not_implemented("big_integer &big_integer::Newton_division::modulo(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    return divide(*this, other);
 }
 
-big_integer &big_integer::Burnikel_Ziegler_division::divide(
-    big_integer &dividend,
-    big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+big_integer big_integer::operator/(
+    big_integer const &other) const
 {
-    throw not_implemented("big_integer &big_integer::Burnikel_Ziegler_division::divide(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    return divide(*this, other);
 }
 
-big_integer &big_integer::Burnikel_Ziegler_division::modulo(
-    big_integer &dividend,
-    big_integer const &divisor,
-    big_integer::multiplication_rule multiplication_rule) const
+big_integer big_integer::operator/(
+    std::pair<big_integer, allocator *> const &other) const
 {
-    throw not_implemented("big_integer &big_integer::Burnikel_Ziegler_division::modulo(big_integer &, big_integer const &, big_integer::multiplication_rule)", "your code should be here...");
+    return divide(*this, other.first, other.second);
 }
 
-big_integer::big_integer(
-    int const *digits,
-    size_t digits_count,
-    allocator *allocator)
+big_integer &big_integer::operator%=(
+    big_integer const &other)
 {
-    throw not_implemented("big_integer::big_integer(int *, size_t, allocator *)", "your code should be here...");
+    return modulo(*this, other);
 }
 
-big_integer::big_integer(
-    std::vector<int> const &digits,
-    allocator *allocator)
+big_integer big_integer::operator%(
+    big_integer const &other) const
 {
-    throw not_implemented("big_integer::big_integer(std::vector<int> const &, allocator *)", "your code should be here...");
+    return modulo(*this, other);
 }
 
-big_integer::big_integer(
-    std::string const &value_as_string,
-    size_t base,
-    allocator *allocator)
+big_integer big_integer::operator%(
+    std::pair<big_integer, allocator *> const &other) const
 {
-    throw not_implemented("big_integer::big_integer(std::string const &, size_t, allocator *)", "your code should be here...");
+    return modulo(*this, other.first, other.second);
 }
 
-big_integer::~big_integer()
+big_integer big_integer::operator~() const
 {
-    throw not_implemented("big_integer::~big_integer()", "your code should be here...");
+    auto const digits_count = get_digits_count();
+    digits_buffer inverted(digits_count);
+    load_digits(inverted.get(), digits_count);
+    choose_limbwise_kernels().invert(inverted.get(), nullptr, digits_count);
+
+    big_integer result(*this);
+    result.assign_digits(inverted.get(), digits_count);
+
+    return result;
 }
 
-big_integer::big_integer(
+big_integer &big_integer::operator&=(
     big_integer const &other)
 {
-    throw not_implemented("big_integer::big_integer(big_integer const &)", "your code should be here...");
+    auto const digits_count = std::max(get_digits_count(), other.get_digits_count());
+    digits_buffer result(digits_count);
+    load_digits(result.get(), digits_count);
+    other.combine_digits(result.get(), digits_count, choose_limbwise_kernels().conjoin);
+
+    return assign_digits(result.get(), digits_count);
 }
 
-big_integer &big_integer::operator=(
-    big_integer const &other)
+big_integer big_integer::operator&(
+    big_integer const &other) const
 {
-    throw not_implemented("big_integer &big_integer::operator=(big_integer const &)", "your code should be here...");
+    big_integer result(*this);
+    result &= other;
+
+    return result;
 }
 
-big_integer::big_integer(
-    big_integer &&other) noexcept
+big_integer big_integer::operator&(
+    std::pair<big_integer, allocator *> const &other) const
 {
-    throw not_implemented("big_integer::big_integer(big_integer &&other) noexcept", "your code should be here...");
+    big_integer result(*this, other.second);
+    result &= other.first;
+
+    return result;
 }
 
-big_integer &big_integer::operator=(
-    big_integer &&other) noexcept
+big_integer &big_integer::operator|=(
+    big_integer const &other)
 {
-    throw not_implemented("big_integer &big_integer::operator=(big_integer &&) noexcept", "your code should be here...");
+    auto const digits_count = std::max(get_digits_count(), other.get_digits_count());
+    digits_buffer result(digits_count);
+    load_digits(result.get(), digits_count);
+    other.combine_digits(result.get(), digits_count, choose_limbwise_kernels().disjoin);
+
+    return assign_digits(result.get(), digits_count);
 }
 
-bool big_integer::operator==(
+big_integer big_integer::operator|(
     big_integer const &other) const
 {
-    throw not_implemented("bool big_integer::operator==(big_integer const &) const", "your code should be here...");
+    big_integer result(*this);
+    result |= other;
+
+    return result;
 }
 
-bool big_integer::operator!=(
+big_integer big_integer::operator|(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    big_integer result(*this, other.second);
+    result |= other.first;
+
+    return result;
+}
+
+big_integer &big_integer::operator^=(
+    big_integer const &other)
+{
+    auto const digits_count = std::max(get_digits_count(), other.get_digits_count());
+    digits_buffer result(digits_count);
+    load_digits(result.get(), digits_count);
+    other.combine_digits(result.get(), digits_count, choose_limbwise_kernels().exclusively_disjoin);
+
+    return assign_digits(result.get(), digits_count);
+}
+
+big_integer big_integer::operator^(
     big_integer const &other) const
 {
-    throw not_implemented("bool big_integer::operator!=(big_integer const &) const", "your code should be here...");
-}
+    big_integer result(*this);
+    result ^= other;
+
+    return result;
+}
+
+big_integer big_integer::operator^(
+    std::pair<big_integer, allocator *> const &other) const
+{
+    big_integer result(*this, other.second);
+    result ^= other.first;
+
+    return result;
+}
+
+big_integer &big_integer::operator<<=(
+    size_t shift)
+{
+    if (shift == 0 || is_zero())
+    {
+        return *this;
+    }
+
+#if defined(__SIZEOF_INT128__)
+    if (is_inline() && shift < 127)
+    {
+        auto const value = get_inline_value();
+        auto const shifted_value = static_cast<__int128>(static_cast<unsigned __int128>(value) << shift);
+        if ((shifted_value >> shift) == value)
+        {
+            return assign_inline_value(shifted_value);
+        }
+    }
+#endif
+
+    auto const digits_shift = shift / digit_bits;
+    auto const bits_shift = shift % digit_bits;
+
+    // the extra sign digit absorbs the bits shifted out of the most significant one
+    auto const digits_count = get_digits_count() + 1;
+    auto const shifted_count = digits_count + digits_shift;
+    digits_buffer shifted(shifted_count);
+    auto *shifted_digits = shifted.get();
+
+    std::fill(shifted_digits, shifted_digits + digits_shift, 0);
+
+    // the digits are shifted straight from the storage, and the oldest one and the sign digit above it after them
+    auto const other_count = digits_count - 2;
+    digit const top_digits[] = { static_cast<digit>(_oldest_digit), is_negative()
+        ? max_digit
+        : 0 };
+    auto const carry = shift_left(shifted_digits + digits_shift, get_other_digits(), other_count, bits_shift);
+    shift_left(shifted_digits + digits_shift + other_count, top_digits, 2, bits_shift);
+    shifted_digits[digits_shift + other_count] |= carry;
+
+    return assign_digits(shifted_digits, shifted_count);
+}
+
+big_integer big_integer::operator<<(
+    size_t shift) const
+{
+    big_integer result(*this);
+    result <<= shift;
+
+    return result;
+}
+
+big_integer big_integer::operator<<(
+    std::pair<size_t, allocator *> const &shift) const
+{
+    big_integer result(*this, shift.second);
+    result <<= shift.first;
+
+    return result;
+}
+
+big_integer &big_integer::operator>>=(
+    size_t shift)
+{
+    if (shift == 0)
+    {
+        return *this;
+    }
+
+#if defined(__SIZEOF_INT128__)
+    if (is_inline())
+    {
+        return assign_inline_value(get_inline_value() >> std::min<size_t>(shift, 127));
+    }
+#endif
+
+    // arithmetic shift: negative values are rounded towards minus infinity
+    digit const sign_digit = is_negative()
+        ? max_digit
+        : 0;
+
+    auto const digits_shift = shift / digit_bits;
+    auto const bits_shift = shift % digit_bits;
+    auto const digits_count = get_digits_count();
+    if (digits_shift >= digits_count)
+    {
+        return assign_digits(&sign_digit, 1);
+    }
+
+    auto const shifted_count = digits_count - digits_shift;
+    digits_buffer shifted(shifted_count);
+    auto *shifted_digits = shifted.get();
+
+    // the digits are shifted straight from the storage, and the oldest one, with the sign digit above it, last
+    auto const other_count = digits_count - 1;
+    auto const oldest_digit = static_cast<digit>(_oldest_digit);
+    if (digits_shift < other_count)
+    {
+        shift_right(shifted_digits, get_other_digits() + digits_shift, other_count - digits_shift, bits_shift, oldest_digit);
+    }
+    shift_right(shifted_digits + shifted_count - 1, &oldest_digit, 1, bits_shift, sign_digit);
+
+    return assign_digits(shifted_digits, shifted_count);
+}
+
+big_integer big_integer::operator>>(
+    size_t shift) const
+{
+    big_integer result(*this);
+    result >>= shift;
+
+    return result;
+}
+
+big_integer big_integer::operator>>(
+    std::pair<size_t, allocator *> const &shift) const
+{
+    big_integer result(*this, shift.second);
+    result >>= shift.first;
+
+    return result;
+}
+
+big_integer &big_integer::multiply(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    static trivial_multiplication const trivial;
+    static Karatsuba_multiplication const Karatsuba;
+    static Toom3_multiplication const Toom3;
+    static Toom4_multiplication const Toom4;
+    static Schonhage_Strassen_multiplication const Schonhage_Strassen;
+    static automatic_multiplication const automatic;
+    static parallel_multiplication const parallel;
+
+    multiplication const *chosen = &trivial;
+    switch (multiplication_rule)
+    {
+        case big_integer::multiplication_rule::trivial:
+            chosen = &trivial;
+            break;
+        case big_integer::multiplication_rule::Karatsuba:
+            chosen = &Karatsuba;
+            break;
+        case big_integer::multiplication_rule::Toom3:
+            chosen = &Toom3;
+            break;
+        case big_integer::multiplication_rule::Toom4:
+            chosen = &Toom4;
+            break;
+        case big_integer::multiplication_rule::SchonhageStrassen:
+            chosen = &Schonhage_Strassen;
+            break;
+        case big_integer::multiplication_rule::automatic:
+            chosen = &automatic;
+            break;
+        case big_integer::multiplication_rule::parallel:
+            chosen = &parallel;
+            break;
+    }
+
+#if defined(__SIZEOF_INT128__)
+    __int128 product;
+    if (first_multiplier.is_inline() && second_multiplier.is_inline()
+        && !__builtin_mul_overflow(first_multiplier.get_inline_value(), second_multiplier.get_inline_value(), &product))
+    {
+        first_multiplier.assign_inline_value(product);
+    }
+    else
+#endif
+    {
+        chosen->multiply(first_multiplier, second_multiplier);
+    }
+
+    if (allocator != nullptr && allocator != first_multiplier._allocator)
+    {
+        first_multiplier = big_integer(first_multiplier, allocator);
+    }
+
+    return first_multiplier;
+}
+
+big_integer big_integer::multiply(
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    big_integer result(first_multiplier, allocator == nullptr
+        ? first_multiplier._allocator
+        : allocator);
+    multiply(result, second_multiplier, nullptr, multiplication_rule);
+
+    return result;
+}
+
+big_integer &big_integer::addmul(
+    big_integer &destination,
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    multiply_accumulate(destination, destination, first_multiplier, second_multiplier, false, multiplication_rule);
+
+    if (allocator != nullptr && allocator != destination._allocator)
+    {
+        destination = big_integer(destination, allocator);
+    }
+
+    return destination;
+}
+
+big_integer &big_integer::submul(
+    big_integer &destination,
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    multiply_accumulate(destination, destination, first_multiplier, second_multiplier, true, multiplication_rule);
+
+    if (allocator != nullptr && allocator != destination._allocator)
+    {
+        destination = big_integer(destination, allocator);
+    }
+
+    return destination;
+}
+
+big_integer &big_integer::mul_add(
+    big_integer &destination,
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    big_integer const &addend,
+    allocator *allocator,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    multiply_accumulate(destination, addend, first_multiplier, second_multiplier, false, multiplication_rule);
+
+    if (allocator != nullptr && allocator != destination._allocator)
+    {
+        destination = big_integer(destination, allocator);
+    }
+
+    return destination;
+}
+
+big_integer &big_integer::divide(
+    big_integer &dividend,
+    big_integer const &divisor,
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    if (divisor.is_zero())
+    {
+        throw std::logic_error("division by zero");
+    }
+
+#if defined(__SIZEOF_INT128__)
+    // the only inline quotient that overflows is the most negative value divided by -1
+    if (dividend.is_inline() && divisor.is_inline()
+        && !(divisor.get_inline_value() == -1 && dividend.get_inline_value() == min_inline_value))
+    {
+        dividend.assign_inline_value(dividend.get_inline_value() / divisor.get_inline_value());
+    }
+    else
+#endif
+    {
+        choose_division(division_rule).divide(dividend, divisor, multiplication_rule);
+    }
+
+    if (allocator != nullptr && allocator != dividend._allocator)
+    {
+        dividend = big_integer(dividend, allocator);
+    }
+
+    return dividend;
+}
+
+big_integer big_integer::divide(
+    big_integer const &dividend,
+    big_integer const &divisor,
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    big_integer result(dividend, allocator == nullptr
+        ? dividend._allocator
+        : allocator);
+    divide(result, divisor, nullptr, division_rule, multiplication_rule);
+
+    return result;
+}
+
+big_integer &big_integer::modulo(
+    big_integer &dividend,
+    big_integer const &divisor,
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    if (divisor.is_zero())
+    {
+        throw std::logic_error("division by zero");
+    }
+
+#if defined(__SIZEOF_INT128__)
+    // the only inline quotient that overflows is the most negative value divided by -1
+    if (dividend.is_inline() && divisor.is_inline()
+        && !(divisor.get_inline_value() == -1 && dividend.get_inline_value() == min_inline_value))
+    {
+        dividend.assign_inline_value(dividend.get_inline_value() % divisor.get_inline_value());
+    }
+    else
+#endif
+    {
+        choose_division(division_rule).modulo(dividend, divisor, multiplication_rule);
+    }
+
+    if (allocator != nullptr && allocator != dividend._allocator)
+    {
+        dividend = big_integer(dividend, allocator);
+    }
+
+    return dividend;
+}
+
+big_integer big_integer::modulo(
+    big_integer const &dividend,
+    big_integer const &divisor,
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
+{
+    big_integer result(dividend, allocator == nullptr
+        ? dividend._allocator
+        : allocator);
+    modulo(result, divisor, nullptr, division_rule, multiplication_rule);
 
-bool big_integer::operator<(
-    big_integer const &other) const
-{
-    throw not_implemented("bool big_integer::operator<(big_integer const &) const", "your code should be here...");
+    return result;
 }
 
-bool big_integer::operator>(
-    big_integer const &other) const
+big_integer &big_integer::divmod(
+    big_integer &dividend,
+    big_integer const &divisor,
+    big_integer &remainder,
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("bool big_integer::operator>(big_integer const &) const", "your code should be here...");
-}
+    if (divisor.is_zero())
+    {
+        throw std::logic_error("division by zero");
+    }
 
-bool big_integer::operator<=(
-    big_integer const &other) const
-{
-    throw not_implemented("bool big_integer::operator<=(big_integer const &) const", "your code should be here...");
-}
+#if defined(__SIZEOF_INT128__)
+    if (dividend.is_inline() && divisor.is_inline()
+        && !(divisor.get_inline_value() == -1 && dividend.get_inline_value() == min_inline_value))
+    {
+        auto const dividend_value = dividend.get_inline_value();
+        auto const divisor_value = divisor.get_inline_value();
+        remainder.assign_inline_value(dividend_value % divisor_value);
+        dividend.assign_inline_value(dividend_value / divisor_value);
+    }
+    else
+#endif
+    {
+        choose_division(division_rule).divmod(dividend, divisor, remainder, multiplication_rule);
+    }
 
-bool big_integer::operator>=(
-    big_integer const &other) const
-{
-    throw not_implemented("bool big_integer::operator>=(big_integer const &) const", "your code should be here...");
-}
+    if (allocator != nullptr && allocator != dividend._allocator)
+    {
+        dividend = big_integer(dividend, allocator);
+    }
+    if (allocator != nullptr && allocator != remainder._allocator)
+    {
+        remainder = big_integer(remainder, allocator);
+    }
 
-big_integer big_integer::operator-() const
-{
-    throw not_implemented("big_integer big_integer::operator-() const", "your code should be here...");
+    return dividend;
 }
 
-big_integer &big_integer::operator+=(
-    big_integer const &other)
+std::pair<big_integer, big_integer> big_integer::divmod(
+    big_integer const &dividend,
+    big_integer const &divisor,
+    allocator *allocator,
+    big_integer::division_rule division_rule,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer &big_integer::operator+=(big_integer const &)", "your code should be here...");
-}
+    if (allocator == nullptr)
+    {
+        allocator = dividend._allocator;
+    }
 
-big_integer big_integer::operator+(
-    big_integer const &other) const
-{
-    throw not_implemented("big_integer big_integer::operator+(big_integer const &) const", "your code should be here...");
-}
+    int const zero = 0;
+    std::pair<big_integer, big_integer> result(big_integer(dividend, allocator), big_integer(&zero, 1, allocator));
+    divmod(result.first, divisor, result.second, nullptr, division_rule, multiplication_rule);
 
-big_integer big_integer::operator+(
-    std::pair<big_integer, allocator *> const &other) const
-{
-    throw not_implemented("big_integer big_integer::operator+(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    return result;
 }
 
-big_integer &big_integer::operator-=(
-    big_integer const &other)
+big_integer &big_integer::divide(
+    big_integer &dividend,
+    precomputed_divisor const &divisor,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer &big_integer::operator-=(big_integer const &)", "your code should be here...");
-}
+#if defined(__SIZEOF_INT128__)
+    if (dividend.is_inline() && divisor._divisor.is_inline()
+        && !(divisor._divisor.get_inline_value() == -1 && dividend.get_inline_value() == min_inline_value))
+    {
+        dividend.assign_inline_value(dividend.get_inline_value() / divisor._divisor.get_inline_value());
+    }
+    else
+#endif
+    {
+        divisor.divide(dividend, &dividend, nullptr);
+    }
 
-big_integer big_integer::operator-(
-    big_integer const &other) const
-{
-    throw not_implemented("big_integer big_integer::operator-(big_integer const &) const", "your code should be here...");
+    if (allocator != nullptr && allocator != dividend._allocator)
+    {
+        dividend = big_integer(dividend, allocator);
+    }
+
+    return dividend;
 }
 
-big_integer big_integer::operator-(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer big_integer::divide(
+    big_integer const &dividend,
+    precomputed_divisor const &divisor,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer big_integer::operator-(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    big_integer result(dividend, allocator == nullptr
+        ? dividend._allocator
+        : allocator);
+    divide(result, divisor);
+
+    return result;
 }
 
-big_integer &big_integer::operator*=(
-    big_integer const &other)
+big_integer &big_integer::modulo(
+    big_integer &dividend,
+    precomputed_divisor const &divisor,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer &big_integer::operator*=(big_integer const &)", "your code should be here...");
+#if defined(__SIZEOF_INT128__)
+    if (dividend.is_inline() && divisor._divisor.is_inline()
+        && !(divisor._divisor.get_inline_value() == -1 && dividend.get_inline_value() == min_inline_value))
+    {
+        dividend.assign_inline_value(dividend.get_inline_value() % divisor._divisor.get_inline_value());
+    }
+    else
+#endif
+    {
+        divisor.divide(dividend, nullptr, &dividend);
+    }
+
+    if (allocator != nullptr && allocator != dividend._allocator)
+    {
+        dividend = big_integer(dividend, allocator);
+    }
+
+    return dividend;
 }
 
-big_integer big_integer::operator*(
-    big_integer const &other) const
+big_integer big_integer::modulo(
+    big_integer const &dividend,
+    precomputed_divisor const &divisor,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer big_integer::operator*(big_integer const &) const", "your code should be here...");
+    big_integer result(dividend, allocator == nullptr
+        ? dividend._allocator
+        : allocator);
+    modulo(result, divisor);
+
+    return result;
 }
 
-big_integer big_integer::operator*(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer &big_integer::divmod(
+    big_integer &dividend,
+    precomputed_divisor const &divisor,
+    big_integer &remainder,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer big_integer::operator*(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+#if defined(__SIZEOF_INT128__)
+    if (dividend.is_inline() && divisor._divisor.is_inline()
+        && !(divisor._divisor.get_inline_value() == -1 && dividend.get_inline_value() == min_inline_value))
+    {
+        auto const dividend_value = dividend.get_inline_value();
+        auto const divisor_value = divisor._divisor.get_inline_value();
+        remainder.assign_inline_value(dividend_value % divisor_value);
+        dividend.assign_inline_value(dividend_value / divisor_value);
+    }
+    else
+#endif
+    {
+        divisor.divide(dividend, &dividend, &remainder);
+    }
+
+    if (allocator != nullptr && allocator != dividend._allocator)
+    {
+        dividend = big_integer(dividend, allocator);
+    }
+    if (allocator != nullptr && allocator != remainder._allocator)
+    {
+        remainder = big_integer(remainder, allocator);
+    }
+
+    return dividend;
 }
 
-big_integer &big_integer::operator/=(
-    big_integer const &other)
+std::pair<big_integer, big_integer> big_integer::divmod(
+    big_integer const &dividend,
+    precomputed_divisor const &divisor,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer &big_integer::operator/=(big_integer const &)", "your code should be here...");
+    if (allocator == nullptr)
+    {
+        allocator = dividend._allocator;
+    }
+
+    int const zero = 0;
+    std::pair<big_integer, big_integer> result(big_integer(dividend, allocator), big_integer(&zero, 1, allocator));
+    divmod(result.first, divisor, result.second);
+
+    return result;
 }
 
-big_integer big_integer::operator/(
-    big_integer const &other) const
+void big_integer::load_residue(
+    big_integer const &value,
+    std::vector<limb> const &modulus,
+    limb *residue)
 {
-    throw not_implemented("big_integer big_integer::operator/(big_integer const &) const", "your code should be here...");
+    auto const count = modulus.size();
+
+    digits_buffer magnitude(value.get_digits_count());
+    auto const magnitude_count = value.load_magnitude(magnitude.get());
+
+    if (magnitude_count < count)
+    {
+        std::copy(magnitude.get(), magnitude.get() + magnitude_count, residue);
+        std::fill(residue + magnitude_count, residue + count, 0);
+    }
+    else
+    {
+        divide_magnitudes(nullptr, residue, magnitude.get(), magnitude_count, modulus.data(), count);
+    }
+
+    if (value.is_negative() && significant_count(residue, count) != 0)
+    {
+        subtract_digits(residue, modulus.data(), count, residue, count);
+    }
 }
 
-big_integer big_integer::operator/(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer::Montgomery_context::Montgomery_context(
+    big_integer const &modulus):
+        _modulus(modulus),
+        _inverse(0)
 {
-    throw not_implemented("big_integer big_integer::operator/(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    if (modulus.is_zero() || modulus.is_negative())
+    {
+        throw std::logic_error("modulus is not positive");
+    }
+
+    _modulus_digits.resize(modulus.get_digits_count());
+    auto const count = modulus.load_magnitude(_modulus_digits.data());
+    _modulus_digits.resize(count);
+
+    if (_modulus_digits[0] % 2 == 0)
+    {
+        throw std::logic_error("Montgomery reduction needs an odd modulus");
+    }
+
+    _inverse = negated_inverse_digit(_modulus_digits[0]);
+
+    // R mod modulus and R^2 mod modulus are the remainders of B^count and B^(2 count)
+    digits_buffer power(2 * count + 1);
+    auto *power_digits = power.get();
+    std::fill(power_digits, power_digits + 2 * count + 1, 0);
+
+    power_digits[count] = 1;
+    _one.resize(count);
+    divide_magnitudes(nullptr, _one.data(), power_digits, count + 1, _modulus_digits.data(), count);
+
+    power_digits[count] = 0;
+    power_digits[2 * count] = 1;
+    _square.resize(count);
+    divide_magnitudes(nullptr, _square.data(), power_digits, 2 * count + 1, _modulus_digits.data(), count);
 }
 
-big_integer &big_integer::operator%=(
-    big_integer const &other)
+big_integer big_integer::Montgomery_context::to_form(
+    big_integer const &value) const
 {
-    throw not_implemented("big_integer &big_integer::operator%=(big_integer const &)", "your code should be here...");
+    auto const count = _modulus_digits.size();
+    Montgomery_reduction const reduction(_modulus_digits.data(), count, _inverse);
+
+    digits_buffer residue(count);
+    digits_buffer work(reduction.work_count());
+    load_residue(value, _modulus_digits, residue.get());
+    reduction.multiply(residue.get(), residue.get(), _square.data(), work.get());
+
+    int const zero = 0;
+    big_integer result(&zero, 1, value._allocator);
+    result.assign_magnitude(residue.get(), count, false);
+
+    return result;
 }
 
-big_integer big_integer::operator%(
-    big_integer const &other) const
+big_integer big_integer::Montgomery_context::from_form(
+    big_integer const &value) const
 {
-    throw not_implemented("big_integer big_integer::operator%(big_integer const &) const", "your code should be here...");
+    auto const count = _modulus_digits.size();
+    Montgomery_reduction const reduction(_modulus_digits.data(), count, _inverse);
+
+    digits_buffer residue(count);
+    digits_buffer unit(count);
+    digits_buffer work(reduction.work_count());
+    load_residue(value, _modulus_digits, residue.get());
+    std::fill(unit.get(), unit.get() + count, 0);
+    unit.get()[0] = 1;
+    reduction.multiply(residue.get(), residue.get(), unit.get(), work.get());
+
+    int const zero = 0;
+    big_integer result(&zero, 1, value._allocator);
+    result.assign_magnitude(residue.get(), count, false);
+
+    return result;
 }
 
-big_integer big_integer::operator%(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer big_integer::Montgomery_context::multiply(
+    big_integer const &first,
+    big_integer const &second) const
 {
-    throw not_implemented("big_integer big_integer::operator%(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    auto const count = _modulus_digits.size();
+    Montgomery_reduction const reduction(_modulus_digits.data(), count, _inverse);
+
+    digits_buffer first_residue(count);
+    digits_buffer second_residue(count);
+    digits_buffer work(reduction.work_count());
+    load_residue(first, _modulus_digits, first_residue.get());
+    load_residue(second, _modulus_digits, second_residue.get());
+    reduction.multiply(first_residue.get(), first_residue.get(), second_residue.get(), work.get());
+
+    int const zero = 0;
+    big_integer result(&zero, 1, first._allocator);
+    result.assign_magnitude(first_residue.get(), count, false);
+
+    return result;
 }
 
-big_integer big_integer::operator~() const
+big_integer big_integer::Montgomery_context::pow(
+    big_integer const &base,
+    big_integer const &exponent) const
 {
-    throw not_implemented("big_integer big_integer::operator~() const", "your code should be here...");
+    if (exponent.is_negative())
+    {
+        throw std::logic_error("negative exponent");
+    }
+
+    auto const count = _modulus_digits.size();
+    Montgomery_reduction const reduction(_modulus_digits.data(), count, _inverse);
+
+    digits_buffer exponent_magnitude(exponent.get_digits_count());
+    auto const exponent_count = exponent.load_magnitude(exponent_magnitude.get());
+
+    digits_buffer residue(count);
+    digits_buffer power(count);
+    digits_buffer work(reduction.work_count());
+    auto *residue_digits = residue.get();
+    auto *power_digits = power.get();
+
+    load_residue(base, _modulus_digits, residue_digits);
+    reduction.multiply(residue_digits, residue_digits, _square.data(), work.get());
+    power_by_windows(power_digits, residue_digits, _one.data(), exponent_magnitude.get(), exponent_count, count, reduction,
+        work.get());
+
+    // out of Montgomery form by a product with 1
+    std::fill(residue_digits, residue_digits + count, 0);
+    residue_digits[0] = 1;
+    reduction.multiply(power_digits, power_digits, residue_digits, work.get());
+
+    int const zero = 0;
+    big_integer result(&zero, 1, base._allocator);
+    result.assign_magnitude(power_digits, count, false);
+
+    return result;
 }
 
-big_integer &big_integer::operator&=(
-    big_integer const &other)
+big_integer::Barrett_context::Barrett_context(
+    big_integer const &modulus):
+        _modulus(modulus)
 {
-    throw not_implemented("big_integer &big_integer::operator&=(big_integer const &)", "your code should be here...");
+    if (modulus.is_zero() || modulus.is_negative())
+    {
+        throw std::logic_error("modulus is not positive");
+    }
+
+    _modulus_digits.resize(modulus.get_digits_count());
+    auto const count = modulus.load_magnitude(_modulus_digits.data());
+    _modulus_digits.resize(count);
+
+    // the quotient of B^(2 count) takes count + 2 digits, for the modulus B^(count - 1)
+    digits_buffer power(2 * count + 1);
+    auto *power_digits = power.get();
+    std::fill(power_digits, power_digits + 2 * count, 0);
+    power_digits[2 * count] = 1;
+    _reciprocal.resize(count + 2);
+    divide_magnitudes(_reciprocal.data(), nullptr, power_digits, 2 * count + 1, _modulus_digits.data(), count);
 }
 
-big_integer big_integer::operator&(
-    big_integer const &other) const
+big_integer big_integer::Barrett_context::multiply(
+    big_integer const &first,
+    big_integer const &second) const
 {
-    throw not_implemented("big_integer big_integer::operator&(big_integer const &) const", "your code should be here...");
+    auto const count = _modulus_digits.size();
+    Barrett_reduction const reduction(_modulus_digits.data(), count, _reciprocal.data());
+
+    digits_buffer first_residue(count);
+    digits_buffer second_residue(count);
+    digits_buffer work(reduction.work_count());
+    load_residue(first, _modulus_digits, first_residue.get());
+    load_residue(second, _modulus_digits, second_residue.get());
+    reduction.multiply(first_residue.get(), first_residue.get(), second_residue.get(), work.get());
+
+    int const zero = 0;
+    big_integer result(&zero, 1, first._allocator);
+    result.assign_magnitude(first_residue.get(), count, false);
+
+    return result;
 }
 
-big_integer big_integer::operator&(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer big_integer::Barrett_context::pow(
+    big_integer const &base,
+    big_integer const &exponent) const
 {
-    throw not_implemented("big_integer big_integer::operator&(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    if (exponent.is_negative())
+    {
+        throw std::logic_error("negative exponent");
+    }
+
+    auto const count = _modulus_digits.size();
+    Barrett_reduction const reduction(_modulus_digits.data(), count, _reciprocal.data());
+
+    digits_buffer exponent_magnitude(exponent.get_digits_count());
+    auto const exponent_count = exponent.load_magnitude(exponent_magnitude.get());
+
+    digits_buffer residue(count);
+    digits_buffer one(count);
+    digits_buffer power(count);
+    digits_buffer work(reduction.work_count());
+
+    load_residue(base, _modulus_digits, residue.get());
+
+    // 1 mod modulus is 0 only for the modulus 1
+    std::fill(one.get(), one.get() + count, 0);
+    one.get()[0] = count == 1 && _modulus_digits[0] == 1
+        ? 0
+        : 1;
+
+    power_by_windows(power.get(), residue.get(), one.get(), exponent_magnitude.get(), exponent_count, count, reduction,
+        work.get());
+
+    int const zero = 0;
+    big_integer result(&zero, 1, base._allocator);
+    result.assign_magnitude(power.get(), count, false);
+
+    return result;
 }
 
-big_integer &big_integer::operator|=(
-    big_integer const &other)
+big_integer big_integer::pow_mod(
+    big_integer const &base,
+    big_integer const &exponent,
+    big_integer const &modulus,
+    allocator *allocator)
 {
-    throw not_implemented("big_integer &big_integer::operator|=(big_integer const &)", "your code should be here...");
+    // the low bit of the two's complement digits is the magnitude's
+    digits_buffer modulus_digits(modulus.get_digits_count());
+    modulus.load_digits(modulus_digits.get(), modulus.get_digits_count());
+
+    auto result = modulus_digits.get()[0] % 2 == 1
+        ? Montgomery_context(modulus).pow(base, exponent)
+        : Barrett_context(modulus).pow(base, exponent);
+
+    if (allocator != nullptr && allocator != result._allocator)
+    {
+        result = big_integer(result, allocator);
+    }
+
+    return result;
 }
 
-big_integer big_integer::operator|(
-    big_integer const &other) const
+std::ostream &operator<<(
+    std::ostream &stream,
+    big_integer const &value)
 {
-    throw not_implemented("big_integer big_integer::operator|(big_integer const &) const", "your code should be here...");
+    digits_buffer magnitude(value.get_digits_count());
+    auto *magnitude_digits = magnitude.get();
+    auto magnitude_count = value.load_magnitude(magnitude_digits);
+
+    if (magnitude_count == 0)
+    {
+        return stream << '0';
+    }
+
+    // the stream's basefield chooses hexadecimal or octal output, decimal otherwise
+    auto const flags = stream.flags();
+    size_t const base = (flags & std::ios::basefield) == std::ios::hex
+        ? 16
+        : (flags & std::ios::basefield) == std::ios::oct
+            ? 8
+            : 10;
+
+    std::string result = value.is_negative()
+        ? "-"
+        : "";
+    result += magnitude_to_string(magnitude_digits, magnitude_count, base, (flags & std::ios::uppercase) != 0);
+
+    return stream << result;
 }
 
-big_integer big_integer::operator|(
-    std::pair<big_integer, allocator *> const &other) const
+std::istream &operator>>(
+    std::istream &stream,
+    big_integer &value)
 {
-    throw not_implemented("big_integer big_integer::operator|(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    std::string token;
+    if (!(stream >> token))
+    {
+        return stream;
+    }
+
+    try
+    {
+        value = big_integer(token, 10, value._allocator);
+    }
+    catch (std::invalid_argument const &)
+    {
+        stream.setstate(std::ios::failbit);
+    }
+
+    return stream;
 }
 
-big_integer &big_integer::operator^=(
-    big_integer const &other)
+big_integer &big_integer::multiply_magnitudes(
+    big_integer &first_multiplier,
+    big_integer const &second_multiplier,
+    magnitudes_multiplier multiplier)
 {
-    throw not_implemented("big_integer &big_integer::operator^=(big_integer const &)", "your code should be here...");
+    if (first_multiplier.is_zero() || second_multiplier.is_zero())
+    {
+        digit const zero = 0;
+        return first_multiplier.assign_digits(&zero, 1);
+    }
+
+    digits_buffer first_magnitude(first_multiplier.get_digits_count());
+    digits_buffer second_magnitude(second_multiplier.get_digits_count());
+    auto const first_count = first_multiplier.load_magnitude(first_magnitude.get());
+    auto const second_count = second_multiplier.load_magnitude(second_magnitude.get());
+
+    // the multipliers square a magnitude passed as both operands
+    auto const *second_digits = first_count == second_count
+        && std::equal(first_magnitude.get(), first_magnitude.get() + first_count, second_magnitude.get())
+            ? first_magnitude.get()
+            : second_magnitude.get();
+
+    digits_buffer product(first_count + second_count);
+    multiplier(product.get(), first_magnitude.get(), first_count, second_digits, second_count);
+
+    return first_multiplier.assign_magnitude(
+        product.get(),
+        first_count + second_count,
+        first_multiplier.is_negative() != second_multiplier.is_negative());
 }
 
-big_integer big_integer::operator^(
-    big_integer const &other) const
+big_integer &big_integer::multiply_accumulate(
+    big_integer &destination,
+    big_integer const &addend,
+    big_integer const &first_multiplier,
+    big_integer const &second_multiplier,
+    bool is_subtracted,
+    big_integer::multiplication_rule multiplication_rule)
 {
-    throw not_implemented("big_integer big_integer::operator^(big_integer const &) const", "your code should be here...");
+#if defined(__SIZEOF_INT128__)
+    __int128 product;
+    __int128 result;
+    if (addend.is_inline() && first_multiplier.is_inline() && second_multiplier.is_inline()
+        && !__builtin_mul_overflow(first_multiplier.get_inline_value(), second_multiplier.get_inline_value(), &product)
+        && !(is_subtracted
+            ? __builtin_sub_overflow(addend.get_inline_value(), product, &result)
+            : __builtin_add_overflow(addend.get_inline_value(), product, &result)))
+    {
+        return destination.assign_inline_value(result);
+    }
+#endif
+
+    digits_buffer first_magnitude(first_multiplier.get_digits_count());
+    digits_buffer second_magnitude(second_multiplier.get_digits_count());
+    auto const *first_digits = first_magnitude.get();
+    auto const *second_digits = second_magnitude.get();
+    auto first_count = first_multiplier.load_magnitude(first_magnitude.get());
+    auto second_count = second_multiplier.load_magnitude(second_magnitude.get());
+
+    // one more digit than the longer of the addend and the product holds the result
+    auto const product_count = first_count + second_count;
+    auto const digits_count = std::max(addend.get_digits_count(), product_count) + 1;
+    digits_buffer sum(digits_count);
+    addend.load_digits(sum.get(), digits_count);
+
+    if (first_count != 0 && second_count != 0)
+    {
+        // a negative product turns the addition into a subtraction
+        auto const is_product_subtracted = is_subtracted != (first_multiplier.is_negative() != second_multiplier.is_negative());
+
+        if (first_count < second_count)
+        {
+            std::swap(first_digits, second_digits);
+            std::swap(first_count, second_count);
+        }
+        auto const is_square = first_count == second_count && std::equal(first_digits, first_digits + first_count, second_digits);
+
+        // schoolbook rows go straight into the sum, except for squares, which the multipliers compute in half the products
+        if (!is_square && (multiplication_rule == big_integer::multiplication_rule::trivial || second_count < Karatsuba_threshold))
+        {
+            accumulate_schoolbook(sum.get(), digits_count, first_digits, first_count, second_digits, second_count, is_product_subtracted);
+        }
+        else
+        {
+            digits_buffer product(product_count);
+            choose_multiplier(multiplication_rule)(product.get(), first_digits, first_count, is_square
+                ? first_digits
+                : second_digits, second_count);
+
+            if (is_product_subtracted)
+            {
+                subtract_digits(sum.get(), sum.get(), digits_count, product.get(), product_count);
+            }
+            else
+            {
+                add_digits(sum.get(), sum.get(), digits_count, product.get(), product_count);
+            }
+        }
+    }
+
+    return destination.assign_digits(sum.get(), digits_count);
 }
 
-big_integer big_integer::operator^(
-    std::pair<big_integer, allocator *> const &other) const
+big_integer::division const &big_integer::choose_division(
+    big_integer::division_rule division_rule) noexcept
 {
-    throw not_implemented("big_integer big_integer::operator^(std::pair<big_integer, allocator *> const &) const", "your code should be here...");
+    static trivial_division const trivial;
+    static Newton_division const Newton;
+    static Burnikel_Ziegler_division const Burnikel_Ziegler;
+
+    switch (division_rule)
+    {
+        case big_integer::division_rule::Newton:
+            return Newton;
+        case big_integer::division_rule::BurnikelZiegler:
+            return Burnikel_Ziegler;
+        default:
+            return trivial;
+    }
 }
 
-big_integer &big_integer::operator<<=(
-    size_t shift)
+big_integer::big_integer(
+    big_integer const &other,
+    allocator *allocator):
+        _oldest_digit(other._oldest_digit),
+        _digits_count(other._digits_count),
+        _allocator(allocator)
 {
-    throw not_implemented("big_integer &big_integer::operator<<=(size_t)", "your code should be here...");
+    if (other.is_inline())
+    {
+        std::copy(other._inline_digits, other._inline_digits + inline_digits_count - 1, _inline_digits);
+        return;
+    }
+
+    auto const other_digits_count = _digits_count - 1;
+    _other_digits = _allocator == nullptr
+        ? allocate_digits(other_digits_count)
+        : static_cast<digit *>(allocate_with_guard(sizeof(digit), other_digits_count));
+    std::memcpy(_other_digits, other._other_digits, other_digits_count * sizeof(digit));
 }
 
-big_integer big_integer::operator<<(
-    size_t shift) const
+[[nodiscard]] allocator *big_integer::get_allocator() const noexcept
 {
-    throw not_implemented("big_integer big_integer::operator<<(size_t) const", "your code should be here...");
+    return _allocator;
 }
 
-big_integer big_integer::operator<<(
-    std::pair<size_t, allocator *> const &shift) const
+size_t big_integer::get_digits_count() const noexcept
 {
-    throw not_implemented("big_integer big_integer::operator<<(std::pair<size_t, allocator *> const &) const", "your code should be here...");
+    return _digits_count;
 }
 
-big_integer &big_integer::operator>>=(
-    size_t shift)
+bool big_integer::is_inline() const noexcept
 {
-    throw not_implemented("big_integer &big_integer::operator>>=(size_t)", "your code should be here...");
+    return _digits_count <= inline_digits_count;
 }
 
-big_integer big_integer::operator>>(
-    size_t shift) const
+big_integer::limb const *big_integer::get_other_digits() const noexcept
 {
-    throw not_implemented("big_integer big_integer::operator>>(size_t) const", "your code should be here...");
+    return is_inline()
+        ? _inline_digits
+        : _other_digits;
 }
 
-big_integer big_integer::operator>>(
-    std::pair<size_t, allocator *> const &other) const
+#if defined(__SIZEOF_INT128__)
+
+__int128 big_integer::get_inline_value() const noexcept
 {
-    throw not_implemented("big_integer big_integer::operator>>(std::pair<size_t, allocator *> const &) const", "your code should be here...");
+    // the sign-extended oldest digit is shifted up as the others are appended below it
+    auto value = static_cast<unsigned __int128>(static_cast<__int128>(_oldest_digit));
+    for (size_t i = _digits_count - 1; i-- > 0;)
+    {
+        value = (value << digit_bits) | _inline_digits[i];
+    }
+
+    return static_cast<__int128>(value);
 }
 
-big_integer &big_integer::multiply(
-    big_integer &first_multiplier,
-    big_integer const &second_multiplier,
-    allocator *allocator,
-    big_integer::multiplication_rule multiplication_rule)
+big_integer &big_integer::assign_inline_value(
+    __int128 value) noexcept
 {
-    throw not_implemented("big_integer &big_integer::multiply(big_integer &, big_integer const &, allocator *, big_integer::multiplication_rule)", "your code should be here...");
+    digit digits[inline_digits_count];
+    auto bits = static_cast<unsigned __int128>(value);
+    for (auto &current: digits)
+    {
+        current = static_cast<digit>(bits);
+        bits >>= digit_bits;
+    }
+
+    // a value of inline_digits_count digits never needs the allocator
+    return assign_digits(digits, inline_digits_count);
 }
 
-big_integer big_integer::multiply(
-    big_integer const &first_multiplier,
-    big_integer const &second_multiplier,
-    allocator *allocator,
-    big_integer::multiplication_rule multiplication_rule)
+#endif
+
+bool big_integer::is_negative() const noexcept
 {
-    throw not_implemented("big_integer big_integer::multiply(big_integer const &, big_integer const &, allocator *, big_integer::multiplication_rule)", "your code should be here...");
+    return _oldest_digit < 0;
 }
 
-big_integer &big_integer::divide(
-    big_integer &dividend,
-    big_integer const &divisor,
-    allocator *allocator,
-    big_integer::division_rule division_rule,
-    big_integer::multiplication_rule multiplication_rule)
+bool big_integer::is_zero() const noexcept
 {
-    throw not_implemented("big_integer &big_integer::divide(big_integer &, big_integer const &, allocator *, big_integer::division_rule, big_integer::multiplication_rule)", "your code should be here...");
+    return _digits_count == 1 && _oldest_digit == 0;
 }
 
-big_integer big_integer::divide(
-    big_integer const &dividend,
-    big_integer const &divisor,
-    allocator *allocator,
-    big_integer::division_rule division_rule,
-    big_integer::multiplication_rule multiplication_rule)
+void big_integer::load_digits(
+    digit *destination,
+    size_t digits_count) const noexcept
 {
-    throw not_implemented("big_integer big_integer::divide(big_integer const &, big_integer const &, allocator *, big_integer::division_rule, big_integer::multiplication_rule)", "your code should be here...");
+    auto const *other_digits = get_other_digits();
+    std::copy(other_digits, other_digits + _digits_count - 1, destination);
+    destination[_digits_count - 1] = static_cast<digit>(_oldest_digit);
+
+    std::fill(destination + _digits_count, destination + digits_count, is_negative()
+        ? max_digit
+        : 0);
 }
 
-big_integer &big_integer::modulo(
-    big_integer &dividend,
-    big_integer const &divisor,
-    allocator *allocator,
-    big_integer::division_rule division_rule,
-    big_integer::multiplication_rule multiplication_rule)
+void big_integer::combine_digits(
+    digit *destination,
+    size_t digits_count,
+    limbs_combiner combiner) const noexcept
 {
-    throw not_implemented("big_integer &big_integer::modulo(big_integer &, big_integer const &, allocator *, big_integer::division_rule, big_integer::multiplication_rule)", "your code should be here...");
+    auto const oldest_digit = static_cast<digit>(_oldest_digit);
+    combiner(destination, get_other_digits(), _digits_count - 1);
+    combiner(destination + _digits_count - 1, &oldest_digit, 1);
+
+    constexpr size_t block_count = 32;
+    digit sign_digits[block_count];
+    std::fill(sign_digits, sign_digits + block_count, is_negative()
+        ? max_digit
+        : 0);
+    for (size_t i = _digits_count; i < digits_count; i += block_count)
+    {
+        combiner(destination + i, sign_digits, std::min(block_count, digits_count - i));
+    }
 }
 
-big_integer big_integer::modulo(
-    big_integer const &dividend,
-    big_integer const &divisor,
-    allocator *allocator,
-    big_integer::division_rule division_rule,
-    big_integer::multiplication_rule multiplication_rule)
+size_t big_integer::load_magnitude(
+    digit *destination) const noexcept
 {
-    throw not_implemented("big_integer big_integer::modulo(big_integer const &, big_integer const &, allocator *, big_integer::division_rule, big_integer::multiplication_rule)", "your code should be here...");
+    auto const digits_count = get_digits_count();
+    load_digits(destination, digits_count);
+
+    // the most negative value of digits_count digits still fits in as many unsigned ones
+    if (is_negative())
+    {
+        negate_digits(destination, digits_count);
+    }
+
+    return significant_count(destination, digits_count);
 }
 
-std::ostream &operator<<(
-    std::ostream &stream,
-    big_integer const &value)
+big_integer &big_integer::assign_digits(
+    digit const *digits,
+    size_t digits_count)
 {
-    throw not_implemented("std::ostream &operator<<(std::ostream &, big_integer const &)", "your code should be here...");
+    auto const is_sign_bit_set = [digits](size_t position)
+    {
+        return (digits[position] >> (digit_bits - 1)) != 0;
+    };
+
+    while (digits_count > 1
+        && ((digits[digits_count - 1] == 0 && !is_sign_bit_set(digits_count - 2))
+            || (digits[digits_count - 1] == max_digit && is_sign_bit_set(digits_count - 2))))
+    {
+        --digits_count;
+    }
+
+    if (digits_count <= inline_digits_count)
+    {
+        // digits may be this value's own ones, so they are taken before the storage is released
+        digit inline_digits[inline_digits_count];
+        std::copy(digits, digits + digits_count, inline_digits);
+
+        release_digits();
+        std::copy(inline_digits, inline_digits + digits_count - 1, _inline_digits);
+        _oldest_digit = static_cast<signed_limb>(inline_digits[digits_count - 1]);
+        _digits_count = static_cast<unsigned int>(digits_count);
+
+        return *this;
+    }
+
+    if (is_inline() || _digits_count != digits_count)
+    {
+        auto *allocated = _allocator == nullptr
+            ? allocate_digits(digits_count - 1)
+            : static_cast<digit *>(allocate_with_guard(sizeof(digit), digits_count - 1));
+
+        release_digits();
+        _other_digits = allocated;
+    }
+
+    std::memmove(_other_digits, digits, (digits_count - 1) * sizeof(digit));
+    _oldest_digit = static_cast<signed_limb>(digits[digits_count - 1]);
+    _digits_count = static_cast<unsigned int>(digits_count);
+
+    return *this;
 }
 
-std::istream &operator>>(
-    std::istream &stream,
-    big_integer &value)
+big_integer &big_integer::assign_magnitude(
+    digit const *magnitude,
+    size_t digits_count,
+    bool is_negative)
 {
-    throw not_implemented("std::istream &operator>>(std::istream &, big_integer &)", "your code should be here...");
+    digits_count = significant_count(magnitude, digits_count);
+
+    // a zero sign digit on top keeps the magnitude from being read as negative
+    digits_buffer digits(digits_count + 1);
+    std::memcpy(digits.get(), magnitude, digits_count * sizeof(digit));
+    digits.get()[digits_count] = 0;
+
+    if (is_negative)
+    {
+        negate_digits(digits.get(), digits_count + 1);
+    }
+
+    return assign_digits(digits.get(), digits_count + 1);
 }
 
-[[nodiscard]] allocator *big_integer::get_allocator() const noexcept
+void big_integer::release_digits() noexcept
 {
-    throw not_implemented("allocator *big_integer::get_allocator() const noexcept", "your code should be here...");
-}
\ No newline at end of file
+    if (!is_inline())
+    {
+        if (_allocator == nullptr)
+        {
+            deallocate_digits(_other_digits, _digits_count - 1);
+        }
+        else
+        {
+            deallocate_with_guard(_other_digits);
+        }
+    }
+
+    // only the oldest digit is left
+    _digits_count = 1;
+}
@@ -0,0 +1,233 @@
+#include <functional>
+#include <new>
+#include <thread>
+
+#include "../include/digit_buffer_pool.h"
+
+namespace
+{
+
+    // trivially destructible, so it stays readable while other thread-local objects are destroyed
+    thread_local bool thread_cache_is_destroyed = false;
+
+}
+
+digit_buffer_pool::thread_cache::thread_cache() noexcept:
+    shard_index(digit_buffer_pool::instance()._next_shard_index.fetch_add(1, std::memory_order_relaxed) % shards_count)
+{
+    heads.fill(nullptr);
+    counts.fill(0);
+}
+
+digit_buffer_pool::thread_cache::~thread_cache() noexcept
+{
+    auto &pool = digit_buffer_pool::instance();
+    for (size_t size_class = min_size_class; size_class < size_classes_count; ++size_class)
+    {
+        pool.spill(*this, size_class, 0);
+    }
+
+    thread_cache_is_destroyed = true;
+}
+
+digit_buffer_pool::digit_buffer_pool() noexcept:
+    _next_shard_index(0)
+{
+    for (auto &target: _shards)
+    {
+        for (auto &head: target.heads)
+        {
+            head.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+unsigned int *digit_buffer_pool::allocate(
+    size_t words_count)
+{
+    auto const size_class = size_class_of(words_count);
+    if (size_class > max_size_class)
+    {
+        return static_cast<unsigned int *>(::operator new(words_count * sizeof(unsigned int)));
+    }
+
+    auto *cache = get_thread_cache();
+    if (cache != nullptr && (cache->heads[size_class] != nullptr || refill(*cache, size_class)))
+    {
+        auto *taken = cache->heads[size_class];
+        cache->heads[size_class] = taken->next;
+        --cache->counts[size_class];
+
+        return reinterpret_cast<unsigned int *>(taken);
+    }
+
+    return static_cast<unsigned int *>(::operator new(sizeof(unsigned int) << size_class));
+}
+
+void digit_buffer_pool::deallocate(
+    unsigned int *buffer,
+    size_t words_count) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return;
+    }
+
+    auto const size_class = size_class_of(words_count);
+    if (size_class > max_size_class)
+    {
+        ::operator delete(buffer);
+        return;
+    }
+
+    auto *released = reinterpret_cast<free_buffer *>(buffer);
+
+    auto *cache = get_thread_cache();
+    if (cache == nullptr)
+    {
+        // the thread is exiting: the buffer goes straight to a shard
+        released->next = nullptr;
+        push(std::hash<std::thread::id>()(std::this_thread::get_id()) % shards_count, size_class, released, released);
+        return;
+    }
+
+    released->next = cache->heads[size_class];
+    cache->heads[size_class] = released;
+
+    if (++cache->counts[size_class] > max_cached_count(size_class))
+    {
+        spill(*cache, size_class, cache->counts[size_class] / 2);
+    }
+}
+
+digit_buffer_pool &digit_buffer_pool::instance()
+{
+    // never destroyed: big_integer objects with static storage duration may release buffers after exit starts
+    static auto *pool = new digit_buffer_pool;
+
+    return *pool;
+}
+
+size_t digit_buffer_pool::size_class_of(
+    size_t words_count) noexcept
+{
+    size_t size_class = min_size_class;
+    while ((size_t(1) << size_class) < words_count)
+    {
+        ++size_class;
+    }
+
+    return size_class;
+}
+
+size_t digit_buffer_pool::max_cached_count(
+    size_t size_class) noexcept
+{
+    auto const buffer_size = sizeof(unsigned int) << size_class;
+
+    return buffer_size >= max_cached_bytes
+        ? 1
+        : max_cached_bytes / buffer_size;
+}
+
+digit_buffer_pool::thread_cache *digit_buffer_pool::get_thread_cache() noexcept
+{
+    if (thread_cache_is_destroyed)
+    {
+        return nullptr;
+    }
+
+    thread_local thread_cache cache;
+
+    return &cache;
+}
+
+void digit_buffer_pool::spill(
+    thread_cache &cache,
+    size_t size_class,
+    size_t kept_count) noexcept
+{
+    if (cache.counts[size_class] <= kept_count)
+    {
+        return;
+    }
+
+    free_buffer *last_kept = nullptr;
+    auto *first_spilled = cache.heads[size_class];
+    for (size_t i = 0; i < kept_count; ++i)
+    {
+        last_kept = first_spilled;
+        first_spilled = first_spilled->next;
+    }
+
+    auto *last_spilled = first_spilled;
+    while (last_spilled->next != nullptr)
+    {
+        last_spilled = last_spilled->next;
+    }
+
+    if (last_kept == nullptr)
+    {
+        cache.heads[size_class] = nullptr;
+    }
+    else
+    {
+        last_kept->next = nullptr;
+    }
+    cache.counts[size_class] = kept_count;
+
+    push(cache.shard_index, size_class, first_spilled, last_spilled);
+}
+
+bool digit_buffer_pool::refill(
+    thread_cache &cache,
+    size_t size_class) noexcept
+{
+    for (size_t i = 0; i < shards_count; ++i)
+    {
+        auto &head = _shards[(cache.shard_index + i) % shards_count].heads[size_class];
+        if (head.load(std::memory_order_relaxed) == nullptr)
+        {
+            continue;
+        }
+
+        auto *taken = head.exchange(nullptr, std::memory_order_acquire);
+        if (taken == nullptr)
+        {
+            continue;
+        }
+
+        size_t taken_count = 1;
+        auto *last_taken = taken;
+        while (last_taken->next != nullptr)
+        {
+            last_taken = last_taken->next;
+            ++taken_count;
+        }
+
+        last_taken->next = cache.heads[size_class];
+        cache.heads[size_class] = taken;
+        cache.counts[size_class] += taken_count;
+
+        return true;
+    }
+
+    return false;
+}
+
+void digit_buffer_pool::push(
+    size_t shard_index,
+    size_t size_class,
+    free_buffer *first,
+    free_buffer *last) noexcept
+{
+    auto &head = _shards[shard_index].heads[size_class];
+
+    // the links inside the batch are not read by anyone else, so a stale head can't corrupt the stack
+    auto *current = head.load(std::memory_order_relaxed);
+    do
+    {
+        last->next = current;
+    }
+    while (!head.compare_exchange_weak(current, first, std::memory_order_release, std::memory_order_relaxed));
+}
@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "../include/work_stealing_pool.h"
+
+namespace
+{
+
+    constexpr size_t no_worker = std::numeric_limits<size_t>::max();
+
+    // the index of the pool's worker running on the thread
+    thread_local size_t current_worker_index = no_worker;
+
+}
+
+work_stealing_pool::task_group::task_group(
+    work_stealing_pool &pool) noexcept:
+    _pool(pool),
+    _pending_count(0)
+{
+
+}
+
+work_stealing_pool::task_group::~task_group() noexcept
+{
+    // the tasks refer to the group and, mostly, to the data of the frame that made it
+    wait_for_tasks();
+}
+
+void work_stealing_pool::task_group::run(
+    std::function<void()> function)
+{
+    _pending_count.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+        _pool.push(task { std::move(function), this });
+    }
+    catch (...)
+    {
+        _pending_count.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+void work_stealing_pool::task_group::wait()
+{
+    wait_for_tasks();
+
+    if (_exception != nullptr)
+    {
+        auto const exception = _exception;
+        _exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void work_stealing_pool::task_group::wait_for_tasks() noexcept
+{
+    auto const deque_index = _pool.get_deque_index();
+    while (_pending_count.load(std::memory_order_acquire) != 0)
+    {
+        if (!_pool.run_one(deque_index))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+work_stealing_pool::work_stealing_pool():
+    _queued_count(0),
+    _is_stopping(false)
+{
+    start(0);
+}
+
+size_t work_stealing_pool::get_threads_count() const noexcept
+{
+    return _workers.size() + 1;
+}
+
+void work_stealing_pool::set_threads_count(
+    size_t threads_count)
+{
+    stop();
+    start(threads_count);
+}
+
+work_stealing_pool &work_stealing_pool::instance()
+{
+    // never destroyed: its workers sleep until the process ends, and a multiplication may run while exit destroys statics
+    static auto *pool = new work_stealing_pool;
+
+    return *pool;
+}
+
+void work_stealing_pool::start(
+    size_t threads_count)
+{
+    if (threads_count == 0)
+    {
+        threads_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    _is_stopping = false;
+
+    _deques.clear();
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        _deques.push_back(std::unique_ptr<task_deque>(new task_deque));
+    }
+
+    for (size_t i = 0; i + 1 < threads_count; ++i)
+    {
+        _workers.emplace_back(&work_stealing_pool::work, this, i);
+    }
+}
+
+void work_stealing_pool::stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+        _is_stopping = true;
+    }
+    _wakeup.notify_all();
+
+    for (auto &worker: _workers)
+    {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+size_t work_stealing_pool::get_deque_index() const noexcept
+{
+    return current_worker_index < _workers.size()
+        ? current_worker_index
+        : _workers.size();
+}
+
+void work_stealing_pool::push(
+    task queued)
+{
+    auto &target = *_deques[get_deque_index()];
+
+    _queued_count.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.tasks.push_back(std::move(queued));
+    }
+    catch (...)
+    {
+        _queued_count.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+
+    // a worker going to sleep checks the count under the mutex, so it either sees the task or gets the notification
+    {
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+    }
+    _wakeup.notify_one();
+}
+
+bool work_stealing_pool::run_one(
+    size_t deque_index) noexcept
+{
+    task taken;
+    auto is_taken = false;
+
+    for (size_t i = 0; i < _deques.size() && !is_taken; ++i)
+    {
+        auto &source = *_deques[(deque_index + i) % _deques.size()];
+
+        std::lock_guard<std::mutex> lock(source.mutex);
+        if (source.tasks.empty())
+        {
+            continue;
+        }
+
+        if (i == 0)
+        {
+            taken = std::move(source.tasks.back());
+            source.tasks.pop_back();
+        }
+        else
+        {
+            taken = std::move(source.tasks.front());
+            source.tasks.pop_front();
+        }
+        is_taken = true;
+    }
+
+    if (!is_taken)
+    {
+        return false;
+    }
+
+    _queued_count.fetch_sub(1, std::memory_order_relaxed);
+
+    auto *group = taken.group;
+    try
+    {
+        taken.function();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(group->_exception_mutex);
+        if (group->_exception == nullptr)
+        {
+            group->_exception = std::current_exception();
+        }
+    }
+
+    // the last access to the group: its owner may destroy it as soon as the count drops to zero
+    taken.function = nullptr;
+    group->_pending_count.fetch_sub(1, std::memory_order_release);
+
+    return true;
+}
+
+void work_stealing_pool::work(
+    size_t worker_index) noexcept
+{
+    current_worker_index = worker_index;
+
+    while (true)
+    {
+        if (run_one(worker_index))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleep_mutex);
+        _wakeup.wait(lock, [this]()
+        {
+            return _is_stopping || _queued_count.load(std::memory_order_relaxed) != 0;
+        });
+
+        if (_is_stopping)
+        {
+            break;
+        }
+    }
+
+    current_worker_index = no_worker;
+}
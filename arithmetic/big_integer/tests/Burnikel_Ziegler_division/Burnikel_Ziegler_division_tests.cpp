@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <random>
 #include <sstream>
 
 #include <big_integer.h>
@@ -164,6 +165,78 @@ TEST(positive_tests, test7)
     delete logger;
 }
 
+big_integer random_big_integer(
+    std::mt19937_64 &engine,
+    size_t hexadecimal_digits_count)
+{
+    static char const symbols[] = "0123456789abcdef";
+
+    std::string hexadecimal(hexadecimal_digits_count, '0');
+    for (auto &symbol: hexadecimal)
+    {
+        symbol = symbols[engine() % 16];
+    }
+
+    return big_integer((engine() % 2 == 0 ? "-" : "") + hexadecimal, 16);
+}
+
+TEST(positive_tests, recursive_quotients_match_trivial_division)
+{
+    std::mt19937_64 engine(41);
+
+    // divisors from below the recursion threshold up to several levels, with dividends from as long to many blocks longer
+    for (auto const &lengths: std::vector<std::pair<size_t, size_t>> { { 300, 200 }, { 2001, 1000 }, { 6000, 2999 }, { 30011, 4007 }, { 12000, 11997 } })
+    {
+        auto const dividend = random_big_integer(engine, lengths.first);
+        auto const divisor = random_big_integer(engine, lengths.second);
+
+        for (auto rule: { big_integer::multiplication_rule::trivial, big_integer::multiplication_rule::Karatsuba, big_integer::multiplication_rule::automatic })
+        {
+            EXPECT_TRUE(big_integer::divide(dividend, divisor, nullptr, big_integer::division_rule::BurnikelZiegler, rule)
+                == big_integer::divide(dividend, divisor));
+            EXPECT_TRUE(big_integer::modulo(dividend, divisor, nullptr, big_integer::division_rule::BurnikelZiegler, rule)
+                == big_integer::modulo(dividend, divisor));
+        }
+    }
+}
+
+TEST(positive_tests, remainders_of_exact_multiples_are_zero)
+{
+    std::mt19937_64 engine(43);
+
+    // quotients with long runs of all-ones digits take the branch of equal top halves
+    auto const divisor = random_big_integer(engine, 3000);
+    big_integer const one("1");
+    auto const quotient = (one << 8000) - one;
+    auto const dividend = divisor * quotient;
+
+    EXPECT_TRUE(big_integer::divide(dividend, divisor, nullptr, big_integer::division_rule::BurnikelZiegler,
+        big_integer::multiplication_rule::Karatsuba) == quotient);
+    EXPECT_TRUE(big_integer::modulo(dividend, divisor, nullptr, big_integer::division_rule::BurnikelZiegler,
+        big_integer::multiplication_rule::Karatsuba) == big_integer("0"));
+    EXPECT_TRUE(big_integer::divide(dividend - one, divisor, nullptr, big_integer::division_rule::BurnikelZiegler,
+        big_integer::multiplication_rule::Karatsuba) == big_integer::divide(dividend - one, divisor));
+}
+
+TEST(positive_tests, divmod_matches_divide_and_modulo)
+{
+    std::mt19937_64 engine(47);
+
+    for (auto const &lengths: std::vector<std::pair<size_t, size_t>> { { 20, 30 }, { 40, 17 }, { 3000, 1000 }, { 12000, 4001 } })
+    {
+        auto const dividend = random_big_integer(engine, lengths.first);
+        auto const divisor = random_big_integer(engine, lengths.second);
+
+        for (auto rule: { big_integer::division_rule::trivial, big_integer::division_rule::Newton, big_integer::division_rule::BurnikelZiegler })
+        {
+            auto const result = big_integer::divmod(dividend, divisor, nullptr, rule, big_integer::multiplication_rule::Karatsuba);
+
+            EXPECT_TRUE(result.first == big_integer::divide(dividend, divisor));
+            EXPECT_TRUE(result.second == big_integer::modulo(dividend, divisor));
+        }
+    }
+}
+
 int main(
     int argc,
     char **argv)
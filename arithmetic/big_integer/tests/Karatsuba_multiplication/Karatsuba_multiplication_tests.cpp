@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <random>
 #include <sstream>
 
 #include <big_integer.h>
@@ -165,6 +166,69 @@ TEST(positive_tests, test7)
     delete logger;
 }
 
+big_integer random_big_integer(
+    std::mt19937_64 &engine,
+    size_t hexadecimal_digits_count)
+{
+    static char const symbols[] = "0123456789abcdef";
+
+    std::string hexadecimal(hexadecimal_digits_count, '0');
+    for (auto &symbol: hexadecimal)
+    {
+        symbol = symbols[engine() % 16];
+    }
+
+    return big_integer((engine() % 2 == 0 ? "-" : "") + hexadecimal, 16);
+}
+
+TEST(positive_tests, recursive_products_match_trivial_multiplication)
+{
+    std::mt19937_64 engine(7);
+
+    // from below the schoolbook threshold up to several levels of recursion, odd lengths included
+    for (size_t hexadecimal_digits_count: { 100, 511, 1024, 3001, 8192, 20011 })
+    {
+        auto const first = random_big_integer(engine, hexadecimal_digits_count);
+        auto const second = random_big_integer(engine, hexadecimal_digits_count);
+
+        EXPECT_TRUE(big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::Karatsuba)
+            == big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial));
+    }
+}
+
+TEST(positive_tests, unbalanced_products_match_trivial_multiplication)
+{
+    std::mt19937_64 engine(11);
+
+    for (auto const &lengths: std::vector<std::pair<size_t, size_t>> { { 20000, 900 }, { 9000, 5000 }, { 7, 12000 }, { 4096, 2049 } })
+    {
+        auto const first = random_big_integer(engine, lengths.first);
+        auto const second = random_big_integer(engine, lengths.second);
+
+        EXPECT_TRUE(big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::Karatsuba)
+            == big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial));
+    }
+}
+
+TEST(positive_tests, squares_match_products_of_distinct_operands)
+{
+    std::mt19937_64 engine(19);
+
+    // x * (x + 1) - x does not take the squaring path
+    for (size_t hexadecimal_digits_count: { 1, 17, 100, 511, 1024, 3001, 20011 })
+    {
+        auto const value = random_big_integer(engine, hexadecimal_digits_count);
+        auto const expected = big_integer::multiply(value, value + big_integer("1"), nullptr, big_integer::multiplication_rule::trivial) - value;
+
+        EXPECT_TRUE(big_integer::multiply(value, value, nullptr, big_integer::multiplication_rule::Karatsuba) == expected);
+        EXPECT_TRUE(value * value == expected);
+
+        auto square = value;
+        big_integer::multiply(square, square, nullptr, big_integer::multiplication_rule::Karatsuba);
+        EXPECT_TRUE(square == expected);
+    }
+}
+
 int main(
     int argc,
     char **argv)
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <random>
 #include <sstream>
 
 #include <big_integer.h>
@@ -164,6 +165,66 @@ TEST(positive_tests, test7)
     delete logger;
 }
 
+big_integer random_big_integer(
+    std::mt19937_64 &engine,
+    size_t hexadecimal_digits_count)
+{
+    static char const symbols[] = "0123456789abcdef";
+
+    std::string hexadecimal(hexadecimal_digits_count, '0');
+    for (auto &symbol: hexadecimal)
+    {
+        symbol = symbols[engine() % 16];
+    }
+
+    return big_integer((engine() % 2 == 0 ? "-" : "") + hexadecimal, 16);
+}
+
+TEST(positive_tests, reciprocal_quotients_match_trivial_division)
+{
+    std::mt19937_64 engine(31);
+
+    // divisors from below the Newton threshold up to several levels of the reciprocal's recursion
+    for (auto const &lengths: std::vector<std::pair<size_t, size_t>> { { 200, 90 }, { 8000, 4000 }, { 20000, 3001 }, { 30011, 10007 } })
+    {
+        auto const dividend = random_big_integer(engine, lengths.first);
+        auto const divisor = random_big_integer(engine, lengths.second);
+
+        for (auto rule: { big_integer::multiplication_rule::trivial, big_integer::multiplication_rule::Karatsuba, big_integer::multiplication_rule::automatic })
+        {
+            EXPECT_TRUE(big_integer::divide(dividend, divisor, nullptr, big_integer::division_rule::Newton, rule)
+                == big_integer::divide(dividend, divisor));
+            EXPECT_TRUE(big_integer::modulo(dividend, divisor, nullptr, big_integer::division_rule::Newton, rule)
+                == big_integer::modulo(dividend, divisor));
+        }
+    }
+}
+
+TEST(positive_tests, precomputed_divisor_is_reused)
+{
+    std::mt19937_64 engine(37);
+
+    for (size_t hexadecimal_digits_count: { 3, 30, 4003 })
+    {
+        auto const divisor = random_big_integer(engine, hexadecimal_digits_count);
+        big_integer::precomputed_divisor const prepared(divisor, big_integer::multiplication_rule::automatic);
+
+        // dividends shorter than the divisor, about as long and twice as long, of both signs
+        for (size_t i = 0; i < 12; ++i)
+        {
+            auto const dividend = random_big_integer(engine, hexadecimal_digits_count * (i % 3) + 1 + i);
+
+            EXPECT_TRUE(big_integer::divide(dividend, prepared) == big_integer::divide(dividend, divisor));
+            EXPECT_TRUE(big_integer::modulo(dividend, prepared) == big_integer::modulo(dividend, divisor));
+        }
+    }
+}
+
+TEST(positive_tests, zero_divisor_is_not_precomputed)
+{
+    EXPECT_THROW(big_integer::precomputed_divisor(big_integer("0")), std::logic_error);
+}
+
 int main(
     int argc,
     char **argv)
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <random>
 #include <sstream>
 
 #include <big_integer.h>
@@ -165,6 +166,64 @@ TEST(positive_tests, test7)
     delete logger;
 }
 
+big_integer random_big_integer(
+    std::mt19937_64 &engine,
+    size_t hexadecimal_digits_count)
+{
+    static char const symbols[] = "0123456789abcdef";
+
+    std::string hexadecimal(hexadecimal_digits_count, '0');
+    for (auto &symbol: hexadecimal)
+    {
+        symbol = symbols[engine() % 16];
+    }
+
+    return big_integer((engine() % 2 == 0 ? "-" : "") + hexadecimal, 16);
+}
+
+TEST(positive_tests, transformed_products_match_trivial_multiplication)
+{
+    std::mt19937_64 engine(5);
+
+    // above the transform threshold for both limb sizes, balanced and not
+    for (auto const &lengths: std::vector<std::pair<size_t, size_t>> { { 150000, 150000 }, { 160001, 140003 }, { 300000, 60000 } })
+    {
+        auto const first = random_big_integer(engine, lengths.first);
+        auto const second = random_big_integer(engine, lengths.second);
+
+        EXPECT_TRUE(big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::SchonhageStrassen)
+            == big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial));
+    }
+}
+
+TEST(positive_tests, largest_convolution_coefficients_are_recovered)
+{
+    // all words are 2^32 - 1, so every coefficient is as large as the operands' length allows
+    big_integer const first(std::string(200000, 'f'), 16);
+    big_integer const second(std::string(170000, 'f'), 16);
+
+    EXPECT_TRUE(big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::SchonhageStrassen)
+        == big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial));
+}
+
+TEST(positive_tests, squares_match_products_of_distinct_operands)
+{
+    std::mt19937_64 engine(23);
+
+    // x * (x + 1) - x does not take the squaring path
+    for (size_t hexadecimal_digits_count: { 100, 60000, 200003 })
+    {
+        auto const value = random_big_integer(engine, hexadecimal_digits_count);
+        auto const expected = big_integer::multiply(value, value + big_integer("1"), nullptr, big_integer::multiplication_rule::trivial) - value;
+
+        EXPECT_TRUE(big_integer::multiply(value, value, nullptr, big_integer::multiplication_rule::SchonhageStrassen) == expected);
+
+        auto square = value;
+        big_integer::multiply(square, square, nullptr, big_integer::multiplication_rule::SchonhageStrassen);
+        EXPECT_TRUE(square == expected);
+    }
+}
+
 int main(
     int argc,
     char **argv)
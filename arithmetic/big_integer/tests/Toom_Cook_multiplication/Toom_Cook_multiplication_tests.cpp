@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+
+#include <big_integer.h>
+#include <client_logger.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+
+    logger *built_logger = builder->build();
+
+    delete builder;
+
+    return built_logger;
+}
+
+TEST(positive_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    big_integer bigint_1("-28958888309635818");
+    big_integer bigint_2("-234567");
+    big_integer::multiply(bigint_1, bigint_2, nullptr, big_integer::multiplication_rule::Toom3);
+
+    EXPECT_TRUE((std::ostringstream() << bigint_1).str() == "6792799554126344920806");
+
+    delete logger;
+}
+
+TEST(positive_tests, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    big_integer bigint_1("999999999999999999999999999977777");
+    big_integer bigint_2("-0000000000000000000000000000000000000000000000000059");
+    big_integer::multiply(bigint_1, bigint_2, nullptr, big_integer::multiplication_rule::Toom4);
+
+    EXPECT_TRUE((std::ostringstream() << bigint_1).str() == "-58999999999999999999999999998688843");
+
+    delete logger;
+}
+
+TEST(positive_tests, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    big_integer bigint_1("123424353464389587244387927589346894576464343235445645674563532464675467425");
+    big_integer bigint_2("2354893245937465784937542389428935349086840957804985309763636567574564");
+    big_integer::multiply(bigint_1, bigint_2, nullptr, big_integer::multiplication_rule::automatic);
+
+    EXPECT_TRUE((std::ostringstream() << bigint_1).str() == "290651176357489495451049958587923972328418314663424320128873904703658883667429195585130334492391519870913575716570325570910803505581125240577700");
+
+    delete logger;
+}
+
+TEST(positive_tests, test4)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    big_integer bigint_1("20944325634363");
+    big_integer bigint_2("0");
+    big_integer::multiply(bigint_1, bigint_2, nullptr, big_integer::multiplication_rule::Toom4);
+
+    EXPECT_TRUE((std::ostringstream() << bigint_1).str() == "0");
+
+    delete logger;
+}
+
+big_integer random_big_integer(
+    std::mt19937_64 &engine,
+    size_t hexadecimal_digits_count)
+{
+    static char const symbols[] = "0123456789abcdef";
+
+    std::string hexadecimal(hexadecimal_digits_count, '0');
+    for (auto &symbol: hexadecimal)
+    {
+        symbol = symbols[engine() % 16];
+    }
+
+    return big_integer((engine() % 2 == 0 ? "-" : "") + hexadecimal, 16);
+}
+
+TEST(positive_tests, evaluated_products_match_trivial_multiplication)
+{
+    std::mt19937_64 engine(13);
+
+    // from below the Toom-3 threshold up to the recursion of Toom-4 into itself, odd lengths included
+    for (size_t hexadecimal_digits_count: { 1000, 3001, 8192, 20011, 60000 })
+    {
+        auto const first = random_big_integer(engine, hexadecimal_digits_count);
+        auto const second = random_big_integer(engine, hexadecimal_digits_count);
+        auto const expected = big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial);
+
+        for (auto rule: { big_integer::multiplication_rule::Toom3, big_integer::multiplication_rule::Toom4, big_integer::multiplication_rule::automatic })
+        {
+            EXPECT_TRUE(big_integer::multiply(first, second, nullptr, rule) == expected);
+        }
+    }
+}
+
+TEST(positive_tests, unbalanced_products_match_trivial_multiplication)
+{
+    std::mt19937_64 engine(17);
+
+    // the shorter operand lacks pieces of one split or both, and Toom-4 falls back to Toom-3 or Karatsuba
+    for (auto const &lengths: std::vector<std::pair<size_t, size_t>> { { 40000, 29000 }, { 40000, 21000 }, { 40000, 9000 }, { 7, 30000 } })
+    {
+        auto const first = random_big_integer(engine, lengths.first);
+        auto const second = random_big_integer(engine, lengths.second);
+        auto const expected = big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial);
+
+        for (auto rule: { big_integer::multiplication_rule::Toom3, big_integer::multiplication_rule::Toom4, big_integer::multiplication_rule::automatic })
+        {
+            EXPECT_TRUE(big_integer::multiply(first, second, nullptr, rule) == expected);
+        }
+    }
+}
+
+TEST(positive_tests, squares_match_products_of_distinct_operands)
+{
+    std::mt19937_64 engine(29);
+
+    // x * (x + 1) - x does not take the squaring path
+    for (size_t hexadecimal_digits_count: { 1000, 8192, 60001 })
+    {
+        auto const value = random_big_integer(engine, hexadecimal_digits_count);
+        auto const expected = big_integer::multiply(value, value + big_integer("1"), nullptr, big_integer::multiplication_rule::trivial) - value;
+
+        EXPECT_TRUE(big_integer::multiply(value, value, nullptr, big_integer::multiplication_rule::Toom4) == expected);
+
+        auto square = value;
+        big_integer::multiply(square, square, nullptr, big_integer::multiplication_rule::Toom4);
+        EXPECT_TRUE(square == expected);
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
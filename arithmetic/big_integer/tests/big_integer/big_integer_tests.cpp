@@ -28,6 +28,33 @@ logger *create_logger(
     return built_logger;
 }
 
+class counting_allocator final:
+    public allocator
+{
+
+public:
+
+    size_t allocations_count = 0;
+
+public:
+
+    void *allocate(
+        size_t value_size,
+        size_t values_count) override
+    {
+        ++allocations_count;
+
+        return ::operator new(value_size * values_count);
+    }
+
+    void deallocate(
+        void *at) override
+    {
+        ::operator delete(at);
+    }
+
+};
+
 TEST(positive_tests, test1)
 {
     logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
@@ -207,6 +234,150 @@ TEST(positive_tests, test9)
     delete logger;
 }
 
+TEST(positive_tests, small_values_are_kept_inline)
+{
+    counting_allocator allocator;
+
+    big_integer bigint_1("12345678901234567890123", 10, &allocator);
+    big_integer bigint_2("-9876543210987654321", 10, &allocator);
+    big_integer bigint_3("4294967311", 10, &allocator);
+
+    auto result = bigint_1 + bigint_2;
+    result -= bigint_3;
+    result = big_integer::multiply(result, bigint_3) / bigint_2;
+    result %= bigint_3;
+    result <<= 40;
+    result >>= 3;
+    result = -result;
+
+    std::stringstream ss;
+    ss << result;
+
+    EXPECT_EQ(ss.str(), "590289088219491336192");
+    EXPECT_EQ(allocator.allocations_count, 0);
+}
+
+TEST(positive_tests, values_are_promoted_past_128_bits)
+{
+    counting_allocator allocator;
+
+    big_integer max_inline("170141183460469231731687303715884105727", 10, &allocator);
+    big_integer const one("1");
+
+    auto promoted = max_inline + one;
+    EXPECT_GT(allocator.allocations_count, 0);
+
+    std::stringstream ss;
+    ss << promoted << ' ' << -promoted - one << ' ' << promoted - one;
+
+    EXPECT_EQ(ss.str(), "170141183460469231731687303715884105728 -170141183460469231731687303715884105729 170141183460469231731687303715884105727");
+    EXPECT_TRUE(promoted - one == max_inline);
+    EXPECT_TRUE(promoted > max_inline);
+}
+
+TEST(positive_tests, digits_are_read_as_32_bit_words)
+{
+    big_integer bigint_1(std::vector<int> { -1 });
+    big_integer bigint_2(std::vector<int> { 0, 1 });
+    big_integer bigint_3(std::vector<int> { 1, 2, -1 });
+
+    std::stringstream ss;
+    ss << bigint_1 << ' ' << bigint_2 << ' ' << bigint_3;
+
+    EXPECT_EQ(ss.str(), "-1 4294967296 -18446744065119617023");
+}
+
+TEST(positive_tests, power_of_two_bases_map_to_bits)
+{
+    big_integer bigint_1("-ff00000000000000000000000000000001", 16);
+    big_integer bigint_2("-1vo0000000000000000000000001", 32);
+    big_integer bigint_3(
+        "-1111111100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001",
+        2);
+
+    std::stringstream ss;
+    ss << bigint_1 << ' ' << std::hex << bigint_1 << ' ' << std::uppercase << -bigint_1 << ' ' << std::oct << -bigint_1;
+
+    EXPECT_EQ(ss.str(), "-86772003564839308183160524895100893921281 -ff00000000000000000000000000000001 FF00000000000000000000000000000001 "
+        "1774000000000000000000000000000000000000000001");
+    EXPECT_TRUE(bigint_1 == bigint_2);
+    EXPECT_TRUE(bigint_1 == bigint_3);
+}
+
+TEST(positive_tests, long_values_round_trip_through_strings)
+{
+    // past the chunk by chunk conversion, with digits that are not all zeros
+    std::string decimal(30000, '0');
+    for (size_t i = 0; i < decimal.size(); ++i)
+    {
+        decimal[i] = static_cast<char>('0' + (i * i + 7 * i + 1) % 10);
+    }
+
+    big_integer const value(decimal);
+    std::stringstream ss;
+    ss << -value;
+    EXPECT_EQ(ss.str(), "-" + decimal);
+
+    big_integer const power_10000("1" + std::string(10000, '0'));
+    big_integer const power_20000("1" + std::string(20000, '0'));
+    EXPECT_TRUE(big_integer::multiply(power_10000, power_10000) == power_20000);
+
+    big_integer const power_7("1" + std::string(5000, '0'), 7);
+    big_integer const root_7("1" + std::string(2500, '0'), 7);
+    EXPECT_TRUE(big_integer::multiply(root_7, root_7) == power_7);
+}
+
+TEST(positive_tests, fused_operations_match_operators)
+{
+    big_integer const a("-123456789012345678901234567890123456789012345678901234567890");
+    big_integer const b("98765432109876543210987654321098765432109876543210");
+    big_integer const c("-5555555555555555555555555555555555555555555555555555555555555555555555555555");
+
+    for (auto rule: { big_integer::multiplication_rule::trivial, big_integer::multiplication_rule::Karatsuba })
+    {
+        auto sum = c;
+        EXPECT_TRUE(big_integer::addmul(sum, a, b, nullptr, rule) == c + a * b);
+
+        auto difference = c;
+        EXPECT_TRUE(big_integer::submul(difference, a, b, nullptr, rule) == c - a * b);
+
+        big_integer result("0");
+        EXPECT_TRUE(big_integer::mul_add(result, a, b, c, nullptr, rule) == a * b + c);
+
+        // the destination may be any operand
+        auto square = a;
+        EXPECT_TRUE(big_integer::mul_add(square, square, square, square, nullptr, rule) == a * a + a);
+    }
+
+    // inline values and a result that overflows them
+    big_integer value("3");
+    EXPECT_TRUE(big_integer::addmul(value, big_integer("4"), big_integer("5")) == big_integer("23"));
+    big_integer const large("85070591730234615865843651857942052864");
+    EXPECT_TRUE(big_integer::submul(value, large, large) == big_integer("23") - large * large);
+}
+
+TEST(positive_tests, bitwise_operations_of_long_values)
+{
+    big_integer const one("1");
+    auto const positive = (one << 70000) - one;
+    auto const negative = big_integer("12345") - (big_integer("3") << 50000);
+
+    EXPECT_TRUE((positive & ~positive) == big_integer("0"));
+    EXPECT_TRUE((positive | ~positive) == big_integer("-1"));
+    EXPECT_TRUE(~negative == -negative - one);
+    EXPECT_TRUE((positive ^ negative) == (positive | negative) - (positive & negative));
+    EXPECT_TRUE(((positive ^ negative) ^ negative) == positive);
+
+    // the shorter negative operand is sign-extended over the longer one
+    EXPECT_TRUE((positive & negative) + (positive & ~negative) == positive);
+
+    EXPECT_TRUE((positive << 13) == positive * big_integer("8192"));
+    EXPECT_TRUE(((negative << 1000) >> 1000) == negative);
+    EXPECT_TRUE((negative >> 13) == big_integer::divide(negative - big_integer("8191"), big_integer("8192")));
+    EXPECT_TRUE((negative >> 70000) == big_integer("-1"));
+    EXPECT_TRUE((positive >> 69999) == one);
+}
+
 int main(
     int argc,
     char **argv)
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <big_integer.h>
+#include <digit_buffer_pool.h>
+
+TEST(digit_buffer_pool_tests, released_buffer_is_reused_for_the_same_size_class)
+{
+    auto &pool = digit_buffer_pool::instance();
+
+    auto *first = pool.allocate(13);
+    pool.deallocate(first, 13);
+
+    // 13 and 16 words share the 16 words class
+    auto *second = pool.allocate(16);
+    EXPECT_EQ(first, second);
+
+    auto *third = pool.allocate(17);
+    EXPECT_NE(second, third);
+
+    pool.deallocate(second, 16);
+    pool.deallocate(third, 17);
+}
+
+TEST(digit_buffer_pool_tests, buffers_of_exited_threads_are_taken_by_others)
+{
+    auto &pool = digit_buffer_pool::instance();
+    size_t const words_count = 1024;
+    size_t const buffers_count = 64;
+
+    std::set<unsigned int *> released;
+    std::thread([&pool, &released]()
+    {
+        std::vector<unsigned int *> buffers;
+        for (size_t i = 0; i < buffers_count; ++i)
+        {
+            buffers.push_back(pool.allocate(words_count));
+        }
+        for (auto *buffer: buffers)
+        {
+            released.insert(buffer);
+            pool.deallocate(buffer, words_count);
+        }
+    }).join();
+
+    std::vector<unsigned int *> taken;
+    for (size_t i = 0; i < buffers_count; ++i)
+    {
+        taken.push_back(pool.allocate(words_count));
+    }
+
+    size_t reused_count = 0;
+    for (auto *buffer: taken)
+    {
+        reused_count += released.count(buffer);
+        pool.deallocate(buffer, words_count);
+    }
+    EXPECT_EQ(reused_count, buffers_count);
+}
+
+TEST(digit_buffer_pool_tests, values_stay_intact_when_threads_exchange_buffers)
+{
+    big_integer const first("123424353464389587244387927589346894576464343235445645674563532464675467425");
+    big_integer const second("2354893245937465784937542389428935349086840957804985309763636567574564");
+    std::string const product = "290651176357489495451049958587923972328418314663424320128873904703658883667429195585130334492391519870913575716570325570910803505581125240577700";
+
+    size_t const threads_count = 4;
+    std::vector<size_t> errors_counts(threads_count, 0);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        threads.emplace_back([&first, &second, &product, &errors_count = errors_counts[i]]()
+        {
+            // every operation takes and returns scratch and result buffers of a few size classes
+            for (size_t j = 0; j < 2000; ++j)
+            {
+                auto const multiplied = first * second;
+                auto const divided = multiplied / second;
+                auto const remainder = multiplied % first;
+
+                std::ostringstream printed;
+                printed << multiplied;
+                errors_count += printed.str() != product || divided != first || remainder != big_integer("0")
+                    ? 1
+                    : 0;
+            }
+        });
+    }
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+
+    for (auto errors_count: errors_counts)
+    {
+        EXPECT_EQ(errors_count, 0);
+    }
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+
+#include <big_integer.h>
+#include <client_logger.h>
+#include <operation_not_supported.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+    
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+    
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+    
+    logger *built_logger = builder->build();
+    
+    delete builder;
+    
+    return built_logger;
+}
+TEST(positive_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    auto const result = big_integer::pow_mod(big_integer("4"), big_integer("13"), big_integer("497"));
+    
+    EXPECT_TRUE((std::ostringstream() << result).str() == "445");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const modulus("170141183460469231731687303715884105727");
+    auto const result = big_integer::pow_mod(big_integer("123456789"), big_integer("987654321"), modulus);
+    
+    EXPECT_TRUE((std::ostringstream() << result).str() == "54332918125842946475806989909357123968");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    auto const result = big_integer::pow_mod(big_integer("-987654321987654321"), big_integer("65537"),
+        big_integer("10000000000000000000000000000000000000000"));
+    
+    EXPECT_TRUE((std::ostringstream() << result).str() == "1930487368538634926828568190593623911759");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test4)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_integer const one("1");
+    auto const modulus = (one << 127) - one;
+    auto const result = big_integer::pow_mod(big_integer("2"), modulus - one, modulus);
+    
+    EXPECT_TRUE((std::ostringstream() << result).str() == "1");
+    
+    delete logger;
+}
+
+big_integer random_big_integer(
+    std::mt19937_64 &engine,
+    size_t hexadecimal_digits_count)
+{
+    static char const symbols[] = "0123456789abcdef";
+
+    std::string hexadecimal(hexadecimal_digits_count, '0');
+    for (auto &symbol: hexadecimal)
+    {
+        symbol = symbols[engine() % 16];
+    }
+
+    return big_integer(hexadecimal, 16);
+}
+
+big_integer power_by_squaring(
+    big_integer const &base,
+    big_integer const &exponent,
+    big_integer const &modulus)
+{
+    big_integer const zero("0");
+    big_integer const one("1");
+
+    std::vector<bool> bits;
+    for (auto rest = exponent; rest != zero; rest >>= 1)
+    {
+        bits.push_back((rest & one) == one);
+    }
+
+    auto result = one;
+    for (auto bit = bits.size(); bit-- > 0;)
+    {
+        result = result * result % modulus;
+        if (bits[bit])
+        {
+            result = result * base % modulus;
+        }
+    }
+
+    return result;
+}
+
+TEST(positive_tests, windows_match_square_and_multiply)
+{
+    std::mt19937_64 engine(53);
+
+    // odd moduli take Montgomery's reduction and even ones Barrett's, from one limb to past the Karatsuba threshold
+    for (size_t length: { 1, 15, 16, 17, 64, 300, 1000 })
+    {
+        auto const base = random_big_integer(engine, 2 * length);
+        auto const exponent = random_big_integer(engine, 64);
+        auto modulus = random_big_integer(engine, length) | big_integer("1");
+        auto const expected_odd = power_by_squaring(base % modulus, exponent, modulus);
+
+        EXPECT_TRUE(big_integer::pow_mod(base, exponent, modulus) == expected_odd);
+        EXPECT_TRUE(big_integer::Barrett_context(modulus).pow(base, exponent) == expected_odd);
+
+        modulus += big_integer("1");
+        EXPECT_TRUE(big_integer::pow_mod(base, exponent, modulus) == power_by_squaring(base % modulus, exponent, modulus));
+    }
+}
+
+TEST(positive_tests, Montgomery_form_round_trips)
+{
+    std::mt19937_64 engine(59);
+
+    auto const modulus = random_big_integer(engine, 200) | big_integer("1");
+    auto const first = random_big_integer(engine, 190);
+    auto const second = random_big_integer(engine, 300);
+    big_integer::Montgomery_context const context(modulus);
+
+    EXPECT_TRUE(context.from_form(context.to_form(first)) == first);
+    EXPECT_TRUE(context.from_form(context.multiply(context.to_form(first), context.to_form(second))) == first * second % modulus);
+    EXPECT_TRUE(big_integer::Barrett_context(modulus).multiply(first, second) == first * second % modulus);
+}
+
+TEST(falsePositiveTests, test1)
+{
+    EXPECT_THROW(big_integer::pow_mod(big_integer("2"), big_integer("3"), big_integer("0")), std::logic_error);
+    EXPECT_THROW(big_integer::pow_mod(big_integer("2"), big_integer("-3"), big_integer("7")), std::logic_error);
+    EXPECT_THROW(big_integer::Montgomery_context(big_integer("10")), std::logic_error);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    
+    return RUN_ALL_TESTS();
+}
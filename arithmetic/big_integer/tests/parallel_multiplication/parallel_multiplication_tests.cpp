@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include <big_integer.h>
+#include <client_logger.h>
+#include <work_stealing_pool.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+
+    logger *built_logger = builder->build();
+
+    delete builder;
+
+    return built_logger;
+}
+
+big_integer random_big_integer(
+    std::mt19937_64 &engine,
+    size_t hexadecimal_digits_count)
+{
+    static char const symbols[] = "0123456789abcdef";
+
+    std::string hexadecimal(hexadecimal_digits_count, '0');
+    for (auto &symbol: hexadecimal)
+    {
+        symbol = symbols[engine() % 16];
+    }
+
+    return big_integer(hexadecimal, 16);
+}
+
+TEST(positive_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    big_integer bigint_1("-5899999999999999999999999999999");
+    big_integer bigint_2("10000");
+    big_integer::multiply(bigint_1, bigint_2, nullptr, big_integer::multiplication_rule::parallel);
+
+    EXPECT_TRUE((std::ostringstream() << bigint_1).str() == "-58999999999999999999999999999990000");
+
+    delete logger;
+}
+
+TEST(positive_tests, split_products_match_trivial_multiplication)
+{
+    work_stealing_pool::instance().set_threads_count(4);
+    std::mt19937_64 engine(7);
+
+    // above the parallel threshold and below the transform's for 64-bit limbs, balanced and not
+    for (auto const &lengths: std::vector<std::pair<size_t, size_t>> { { 100000, 100000 }, { 100001, 70003 }, { 300000, 40000 } })
+    {
+        auto const first = random_big_integer(engine, lengths.first);
+        auto const second = random_big_integer(engine, lengths.second);
+
+        EXPECT_TRUE(big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::parallel)
+            == big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial));
+    }
+}
+
+TEST(positive_tests, transformed_products_match_automatic_multiplication)
+{
+    work_stealing_pool::instance().set_threads_count(4);
+    std::mt19937_64 engine(11);
+
+    // above the transform threshold for both limb sizes
+    for (auto const &lengths: std::vector<std::pair<size_t, size_t>> { { 400000, 400000 }, { 450001, 390007 } })
+    {
+        auto const first = random_big_integer(engine, lengths.first);
+        auto const second = random_big_integer(engine, lengths.second);
+
+        EXPECT_TRUE(big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::parallel)
+            == big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::automatic));
+    }
+}
+
+TEST(positive_tests, squares_match_products_of_distinct_operands)
+{
+    work_stealing_pool::instance().set_threads_count(4);
+    std::mt19937_64 engine(13);
+
+    // x * (x + 1) - x does not take the squaring path
+    for (size_t hexadecimal_digits_count: { 100003, 400000 })
+    {
+        auto const value = random_big_integer(engine, hexadecimal_digits_count);
+        auto const expected = big_integer::multiply(value, value + big_integer("1"), nullptr, big_integer::multiplication_rule::automatic) - value;
+
+        auto square = value;
+        big_integer::multiply(square, square, nullptr, big_integer::multiplication_rule::parallel);
+        EXPECT_TRUE(square == expected);
+    }
+}
+
+TEST(positive_tests, one_thread_multiplies_alone)
+{
+    work_stealing_pool::instance().set_threads_count(1);
+    std::mt19937_64 engine(17);
+
+    EXPECT_EQ(work_stealing_pool::instance().get_threads_count(), size_t(1));
+
+    auto const first = random_big_integer(engine, 100000);
+    auto const second = random_big_integer(engine, 90000);
+
+    EXPECT_TRUE(big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::parallel)
+        == big_integer::multiply(first, second, nullptr, big_integer::multiplication_rule::trivial));
+}
+
+TEST(positive_tests, Newton_division_multiplies_in_parallel)
+{
+    work_stealing_pool::instance().set_threads_count(3);
+    std::mt19937_64 engine(19);
+
+    auto const dividend = random_big_integer(engine, 200000);
+    auto const divisor = random_big_integer(engine, 90000);
+
+    EXPECT_TRUE(big_integer::divide(dividend, divisor, nullptr, big_integer::division_rule::Newton, big_integer::multiplication_rule::parallel)
+        == big_integer::divide(dividend, divisor));
+}
+
+TEST(positive_tests, nested_task_groups_run_every_task)
+{
+    auto &pool = work_stealing_pool::instance();
+    pool.set_threads_count(4);
+
+    std::atomic<size_t> runs_count(0);
+    {
+        work_stealing_pool::task_group group(pool);
+        for (size_t i = 0; i < 16; ++i)
+        {
+            group.run([&pool, &runs_count]()
+            {
+                work_stealing_pool::task_group nested(pool);
+                for (size_t j = 0; j < 16; ++j)
+                {
+                    nested.run([&runs_count]()
+                    {
+                        runs_count.fetch_add(1);
+                    });
+                }
+                nested.wait();
+            });
+        }
+        group.wait();
+    }
+
+    EXPECT_EQ(runs_count.load(), size_t(256));
+}
+
+TEST(falsePositiveTests, test1)
+{
+    auto &pool = work_stealing_pool::instance();
+    pool.set_threads_count(4);
+
+    work_stealing_pool::task_group group(pool);
+    for (size_t i = 0; i < 8; ++i)
+    {
+        group.run([i]()
+        {
+            if (i % 3 == 1)
+            {
+                throw std::logic_error("task failed");
+            }
+        });
+    }
+
+    EXPECT_THROW(group.wait(), std::logic_error);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -164,6 +164,27 @@ TEST(positive_tests, test7)
     delete logger;
 }
 
+TEST(positive_tests, test8)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    big_integer bigint_1("-12342435346438958724438792758934689457646434323544564567456353246467546742553890454890356745895343687456894678934854493068450697557345353");
+    big_integer bigint_2("42389428935349086840957804985309763636567574564");
+    big_integer remainder("0");
+    big_integer::divmod(bigint_1, bigint_2, remainder, nullptr, big_integer::division_rule::trivial);
+
+    EXPECT_TRUE((std::ostringstream() << bigint_1).str() == "-291167766502899124008723943300693817184031156313950883875886123638773043440828935681031181");
+    EXPECT_TRUE((std::ostringstream() << remainder).str() == "-32534456937159656778236169310244771265930865269");
+
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
@@ -5,7 +5,31 @@
 std::vector<big_integer> continued_fraction::to_continued_fraction_representation(
     fraction const &value)
 {
-    throw not_implemented("std::vector<big_integer> continued_fraction::to_continued_fraction_representation(fraction const &)", "your code should be here...");
+    big_integer const zero("0");
+    big_integer const one("1");
+
+    std::vector<big_integer> representation;
+    auto numerator = value._numerator;
+    auto denominator = value._denominator;
+    big_integer remainder("0");
+
+    // one division per partial quotient; the truncated quotient of a negative value is floored,
+    // after which the remainders and the partial quotients are positive
+    while (denominator != zero)
+    {
+        big_integer::divmod(numerator, denominator, remainder);
+        if (remainder < zero)
+        {
+            numerator -= one;
+            remainder += denominator;
+        }
+
+        representation.push_back(std::move(numerator));
+        numerator = std::move(denominator);
+        denominator = std::move(remainder);
+    }
+
+    return representation;
 }
 
 fraction continued_fraction::from_continued_fraction_representation(
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <continued_fraction.h>
+
+fraction make_fraction(
+    char const *numerator,
+    char const *denominator)
+{
+    return fraction(big_integer(numerator), big_integer(denominator));
+}
+
+bool is_representation_of(
+    std::vector<big_integer> const &representation,
+    std::vector<std::string> const &partial_quotients)
+{
+    if (representation.size() != partial_quotients.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < representation.size(); ++i)
+    {
+        if (representation[i] != big_integer(partial_quotients[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TEST(positive_tests, test1)
+{
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("415", "93")), { "4", "2", "6", "7" }));
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("1", "3")), { "0", "3" }));
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("5", "1")), { "5" }));
+}
+
+TEST(positive_tests, negative_values_floor_the_first_partial_quotient)
+{
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("-7", "3")), { "-3", "1", "2" }));
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("-1", "2")), { "-1", "2" }));
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("7", "-3")), { "-3", "1", "2" }));
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("-6", "3")), { "-2" }));
+}
+
+TEST(positive_tests, zero_has_one_partial_quotient)
+{
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("0", "5")), { "0" }));
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("0", "-5")), { "0" }));
+}
+
+TEST(positive_tests, non_reduced_values_share_the_reduced_representation)
+{
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("830", "186")), { "4", "2", "6", "7" }));
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("-14", "6")), { "-3", "1", "2" }));
+    EXPECT_TRUE(is_representation_of(continued_fraction::to_continued_fraction_representation(make_fraction("-35", "-15")), { "2", "3" }));
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
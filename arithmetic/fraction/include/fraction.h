@@ -6,6 +6,8 @@
 class fraction final
 {
 
+    friend class continued_fraction;
+
 private:
 
     big_integer _numerator;
@@ -1,31 +1,108 @@
 #include "../include/fraction.h"
 
+#include <stdexcept>
+
+namespace
+{
+
+    /*
+     * Brings the fraction to lowest terms with a positive denominator. Euclid's algorithm needs only the remainders,
+     * and both terms are then divided by the one prepared divisor of their greatest common divisor.
+     */
+    void reduce(
+        big_integer &numerator,
+        big_integer &denominator)
+    {
+        big_integer const zero("0");
+        big_integer const one("1");
+
+        if (denominator == zero)
+        {
+            throw std::logic_error("zero denominator");
+        }
+
+        if (denominator < zero)
+        {
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+
+        if (numerator == zero)
+        {
+            denominator = one;
+            return;
+        }
+
+        auto greatest = numerator < zero
+            ? -numerator
+            : numerator;
+        auto rest = denominator;
+        while (rest != zero)
+        {
+            big_integer::modulo(greatest, rest);
+            std::swap(greatest, rest);
+        }
+
+        if (greatest != one)
+        {
+            big_integer::precomputed_divisor const divisor(greatest);
+            big_integer::divide(numerator, divisor);
+            big_integer::divide(denominator, divisor);
+        }
+    }
+
+    /*
+     * The sign of a/b - c/d for positive denominators, that of ad - cb.
+     */
+    int compare(
+        big_integer const &first_numerator,
+        big_integer const &first_denominator,
+        big_integer const &second_numerator,
+        big_integer const &second_denominator)
+    {
+        big_integer const zero("0");
+
+        auto difference = big_integer::multiply(first_numerator, second_denominator);
+        big_integer::submul(difference, second_numerator, first_denominator);
+
+        return difference < zero
+            ? -1
+            : difference == zero
+                ? 0
+                : 1;
+    }
+
+}
+
 fraction::fraction(
     big_integer &&numerator,
     big_integer &&denominator):
         _numerator(std::forward<big_integer>(numerator)),
         _denominator(std::forward<big_integer>(denominator))
 {
-    throw not_implemented("fraction::fraction(big_integer &&, big_integer &&)", "your code should be here...");
+    reduce(_numerator, _denominator);
 }
 
-fraction::~fraction()
-{
-    throw not_implemented("fraction::~fraction()", "your code should be here...");
-}
+fraction::~fraction() noexcept = default;
 
 fraction::fraction(
     fraction const &other):
         _numerator(other._numerator),
         _denominator(other._denominator)
 {
-    throw not_implemented("fraction::fraction(fraction const &)", "your code should be here...");
+
 }
 
 fraction &fraction::operator=(
     fraction const &other)
 {
-    throw not_implemented("fraction &fraction::operator=(fraction const &)", "your code should be here...");
+    if (this != &other)
+    {
+        _numerator = other._numerator;
+        _denominator = other._denominator;
+    }
+
+    return *this;
 }
 
 fraction::fraction(
@@ -33,97 +110,143 @@ fraction::fraction(
         _numerator(std::move(other._numerator)),
         _denominator(std::move(other._denominator))
 {
-    throw not_implemented("fraction::fraction(fraction &&) noexcept", "your code should be here...");
+
 }
 
 fraction &fraction::operator=(
     fraction &&other) noexcept
 {
-    throw not_implemented("fraction &fraction::operator=(fraction &&) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        _numerator = std::move(other._numerator);
+        _denominator = std::move(other._denominator);
+    }
+
+    return *this;
 }
 
 fraction &fraction::operator+=(
     fraction const &other)
 {
-    throw not_implemented("fraction &fraction::operator+=(fraction const &)", "your code should be here...");
+    // a/b + c/d = (ad + cb) / bd, the numerator accumulated in place
+    auto numerator = _numerator * other._denominator;
+    big_integer::addmul(numerator, other._numerator, _denominator);
+    big_integer::multiply(_denominator, other._denominator);
+    _numerator = std::move(numerator);
+    reduce(_numerator, _denominator);
+
+    return *this;
 }
 
 fraction fraction::operator+(
     fraction const &other) const
 {
-    throw not_implemented("fraction fraction::operator+(fraction const &) const", "your code should be here...");
+    fraction result(*this);
+    result += other;
+
+    return result;
 }
 
 fraction &fraction::operator-=(
     fraction const &other)
 {
-    throw not_implemented("fraction &fraction::operator-=(fraction const &)", "your code should be here...");
+    auto numerator = _numerator * other._denominator;
+    big_integer::submul(numerator, other._numerator, _denominator);
+    big_integer::multiply(_denominator, other._denominator);
+    _numerator = std::move(numerator);
+    reduce(_numerator, _denominator);
+
+    return *this;
 }
 
 fraction fraction::operator-(
     fraction const &other) const
 {
-    throw not_implemented("fraction fraction::operator-(fraction const &) const", "your code should be here...");
+    fraction result(*this);
+    result -= other;
+
+    return result;
 }
 
 fraction &fraction::operator*=(
     fraction const &other)
 {
-    throw not_implemented("fraction &fraction::operator*=(fraction const &)", "your code should be here...");
+    big_integer::multiply(_numerator, other._numerator);
+    big_integer::multiply(_denominator, other._denominator);
+    reduce(_numerator, _denominator);
+
+    return *this;
 }
 
 fraction fraction::operator*(
     fraction const &other) const
 {
-    throw not_implemented("fraction fraction::operator*(fraction const &) const", "your code should be here...");
+    fraction result(*this);
+    result *= other;
+
+    return result;
 }
 
 fraction &fraction::operator/=(
     fraction const &other)
 {
-    throw not_implemented("fraction &fraction::operator/=(fraction const &)", "your code should be here...");
+    if (other._numerator == big_integer("0"))
+    {
+        throw std::logic_error("division by zero");
+    }
+
+    auto numerator = _numerator * other._denominator;
+    big_integer::multiply(_denominator, other._numerator);
+    _numerator = std::move(numerator);
+    reduce(_numerator, _denominator);
+
+    return *this;
 }
 
 fraction fraction::operator/(
     fraction const &other) const
 {
-    throw not_implemented("fraction fraction::operator/(fraction const &) const", "your code should be here...");
+    fraction result(*this);
+    result /= other;
+
+    return result;
 }
 
 bool fraction::operator==(
     fraction const &other) const
 {
-    throw not_implemented("bool fraction::operator==(fraction const &) const", "your code should be here...");
+    // both are in lowest terms with positive denominators
+    return _numerator == other._numerator && _denominator == other._denominator;
 }
 
 bool fraction::operator!=(
     fraction const &other) const
 {
-    throw not_implemented("bool fraction::operator!=(fraction const &) const", "your code should be here...");
+    return !(*this == other);
 }
 
 bool fraction::operator>=(
     fraction const &other) const
 {
-    throw not_implemented("bool fraction::operator>=(fraction const &) const", "your code should be here...");
+    return compare(_numerator, _denominator, other._numerator, other._denominator) >= 0;
 }
 
 bool fraction::operator>(
     fraction const &other) const
 {
-    throw not_implemented("bool fraction::operator>(fraction const &) const", "your code should be here...");
+    return compare(_numerator, _denominator, other._numerator, other._denominator) > 0;
 }
 
 bool fraction::operator<=(
     fraction const &other) const
 {
-    throw not_implemented("bool fraction::operator<=(fraction const &) const", "your code should be here...");
+    return compare(_numerator, _denominator, other._numerator, other._denominator) <= 0;
 }
 
 bool fraction::operator<(
     fraction const &other) const
 {
-    throw not_implemented("bool fraction::operator<(fraction const &) const", "your code should be here...");
+    return compare(_numerator, _denominator, other._numerator, other._denominator) < 0;
 }
 
 std::ostream &operator<<(
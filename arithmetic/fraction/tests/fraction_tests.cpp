@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <fraction.h>
+
+fraction make_fraction(
+    char const *numerator,
+    char const *denominator)
+{
+    return fraction(big_integer(numerator), big_integer(denominator));
+}
+
+TEST(positive_tests, test1)
+{
+    EXPECT_TRUE(make_fraction("2", "4") == make_fraction("1", "2"));
+    EXPECT_TRUE(make_fraction("-150", "100") == make_fraction("-3", "2"));
+    EXPECT_TRUE(make_fraction("123456789123456789", "987654321987654321") == make_fraction("13717421", "109739369"));
+}
+
+TEST(positive_tests, negative_terms_move_the_sign_to_the_numerator)
+{
+    EXPECT_TRUE(make_fraction("-2", "-4") == make_fraction("1", "2"));
+    EXPECT_TRUE(make_fraction("2", "-4") == make_fraction("-1", "2"));
+    EXPECT_TRUE(make_fraction("-2", "4") == make_fraction("1", "-2"));
+    EXPECT_TRUE(make_fraction("2", "-4") != make_fraction("1", "2"));
+}
+
+TEST(positive_tests, zero_has_one_representation)
+{
+    EXPECT_TRUE(make_fraction("0", "5") == make_fraction("0", "1"));
+    EXPECT_TRUE(make_fraction("0", "-7") == make_fraction("0", "1"));
+    EXPECT_TRUE(make_fraction("0", "5") != make_fraction("1", "5"));
+}
+
+TEST(positive_tests, copies_and_moves_keep_the_value)
+{
+    auto const value = make_fraction("-6", "9");
+
+    fraction copy(value);
+    EXPECT_TRUE(copy == make_fraction("-2", "3"));
+
+    fraction moved(std::move(copy));
+    EXPECT_TRUE(moved == value);
+
+    copy = moved;
+    EXPECT_TRUE(copy == value);
+}
+
+TEST(positive_tests, sums_and_differences_cross_zero)
+{
+    auto value = make_fraction("1", "2");
+
+    value -= make_fraction("3", "4");
+    EXPECT_TRUE(value == make_fraction("-1", "4"));
+
+    value += make_fraction("1", "4");
+    EXPECT_TRUE(value == make_fraction("0", "1"));
+
+    value -= make_fraction("-5", "6");
+    EXPECT_TRUE(value == make_fraction("5", "6"));
+
+    EXPECT_TRUE(make_fraction("-1", "3") + make_fraction("1", "-3") == make_fraction("-2", "3"));
+    EXPECT_TRUE(make_fraction("-1", "3") - make_fraction("1", "-3") == make_fraction("0", "1"));
+}
+
+TEST(positive_tests, products_and_quotients_handle_signs)
+{
+    EXPECT_TRUE(make_fraction("-2", "3") * make_fraction("9", "-4") == make_fraction("3", "2"));
+    EXPECT_TRUE(make_fraction("-2", "3") * make_fraction("0", "7") == make_fraction("0", "1"));
+    EXPECT_TRUE(make_fraction("-2", "3") / make_fraction("4", "9") == make_fraction("-3", "2"));
+    EXPECT_TRUE(make_fraction("-2", "3") / make_fraction("-4", "9") == make_fraction("3", "2"));
+    EXPECT_TRUE(make_fraction("0", "3") / make_fraction("-4", "9") == make_fraction("0", "1"));
+}
+
+TEST(positive_tests, multiple_limb_terms_accumulate_in_place)
+{
+    auto const first = make_fraction("-170141183460469231731687303715884105727", "100000000000000000000000000000000000039");
+    auto const second = make_fraction("-147808829414345923316083210206383297603", "107006904423598033356356300384937784807");
+    auto const common_denominator = "10700690442359803335635630038493778484873269272520323300897895715012573607473";
+
+    auto value = first;
+    value += second;
+    EXPECT_TRUE(value == make_fraction("-32987164298506881913252520587034491117302674621826300426808822656140510896206", common_denominator));
+
+    value = first;
+    value -= second;
+    EXPECT_TRUE(value == make_fraction("-3425398415637697250035878545757831585173585927507318408154332260042613683172", common_denominator));
+
+    value = second;
+    value -= first;
+    EXPECT_TRUE(value == make_fraction("3425398415637697250035878545757831585173585927507318408154332260042613683172", common_denominator));
+
+    value = first;
+    value *= second;
+    EXPECT_TRUE(value == make_fraction("25148369162463430687809571847877363945393617744750568995301500820512957672381", common_denominator));
+
+    value = first;
+    value /= second;
+    EXPECT_TRUE(value == make_fraction(
+        "18206281357072289581644199566396161351238130274666809417481577458091562289689",
+        "14780882941434592331608321020638329766064544347159491009327245198048948606517"));
+}
+
+TEST(positive_tests, operands_may_be_the_destination)
+{
+    auto const original = make_fraction("-170141183460469231731687303715884105727", "100000000000000000000000000000000000039");
+
+    auto value = original;
+    value += value;
+    EXPECT_TRUE(value == make_fraction("-340282366920938463463374607431768211454", "100000000000000000000000000000000000039"));
+
+    value = original;
+    value -= value;
+    EXPECT_TRUE(value == make_fraction("0", "1"));
+
+    value = original;
+    value *= value;
+    EXPECT_TRUE(value == make_fraction(
+        "28948022309329048855892746252171976962977213799489202546401021394546514198529",
+        "10000000000000000000000000000000000007800000000000000000000000000000000001521"));
+
+    value = original;
+    value /= value;
+    EXPECT_TRUE(value == make_fraction("1", "1"));
+}
+
+TEST(positive_tests, comparisons_follow_the_sign)
+{
+    auto const negative_half = make_fraction("1", "-2");
+    auto const half = make_fraction("1", "2");
+    auto const zero = make_fraction("0", "1");
+
+    EXPECT_TRUE(negative_half < half);
+    EXPECT_TRUE(negative_half <= half);
+    EXPECT_FALSE(negative_half > half);
+    EXPECT_FALSE(negative_half >= half);
+    EXPECT_TRUE(half > negative_half);
+    EXPECT_TRUE(half >= negative_half);
+
+    EXPECT_TRUE(negative_half < zero);
+    EXPECT_TRUE(zero < half);
+    EXPECT_TRUE(make_fraction("0", "-3") >= zero);
+    EXPECT_TRUE(make_fraction("0", "-3") <= zero);
+
+    // a larger magnitude is the smaller negative value
+    EXPECT_TRUE(make_fraction("-2", "3") < negative_half);
+    EXPECT_TRUE(make_fraction("-2", "-3") > half);
+
+    EXPECT_TRUE(make_fraction("-3", "6") <= negative_half);
+    EXPECT_TRUE(make_fraction("-3", "6") >= negative_half);
+    EXPECT_FALSE(make_fraction("-3", "6") < negative_half);
+    EXPECT_FALSE(make_fraction("-3", "6") > negative_half);
+}
+
+TEST(falsePositiveTests, test1)
+{
+    EXPECT_THROW(make_fraction("1", "0"), std::logic_error);
+    EXPECT_THROW(make_fraction("0", "0"), std::logic_error);
+}
+
+TEST(falsePositiveTests, test2)
+{
+    auto value = make_fraction("-2", "3");
+
+    EXPECT_THROW(value /= make_fraction("0", "-5"), std::logic_error);
+    EXPECT_TRUE(value == make_fraction("-2", "3"));
+    EXPECT_THROW(make_fraction("1", "2") / make_fraction("0", "1"), std::logic_error);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
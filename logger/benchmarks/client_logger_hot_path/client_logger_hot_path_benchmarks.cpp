@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <client_logger.h>
+
+/*
+ * Throughput and per-call latency of client_logger::log.
+ *
+ *     mp_os_lggr_bnchmrks_clnt_lggr_ht_pth [max threads = 64] [calls per run = 200000]
+ *
+ * Every configuration is measured with an enabled severity (information) and with one
+ * the logger filters out (debug). Console output is redirected to /dev/null while measured.
+ */
+namespace
+{
+
+    std::string const message(80, 'x');
+
+    std::vector<std::string> const file_paths =
+    {
+        "client_logger_hot_path_benchmark_0.txt",
+        "client_logger_hot_path_benchmark_1.txt",
+        "client_logger_hot_path_benchmark_2.txt"
+    };
+
+    struct configuration final
+    {
+
+        char const *name;
+
+        size_t files_count;
+
+        bool has_console;
+
+        bool is_thread_buffered;
+
+    };
+
+    struct result final
+    {
+
+        double seconds;
+
+        size_t calls_count;
+
+        std::vector<uint32_t> latencies;
+
+    };
+
+    void remove_files()
+    {
+        for (auto &file_path: file_paths)
+        {
+            std::remove(file_path.c_str());
+        }
+    }
+
+    logger *build_logger(
+        configuration const &tested)
+    {
+        client_logger_builder builder;
+
+        for (size_t i = 0; i < tested.files_count; ++i)
+        {
+            builder.add_file_stream(file_paths[i], logger::severity::information);
+        }
+        if (tested.has_console)
+        {
+            builder.add_console_stream(logger::severity::information);
+        }
+        if (tested.is_thread_buffered)
+        {
+            builder.set_thread_buffering(1 << 16, std::chrono::milliseconds(100));
+        }
+
+        return builder.build();
+    }
+
+    result run(
+        logger const *measured_logger,
+        logger::severity severity,
+        size_t threads_count,
+        size_t calls_per_thread)
+    {
+        std::vector<std::vector<uint32_t>> latencies(threads_count, std::vector<uint32_t>(calls_per_thread));
+        std::vector<std::thread> threads;
+
+        auto const started = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < threads_count; ++i)
+        {
+            threads.emplace_back([measured_logger, severity, calls_per_thread, &thread_latencies = latencies[i]]()
+            {
+                for (size_t j = 0; j < calls_per_thread; ++j)
+                {
+                    auto const call_started = std::chrono::steady_clock::now();
+                    measured_logger->log(message, severity);
+                    auto const call_finished = std::chrono::steady_clock::now();
+
+                    thread_latencies[j] = static_cast<uint32_t>(std::min<long long>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(call_finished - call_started).count(),
+                        UINT32_MAX));
+                }
+            });
+        }
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+
+        result measured;
+        measured.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        measured.calls_count = threads_count * calls_per_thread;
+        measured.latencies.reserve(measured.calls_count);
+        for (auto &thread_latencies: latencies)
+        {
+            measured.latencies.insert(measured.latencies.end(), thread_latencies.begin(), thread_latencies.end());
+        }
+
+        return measured;
+    }
+
+    uint32_t percentile(
+        std::vector<uint32_t> &latencies,
+        double fraction)
+    {
+        auto const position = latencies.begin() + static_cast<std::ptrdiff_t>(fraction * static_cast<double>(latencies.size() - 1));
+        std::nth_element(latencies.begin(), position, latencies.end());
+
+        return *position;
+    }
+
+    void report(
+        configuration const &tested,
+        char const *severity_name,
+        size_t threads_count,
+        result &measured)
+    {
+        std::cerr << std::left << std::setw(16) << tested.name
+            << std::setw(10) << severity_name
+            << std::right << std::setw(4) << threads_count
+            << std::setw(14) << static_cast<size_t>(static_cast<double>(measured.calls_count) / measured.seconds)
+            << std::setw(10) << percentile(measured.latencies, 0.5)
+            << std::setw(10) << percentile(measured.latencies, 0.99)
+            << std::setw(10) << percentile(measured.latencies, 0.999) << std::endl;
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    size_t const max_threads_count = argc > 1
+        ? std::strtoul(argv[1], nullptr, 10)
+        : 64;
+    size_t const calls_per_run = argc > 2
+        ? std::strtoul(argv[2], nullptr, 10)
+        : 200000;
+
+    std::vector<configuration> const configurations =
+    {
+        { "console", 0, true, false },
+        { "file", 1, false, false },
+        { "file, buffered", 1, false, true },
+        { "3 files+console", 3, true, false }
+    };
+
+    // the report goes to stderr: stdout is where console streams write
+    std::cerr << std::left << std::setw(16) << "streams"
+        << std::setw(10) << "severity"
+        << std::right << std::setw(4) << "thr"
+        << std::setw(14) << "calls/s"
+        << std::setw(10) << "p50 ns"
+        << std::setw(10) << "p99 ns"
+        << std::setw(10) << "p999 ns" << std::endl;
+
+    int const saved_stdout = dup(STDOUT_FILENO);
+    int const null_output = open("/dev/null", O_WRONLY);
+
+    for (auto &tested: configurations)
+    {
+        for (size_t threads_count = 1; threads_count <= max_threads_count; threads_count *= 2)
+        {
+            auto const calls_per_thread = std::max<size_t>(calls_per_run / threads_count, 1000);
+
+            remove_files();
+            logger *measured_logger = build_logger(tested);
+
+            std::cout.flush();
+            dup2(null_output, STDOUT_FILENO);
+
+            auto enabled = run(measured_logger, logger::severity::information, threads_count, calls_per_thread);
+            auto filtered = run(measured_logger, logger::severity::debug, threads_count, calls_per_thread);
+
+            delete measured_logger;
+            std::cout.flush();
+            dup2(saved_stdout, STDOUT_FILENO);
+
+            report(tested, "enabled", threads_count, enabled);
+            report(tested, "filtered", threads_count, filtered);
+        }
+    }
+
+    close(null_output);
+    close(saved_stdout);
+    remove_files();
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <client_logger.h>
+#include <log_server.h>
+#include <server_logger.h>
+
+namespace
+{
+
+    size_t const messages_per_thread = 200000;
+
+    std::string const message(80, 'x');
+
+    std::string const file_path = "server_logger_throughput_benchmark.txt";
+
+    double seconds_since(
+        std::chrono::steady_clock::time_point started)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    double run_writers(
+        logger_builder &builder,
+        size_t threads_count)
+    {
+        std::vector<logger *> loggers;
+        for (size_t i = 0; i < threads_count; ++i)
+        {
+            loggers.push_back(builder.build());
+        }
+
+        std::vector<std::thread> threads;
+        auto started = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < threads_count; ++i)
+        {
+            threads.emplace_back([&loggers, i]()
+            {
+                for (size_t j = 0; j < messages_per_thread; ++j)
+                {
+                    loggers[i]->information(message);
+                }
+            });
+        }
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+        for (auto *built_logger: loggers)
+        {
+            delete built_logger;
+        }
+
+        return seconds_since(started);
+    }
+
+    pid_t start_server(
+        std::string const &name)
+    {
+        sigset_t termination_signals;
+        sigemptyset(&termination_signals);
+        sigaddset(&termination_signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &termination_signals, nullptr);
+
+        pid_t server_process = fork();
+        if (server_process == 0)
+        {
+            log_server server(name, log_server::default_capacity, { file_path });
+            std::thread worker(&log_server::run, &server);
+
+            int received_signal;
+            sigwait(&termination_signals, &received_signal);
+
+            server.stop();
+            worker.join();
+            _exit(0);
+        }
+
+        pthread_sigmask(SIG_UNBLOCK, &termination_signals, nullptr);
+
+        return server_process;
+    }
+
+    void report(
+        std::string const &name,
+        size_t threads_count,
+        double seconds)
+    {
+        double const lines = static_cast<double>(threads_count * messages_per_thread);
+
+        std::cout << std::left << std::setw(40) << name
+            << std::right << std::setw(4) << threads_count << " threads"
+            << std::setw(10) << std::fixed << std::setprecision(3) << seconds << " s"
+            << std::setw(14) << static_cast<size_t>(lines / seconds) << " lines/s" << std::endl;
+    }
+
+}
+
+int main()
+{
+    std::string const server_name = "/mp_os_server_logger_benchmark_" + std::to_string(getpid());
+
+    for (size_t threads_count: {1, 4, 16})
+    {
+        std::remove(file_path.c_str());
+        {
+            client_logger_builder builder;
+            builder.add_file_stream(file_path, logger::severity::information);
+
+            report("client_logger, direct file writes", threads_count, run_writers(builder, threads_count));
+        }
+
+        std::remove(file_path.c_str());
+        {
+            pid_t server_process = start_server(server_name);
+
+            // every line is written, as with client_logger: writers wait for the server when the ring is full
+            server_logger_builder builder;
+            builder
+                .set_server_name(server_name)
+                ->set_push_timeout(std::chrono::milliseconds(100))
+                ->add_file_stream(file_path, logger::severity::information);
+
+            // wait until the server has created its ring
+            while (true)
+            {
+                try
+                {
+                    delete builder.build();
+                    break;
+                }
+                catch (std::runtime_error const &)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+            }
+
+            auto started = std::chrono::steady_clock::now();
+            report("server_logger, application side", threads_count, run_writers(builder, threads_count));
+
+            kill(server_process, SIGTERM);
+            waitpid(server_process, nullptr, 0);
+            report("server_logger, until written by server", threads_count, seconds_since(started));
+        }
+    }
+
+    std::remove(file_path.c_str());
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <client_logger.h>
+
+namespace
+{
+
+    size_t const loggers_count = 64;
+    size_t const files_count = 4;
+    size_t const messages_per_logger = 20000;
+
+    std::string const message(80, 'x');
+
+    std::string file_path(
+        size_t file_index)
+    {
+        return "shared_file_streams_benchmark_" + std::to_string(file_index) + ".txt";
+    }
+
+    void remove_files()
+    {
+        for (size_t i = 0; i < files_count; ++i)
+        {
+            std::remove(file_path(i).c_str());
+        }
+    }
+
+    size_t count_broken_lines()
+    {
+        size_t broken_lines = 0;
+
+        for (size_t i = 0; i < files_count; ++i)
+        {
+            std::ifstream stream(file_path(i));
+            std::string line;
+            while (std::getline(stream, line))
+            {
+                if (line.size() < message.size() || line.compare(line.size() - message.size(), message.size(), message) != 0)
+                {
+                    ++broken_lines;
+                }
+            }
+        }
+
+        return broken_lines;
+    }
+
+    template<
+        typename write_function>
+    double measure(
+        write_function &&write)
+    {
+        std::vector<std::thread> threads;
+        auto started = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < loggers_count; ++i)
+        {
+            threads.emplace_back(write, i);
+        }
+        for (auto &thread: threads)
+        {
+            thread.join();
+        }
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    void report(
+        std::string const &name,
+        double seconds)
+    {
+        double const lines = static_cast<double>(loggers_count * messages_per_logger);
+
+        std::cout << std::left << std::setw(36) << name
+            << std::right << std::setw(10) << std::fixed << std::setprecision(3) << seconds << " s"
+            << std::setw(14) << static_cast<size_t>(lines / seconds) << " lines/s"
+            << std::setw(10) << count_broken_lines() << " broken lines" << std::endl;
+    }
+
+}
+
+int main()
+{
+    std::cout << loggers_count << " loggers, " << files_count << " files, "
+        << messages_per_logger << " messages per logger" << std::endl;
+
+    // baseline: every logger owns its own std::ofstream for the same path
+    remove_files();
+    {
+        std::vector<std::ofstream> streams;
+        for (size_t i = 0; i < loggers_count; ++i)
+        {
+            streams.emplace_back(file_path(i % files_count), std::ios::app);
+        }
+
+        auto seconds = measure([&streams](size_t logger_index)
+        {
+            for (size_t j = 0; j < messages_per_logger; ++j)
+            {
+                streams[logger_index] << "[INFORMATION] " << message << '\n';
+            }
+        });
+        streams.clear();
+
+        report("private std::ofstream per logger", seconds);
+    }
+
+    // client_logger instances sharing one registered stream per path
+    remove_files();
+    {
+        std::vector<logger *> loggers;
+        for (size_t i = 0; i < loggers_count; ++i)
+        {
+            client_logger_builder builder;
+            loggers.push_back(builder
+                .add_file_stream(file_path(i % files_count), logger::severity::information)
+                ->build());
+        }
+
+        auto seconds = measure([&loggers](size_t logger_index)
+        {
+            for (size_t j = 0; j < messages_per_logger; ++j)
+            {
+                loggers[logger_index]->information(message);
+            }
+        });
+        for (auto *built_logger: loggers)
+        {
+            delete built_logger;
+        }
+
+        report("client_logger shared streams", seconds);
+    }
+
+    remove_files();
+
+    return 0;
+}
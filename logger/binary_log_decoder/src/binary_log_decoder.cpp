@@ -0,0 +1,44 @@
+#include <fstream>
+#include <iostream>
+
+#include <binary_log_format.h>
+
+int main(
+    int argc,
+    char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <binary log file> [<binary log file> ...]" << std::endl;
+        return 1;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::ifstream stream(argv[i], std::ios::binary);
+        if (!stream.is_open())
+        {
+            std::cerr << "can't open \"" << argv[i] << "\"" << std::endl;
+            return 1;
+        }
+
+        binary_log_format::decoder decoder(stream);
+        std::string line;
+
+        try
+        {
+            while (decoder.next(line))
+            {
+                std::cout << line << '\n';
+            }
+        }
+        catch (std::runtime_error const &error)
+        {
+            std::cout.flush();
+            std::cerr << argv[i] << ": " << error.what() << std::endl;
+            return 2;
+        }
+    }
+
+    return 0;
+}
@@ -1,13 +1,292 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <binary_log_format.h>
+#include <log_rate_limiter.h>
 #include <logger.h>
 #include "client_logger_builder.h"
+#include "file_rotation_policy.h"
 
 class client_logger final:
     public logger
 {
 
+    friend class client_logger_builder;
+
+private:
+
+    /*
+     * One buffered stream per file, shared by every client_logger in the process.
+     * Writers serialize on the stream's own mutex, so lines from different loggers never interleave.
+     * Binary streams also share the format dictionary, so format ids stay consistent within a file.
+     */
+    class shared_stream final
+    {
+
+    public:
+
+        std::ofstream file_stream;
+
+        std::ostream *stream;
+
+        std::mutex guard;
+
+        size_t references_count;
+
+        bool is_binary;
+
+        binary_log_format::format_dictionary formats;
+
+        // canonical, the registry's key
+        std::string file_path;
+
+        file_rotation_policy rotation;
+
+        // guarded by the stream's mutex, except segments, which only the rotation worker touches
+
+        size_t written_size;
+
+        std::chrono::steady_clock::time_point rotation_deadline;
+
+        bool is_rotation_requested;
+
+        std::deque<std::string> segments;
+
+    };
+
+    class streams_registry final
+    {
+
+    private:
+
+        std::mutex _guard;
+
+        // by canonical path, so that "a.log", "./a.log" and an absolute path to it share one stream
+        std::map<std::string, shared_stream *> _file_streams;
+
+        shared_stream _console_stream;
+
+        std::thread _rotation_worker;
+
+        std::condition_variable _rotation_requested;
+
+        std::deque<shared_stream *> _pending_rotations;
+
+        bool _is_stopping;
+
+    public:
+
+        streams_registry();
+
+        ~streams_registry() noexcept;
+
+        streams_registry(
+            streams_registry const &other) = delete;
+
+        streams_registry &operator=(
+            streams_registry const &other) = delete;
+
+    public:
+
+        shared_stream *acquire(
+            std::string const &stream_file_path,
+            bool is_binary,
+            file_rotation_policy const &rotation = file_rotation_policy());
+
+        void release(
+            shared_stream *target) noexcept;
+
+        shared_stream *get_console_stream() noexcept;
+
+        /*
+         * Hands the stream to the rotation worker; writers keep using the current file meanwhile.
+         */
+        void request_rotation(
+            shared_stream *target) noexcept;
+
+    private:
+
+        void rotate_in_background() noexcept;
+
+        /*
+         * Renames the current file to a new segment, opens a fresh file and swaps it in under the stream's mutex;
+         * the old file is flushed, compressed and pruned without holding it.
+         */
+        static void rotate(
+            shared_stream *target) noexcept;
+
+        static bool compress(
+            std::string const &segment_path) noexcept;
+
+    public:
+
+        static streams_registry &instance();
+
+    };
+
+    /*
+     * Text output mode where every thread appends formatted lines to its own buffer.
+     * A flush takes all buffers, merges them by the time each line was appended and writes
+     * every stream once, so loggers don't contend on the streams while logging.
+     *
+     * Lines appended after a flush has started may carry earlier timestamps than lines taken by it
+     * from other threads, so each flush only writes lines up to its start and carries the rest
+     * over to the next one: the output is globally ordered.
+     */
+    class buffered_writer final
+    {
+
+    private:
+
+        struct record final
+        {
+
+            int64_t timestamp;
+
+            logger::severity severity;
+
+            size_t offset;
+
+            size_t size;
+
+        };
+
+        class records_batch final
+        {
+
+        public:
+
+            std::vector<record> records;
+
+            std::string text;
+
+        };
+
+        class thread_buffer final
+        {
+
+        public:
+
+            std::mutex guard;
+
+            records_batch batch;
+
+            // set once the writer is destroyed, so threads drop the buffer from their lookup tables
+            std::atomic<bool> is_orphaned;
+
+        };
+
+    private:
+
+        uint64_t _id;
+
+        std::vector<std::pair<shared_stream *, std::set<logger::severity>>> _targets;
+
+        unsigned int _severities_mask;
+
+        size_t _max_thread_buffer_size;
+
+        std::mutex _buffers_guard;
+
+        std::vector<std::shared_ptr<thread_buffer>> _buffers;
+
+        std::mutex _flush_guard;
+
+        records_batch _carried_over;
+
+        std::mutex _flusher_guard;
+
+        std::condition_variable _flusher_wakeup;
+
+        bool _is_stopping;
+
+        std::atomic<bool> _is_flush_requested;
+
+        std::thread _flusher;
+
+    public:
+
+        buffered_writer(
+            std::vector<std::pair<shared_stream *, std::set<logger::severity>>> const &targets,
+            size_t max_thread_buffer_size,
+            std::chrono::milliseconds flush_interval);
+
+        /*
+         * Writes everything still buffered.
+         */
+        ~buffered_writer() noexcept;
+
+        buffered_writer(
+            buffered_writer const &other) = delete;
+
+        buffered_writer &operator=(
+            buffered_writer const &other) = delete;
+
+    public:
+
+        [[nodiscard]] bool accepts(
+            logger::severity severity) const noexcept;
+
+        void append(
+            logger::severity severity,
+            std::string const &line) noexcept;
+
+        void flush(
+            bool is_final = false) noexcept;
+
+    private:
+
+        thread_buffer &get_thread_buffer();
+
+        void flush_periodically(
+            std::chrono::milliseconds flush_interval) noexcept;
+
+    };
+
+private:
+
+    std::map<std::string, std::pair<shared_stream *, std::set<logger::severity>>> _file_streams;
+
+    std::map<std::string, std::pair<shared_stream *, std::set<logger::severity>>> _binary_file_streams;
+
+    shared_stream *_console_stream;
+
+    std::set<logger::severity> _console_stream_severities;
+
+    logger::datetime_precision _datetime_precision;
+
+    // nullptr unless the builder set rate limiting or sampling policies
+    std::unique_ptr<log_rate_limiter> _rate_limiter;
+
+    size_t _thread_buffer_size;
+
+    std::chrono::milliseconds _flush_interval;
+
+    // nullptr unless the builder enabled per-thread buffering
+    std::unique_ptr<buffered_writer> _buffered_writer;
+
+private:
+
+    client_logger(
+        std::map<std::string, std::set<logger::severity>> const &file_streams,
+        std::map<std::string, std::set<logger::severity>> const &binary_file_streams,
+        std::set<logger::severity> const &console_stream_severities,
+        logger::datetime_precision datetime_precision,
+        std::map<logger::severity, log_rate_limiter::policy> const &rate_policies,
+        std::map<std::string, std::pair<file_rotation_policy, std::set<logger::severity>>> const &rotating_file_streams,
+        size_t thread_buffer_size,
+        std::chrono::milliseconds flush_interval);
+
 public:
 
     client_logger(
@@ -26,10 +305,71 @@ public:
 
 public:
 
+    using logger::log;
+
     [[nodiscard]] logger const *log(
         const std::string &message,
         logger::severity severity) const noexcept override;
 
+    /*
+     * Doesn't allocate once the calling thread has logged a line of this length:
+     * the line is formatted in a per-thread buffer.
+     */
+    [[nodiscard]] logger const *log(
+        logger::message_view message,
+        logger::severity severity) const noexcept override;
+
+    [[nodiscard]] logger const *log_structured(
+        logger::severity severity,
+        char const *format,
+        logger::format_argument const *arguments,
+        size_t arguments_count) const noexcept override;
+
+public:
+
+    /*
+     * Lines dropped by rate limiting or sampling so far.
+     */
+    [[nodiscard]] unsigned long long get_suppressed_count(
+        logger::severity severity) const noexcept;
+
+    /*
+     * Writes the lines buffered by all threads and flushes every stream.
+     */
+    logger const *flush() const noexcept;
+
+private:
+
+    void start_buffering();
+
+    /*
+     * Applies the rate policies; the first line that passes after suppressed ones is preceded by their count.
+     */
+    bool admit(
+        logger::severity severity,
+        void const *message_template) const noexcept;
+
+    void acquire_streams(
+        std::map<std::string, std::set<logger::severity>> const &file_streams,
+        std::map<std::string, std::set<logger::severity>> const &binary_file_streams,
+        std::map<std::string, std::pair<file_rotation_policy, std::set<logger::severity>>> const &rotating_file_streams);
+
+    void release_streams() noexcept;
+
+    void write_text(
+        logger::severity severity,
+        logger::message_view message) const noexcept;
+
+    void write_binary(
+        logger::severity severity,
+        char const *format,
+        logger::format_argument const *arguments,
+        size_t arguments_count) const noexcept;
+
+    static void write_to(
+        shared_stream *target,
+        std::string const &line) noexcept;
+
 };
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
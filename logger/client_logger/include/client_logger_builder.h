@@ -1,12 +1,35 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_BUILDER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_BUILDER_H
 
+#include <map>
+#include <set>
+
+#include <log_rate_limiter.h>
 #include <logger_builder.h>
+#include "file_rotation_policy.h"
 
 class client_logger_builder final:
     public logger_builder
 {
 
+private:
+
+    std::map<std::string, std::set<logger::severity>> _file_streams;
+
+    std::map<std::string, std::set<logger::severity>> _binary_file_streams;
+
+    std::map<std::string, std::pair<file_rotation_policy, std::set<logger::severity>>> _rotating_file_streams;
+
+    std::set<logger::severity> _console_stream_severities;
+
+    logger::datetime_precision _datetime_precision;
+
+    std::map<logger::severity, log_rate_limiter::policy> _rate_policies;
+
+    size_t _thread_buffer_size;
+
+    std::chrono::milliseconds _flush_interval;
+
 public:
 
     client_logger_builder();
@@ -34,6 +57,53 @@ public:
     logger_builder *add_console_stream(
         logger::severity severity) override;
 
+    /*
+     * Adds a sink writing the compact binary record format (see binary_log_format.h);
+     * render it back to text with the binary log decoder tool.
+     */
+    client_logger_builder *add_binary_file_stream(
+        std::string const &stream_file_path,
+        logger::severity severity);
+
+    /*
+     * Text file stream that is rotated by size and/or time (see file_rotation_policy.h);
+     * a path can't be used both with and without rotation.
+     */
+    client_logger_builder *add_rotating_file_stream(
+        std::string const &stream_file_path,
+        logger::severity severity,
+        file_rotation_policy const &rotation);
+
+    client_logger_builder *set_datetime_precision(
+        logger::datetime_precision precision);
+
+    /*
+     * Token bucket for the severity: bursts of up to burst lines (0 means lines_per_second),
+     * then lines_per_second on average. Suppressed lines are counted and reported by the next line that passes.
+     */
+    client_logger_builder *set_rate_limit(
+        logger::severity severity,
+        double lines_per_second,
+        size_t burst = 0);
+
+    /*
+     * Lets 1 in period lines of each message template with the severity through: the format of
+     * a structured call, the call site of a plain one.
+     */
+    client_logger_builder *set_sampling(
+        logger::severity severity,
+        size_t period);
+
+    /*
+     * Makes every logging thread collect text lines in its own buffer of about max_thread_buffer_size bytes.
+     * Buffers are merged in timestamp order and written when one of them fills up, every flush_interval
+     * (0 disables the timer) and on client_logger::flush(). Binary streams are written directly.
+     * A max_thread_buffer_size of 0 turns buffering off.
+     */
+    client_logger_builder *set_thread_buffering(
+        size_t max_thread_buffer_size,
+        std::chrono::milliseconds flush_interval);
+
     logger_builder* transform_with_configuration(
         std::string const &configuration_file_path,
         std::string const &configuration_path) override;
@@ -44,4 +114,4 @@ public:
 
 };
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_BUILDER_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_BUILDER_H
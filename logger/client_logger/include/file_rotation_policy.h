@@ -0,0 +1,44 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_FILE_ROTATION_POLICY_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_FILE_ROTATION_POLICY_H
+
+#include <chrono>
+#include <cstddef>
+
+/*
+ * When a rotating file stream closes its current file: the file is renamed to
+ * "<path>.<yyyymmdd-hhmmss>.<n>", optionally gzip-compressed in the background, and writing
+ * continues in a fresh file at the original path.
+ */
+class file_rotation_policy final
+{
+
+public:
+
+    // bytes; 0 disables rotation by size
+    size_t max_file_size;
+
+    // 0 disables rotation by time
+    std::chrono::seconds max_file_age;
+
+    // rotated segments kept on disk, the oldest are removed first; 0 keeps all of them
+    size_t kept_segments_count;
+
+    bool is_compressed;
+
+public:
+
+    file_rotation_policy() noexcept;
+
+public:
+
+    [[nodiscard]] bool is_enabled() const noexcept;
+
+    bool operator==(
+        file_rotation_policy const &other) const noexcept;
+
+    bool operator!=(
+        file_rotation_policy const &other) const noexcept;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_FILE_ROTATION_POLICY_H
@@ -1,39 +1,1140 @@
-#include <not_implemented.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
 
 #include "../include/client_logger.h"
 
+namespace
+{
+
+    /*
+     * The registry's key for a file: every spelling of its path, through ".", ".." or symbolic links, resolves
+     * to the same one. A file that doesn't exist yet is resolved through its directory, so nothing is created
+     * before the registry decides to open it.
+     */
+    std::string canonical_file_path(
+        std::string const &file_path,
+        size_t links_followed = 0)
+    {
+        char *resolved = realpath(file_path.c_str(), nullptr);
+        if (resolved != nullptr)
+        {
+            std::string canonical(resolved);
+            std::free(resolved);
+
+            return canonical;
+        }
+
+        if (errno != ENOENT)
+        {
+            throw std::runtime_error("can't open file stream \"" + file_path + "\": " + std::strerror(errno));
+        }
+
+        auto const separator = file_path.rfind('/');
+        auto const directory = separator == std::string::npos
+            ? std::string(".")
+            : file_path.substr(0, std::max<size_t>(separator, 1));
+        auto const name = file_path.substr(separator == std::string::npos
+            ? 0
+            : separator + 1);
+
+        // a link to a file yet to be created is keyed by its target, which opening the link creates
+        struct stat link_status{};
+        if (lstat(file_path.c_str(), &link_status) == 0 && S_ISLNK(link_status.st_mode))
+        {
+            std::string target(static_cast<size_t>(link_status.st_size) + 1, '\0');
+            auto const target_size = readlink(file_path.c_str(), &target[0], target.size());
+            if (target_size < 0 || static_cast<size_t>(target_size) >= target.size() || links_followed == 40)
+            {
+                throw std::runtime_error("can't open file stream \"" + file_path + "\": can't follow the link");
+            }
+            target.resize(static_cast<size_t>(target_size));
+
+            return canonical_file_path(target.front() == '/'
+                ? target
+                : directory + "/" + target, links_followed + 1);
+        }
+
+        resolved = realpath(directory.c_str(), nullptr);
+        if (resolved == nullptr)
+        {
+            throw std::runtime_error("can't open file stream \"" + file_path + "\": " + std::strerror(errno));
+        }
+
+        std::string canonical(resolved);
+        std::free(resolved);
+
+        if (canonical.back() != '/')
+        {
+            canonical.push_back('/');
+        }
+
+        return canonical + name;
+    }
+
+}
+
+client_logger::streams_registry::streams_registry():
+    _is_stopping(false)
+{
+    _console_stream.stream = &std::cout;
+    _console_stream.references_count = 0;
+    _console_stream.is_binary = false;
+    _console_stream.written_size = 0;
+    _console_stream.is_rotation_requested = false;
+}
+
+client_logger::streams_registry::~streams_registry() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_guard);
+        _is_stopping = true;
+    }
+    _rotation_requested.notify_one();
+
+    if (_rotation_worker.joinable())
+    {
+        _rotation_worker.join();
+    }
+
+    for (auto &file_stream: _file_streams)
+    {
+        delete file_stream.second;
+    }
+}
+
+client_logger::shared_stream *client_logger::streams_registry::acquire(
+    std::string const &stream_file_path,
+    bool is_binary,
+    file_rotation_policy const &rotation)
+{
+    auto const file_path = canonical_file_path(stream_file_path);
+
+    std::lock_guard<std::mutex> lock(_guard);
+
+    auto found = _file_streams.find(file_path);
+    if (found != _file_streams.end())
+    {
+        if (found->second->is_binary != is_binary)
+        {
+            throw std::logic_error("file stream \"" + stream_file_path + "\" is already opened in another format");
+        }
+        if (found->second->rotation != rotation)
+        {
+            throw std::logic_error("file stream \"" + stream_file_path + "\" is already opened with another rotation policy");
+        }
+
+        ++found->second->references_count;
+        return found->second;
+    }
+
+    auto *opened = new shared_stream;
+    opened->file_stream.open(file_path, is_binary
+        ? std::ios::app | std::ios::binary
+        : std::ios::app);
+    if (!opened->file_stream.is_open())
+    {
+        delete opened;
+        throw std::runtime_error("can't open file stream \"" + stream_file_path + "\": " + std::strerror(errno));
+    }
+    opened->stream = &opened->file_stream;
+    opened->references_count = 1;
+    opened->is_binary = is_binary;
+    opened->file_path = file_path;
+    opened->rotation = rotation;
+    opened->is_rotation_requested = false;
+    opened->rotation_deadline = std::chrono::steady_clock::now() + rotation.max_file_age;
+
+    // appending to a file left by a previous run counts towards its size limit
+    struct stat file_status{};
+    opened->written_size = stat(file_path.c_str(), &file_status) == 0
+        ? static_cast<size_t>(file_status.st_size)
+        : 0;
+
+    if (is_binary)
+    {
+        // every session restarts the format dictionary, so the decoder has to know where it begins
+        std::string header;
+        binary_log_format::append_header(header);
+        opened->file_stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+
+    _file_streams.emplace(file_path, opened);
+
+    if (rotation.is_enabled())
+    {
+        if (!_rotation_worker.joinable())
+        {
+            _rotation_worker = std::thread(&streams_registry::rotate_in_background, this);
+        }
+
+        // the worker recomputes its wake-up time for the new stream's deadline
+        _rotation_requested.notify_one();
+    }
+
+    return opened;
+}
+
+void client_logger::streams_registry::release(
+    shared_stream *target) noexcept
+{
+    std::lock_guard<std::mutex> lock(_guard);
+
+    auto found = _file_streams.find(target->file_path);
+    if (found == _file_streams.end() || --found->second->references_count != 0)
+    {
+        return;
+    }
+
+    delete found->second;
+    _file_streams.erase(found);
+}
+
+client_logger::shared_stream *client_logger::streams_registry::get_console_stream() noexcept
+{
+    return &_console_stream;
+}
+
+void client_logger::streams_registry::request_rotation(
+    shared_stream *target) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_guard);
+
+        // the stream must outlive the rotation even if its last logger is destroyed meanwhile
+        ++target->references_count;
+        _pending_rotations.push_back(target);
+    }
+
+    _rotation_requested.notify_one();
+}
+
+void client_logger::streams_registry::rotate_in_background() noexcept
+{
+    std::unique_lock<std::mutex> lock(_guard);
+
+    while (true)
+    {
+        if (!_pending_rotations.empty())
+        {
+            auto *target = _pending_rotations.front();
+            _pending_rotations.pop_front();
+
+            lock.unlock();
+            rotate(target);
+            release(target);
+            lock.lock();
+
+            continue;
+        }
+
+        if (_is_stopping)
+        {
+            return;
+        }
+
+        auto const now = std::chrono::steady_clock::now();
+        auto next_deadline = std::chrono::steady_clock::time_point::max();
+
+        for (auto &file_stream: _file_streams)
+        {
+            auto *target = file_stream.second;
+            if (target->rotation.max_file_age.count() == 0)
+            {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> stream_lock(target->guard);
+            if (target->is_rotation_requested)
+            {
+                continue;
+            }
+
+            if (target->rotation_deadline <= now)
+            {
+                target->is_rotation_requested = true;
+                ++target->references_count;
+                _pending_rotations.push_back(target);
+            }
+            else
+            {
+                next_deadline = std::min(next_deadline, target->rotation_deadline);
+            }
+        }
+
+        if (!_pending_rotations.empty())
+        {
+            continue;
+        }
+
+        if (next_deadline == std::chrono::steady_clock::time_point::max())
+        {
+            _rotation_requested.wait(lock);
+        }
+        else
+        {
+            _rotation_requested.wait_until(lock, next_deadline);
+        }
+    }
+}
+
+void client_logger::streams_registry::rotate(
+    shared_stream *target) noexcept
+{
+    auto const &rotation = target->rotation;
+
+    auto finish_without_rotation = [target, &rotation]()
+    {
+        std::lock_guard<std::mutex> lock(target->guard);
+        target->rotation_deadline = std::chrono::steady_clock::now() + rotation.max_file_age;
+        target->is_rotation_requested = false;
+    };
+
+    bool is_empty;
+    {
+        std::lock_guard<std::mutex> lock(target->guard);
+        is_empty = target->written_size == 0;
+    }
+
+    // nothing was written during the period: no empty segments
+    if (is_empty)
+    {
+        finish_without_rotation();
+        return;
+    }
+
+    char suffix[32];
+    auto const now = std::time(nullptr);
+    tm local_time{};
+    localtime_r(&now, &local_time);
+    std::strftime(suffix, sizeof(suffix), ".%Y%m%d-%H%M%S.", &local_time);
+
+    std::string segment_path;
+    for (size_t index = 1; ; ++index)
+    {
+        segment_path = target->file_path + suffix + std::to_string(index);
+        if (access(segment_path.c_str(), F_OK) != 0 && access((segment_path + ".gz").c_str(), F_OK) != 0)
+        {
+            break;
+        }
+    }
+
+    // writers keep appending through the open descriptor, now pointing to the segment
+    if (std::rename(target->file_path.c_str(), segment_path.c_str()) != 0)
+    {
+        finish_without_rotation();
+        return;
+    }
+
+    std::ofstream fresh_stream(target->file_path, std::ios::app);
+    if (!fresh_stream.is_open())
+    {
+        finish_without_rotation();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(target->guard);
+        target->file_stream.swap(fresh_stream);
+        target->written_size = 0;
+        target->rotation_deadline = std::chrono::steady_clock::now() + rotation.max_file_age;
+        target->is_rotation_requested = false;
+    }
+
+    // holds the previous file now: flushing and compressing it no longer concerns the writers
+    fresh_stream.close();
+
+    if (rotation.is_compressed && compress(segment_path))
+    {
+        segment_path += ".gz";
+    }
+
+    target->segments.push_back(segment_path);
+    while (rotation.kept_segments_count != 0 && target->segments.size() > rotation.kept_segments_count)
+    {
+        std::remove(target->segments.front().c_str());
+        target->segments.pop_front();
+    }
+}
+
+bool client_logger::streams_registry::compress(
+    std::string const &segment_path) noexcept
+{
+    std::ifstream source(segment_path, std::ios::binary);
+    if (!source.is_open())
+    {
+        return false;
+    }
+
+    auto const compressed_path = segment_path + ".gz";
+    gzFile compressed = gzopen(compressed_path.c_str(), "wb");
+    if (compressed == nullptr)
+    {
+        return false;
+    }
+
+    char buffer[1 << 16];
+    while (source.read(buffer, sizeof(buffer)) || source.gcount() > 0)
+    {
+        auto const read_size = static_cast<int>(source.gcount());
+        if (gzwrite(compressed, buffer, static_cast<unsigned int>(read_size)) != read_size)
+        {
+            gzclose(compressed);
+            std::remove(compressed_path.c_str());
+            return false;
+        }
+    }
+
+    if (gzclose(compressed) != Z_OK)
+    {
+        std::remove(compressed_path.c_str());
+        return false;
+    }
+
+    std::remove(segment_path.c_str());
+
+    return true;
+}
+
+client_logger::streams_registry &client_logger::streams_registry::instance()
+{
+    static streams_registry registry;
+    return registry;
+}
+
+namespace
+{
+
+    std::atomic<uint64_t> buffered_writers_count(0);
+
+    int64_t steady_nanoseconds() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+}
+
+client_logger::buffered_writer::buffered_writer(
+    std::vector<std::pair<shared_stream *, std::set<logger::severity>>> const &targets,
+    size_t max_thread_buffer_size,
+    std::chrono::milliseconds flush_interval):
+        _id(++buffered_writers_count),
+        _targets(targets),
+        _severities_mask(0),
+        _max_thread_buffer_size(max_thread_buffer_size),
+        _is_stopping(false),
+        _is_flush_requested(false)
+{
+    for (auto &target: _targets)
+    {
+        for (auto severity: target.second)
+        {
+            _severities_mask |= 1u << static_cast<unsigned int>(severity);
+        }
+    }
+
+    if (flush_interval.count() != 0)
+    {
+        _flusher = std::thread(&buffered_writer::flush_periodically, this, flush_interval);
+    }
+}
+
+client_logger::buffered_writer::~buffered_writer() noexcept
+{
+    if (_flusher.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_flusher_guard);
+            _is_stopping = true;
+        }
+        _flusher_wakeup.notify_one();
+        _flusher.join();
+    }
+
+    flush(true);
+
+    std::lock_guard<std::mutex> lock(_buffers_guard);
+    for (auto &buffer: _buffers)
+    {
+        buffer->is_orphaned.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool client_logger::buffered_writer::accepts(
+    logger::severity severity) const noexcept
+{
+    return (_severities_mask & (1u << static_cast<unsigned int>(severity))) != 0;
+}
+
+void client_logger::buffered_writer::append(
+    logger::severity severity,
+    std::string const &line) noexcept
+{
+    size_t buffered_size;
+
+    try
+    {
+        auto &buffer = get_thread_buffer();
+
+        // only a flush ever contends for this lock
+        std::lock_guard<std::mutex> lock(buffer.guard);
+
+        auto const offset = buffer.batch.text.size();
+        buffer.batch.text += line;
+        try
+        {
+            // taken under the lock, so a flush that already took this buffer started earlier
+            buffer.batch.records.push_back(record{steady_nanoseconds(), severity, offset, line.size()});
+        }
+        catch (...)
+        {
+            buffer.batch.text.resize(offset);
+            throw;
+        }
+        buffered_size = buffer.batch.text.size();
+    }
+    catch (...)
+    {
+        // out of memory for the buffer: the line is written at once, ahead of the lines still buffered
+        for (auto &target: _targets)
+        {
+            if (target.second.count(severity) != 0)
+            {
+                write_to(target.first, line);
+            }
+        }
+
+        return;
+    }
+
+    if (buffered_size < _max_thread_buffer_size)
+    {
+        return;
+    }
+
+    // with a flusher thread a full buffer only wakes it up, unless the flusher falls far behind
+    if (_flusher.joinable() && buffered_size < 4 * _max_thread_buffer_size)
+    {
+        if (!_is_flush_requested.exchange(true, std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(_flusher_guard);
+            _flusher_wakeup.notify_one();
+        }
+
+        return;
+    }
+
+    flush();
+}
+
+void client_logger::buffered_writer::flush(
+    bool is_final) noexcept
+{
+    std::lock_guard<std::mutex> flush_lock(_flush_guard);
+
+    auto const cutoff = is_final
+        ? std::numeric_limits<int64_t>::max()
+        : steady_nanoseconds();
+
+    std::vector<std::shared_ptr<thread_buffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(_buffers_guard);
+
+        // buffers of finished threads are only referenced here; drop them once drained
+        _buffers.erase(
+            std::remove_if(_buffers.begin(), _buffers.end(), [](std::shared_ptr<thread_buffer> const &buffer)
+            {
+                std::lock_guard<std::mutex> buffer_lock(buffer->guard);
+                return buffer.use_count() == 1 && buffer->batch.records.empty();
+            }),
+            _buffers.end());
+        buffers = _buffers;
+    }
+
+    std::vector<records_batch> batches(buffers.size() + 1);
+    std::swap(batches[0], _carried_over);
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        std::lock_guard<std::mutex> lock(buffers[i]->guard);
+        std::swap(batches[i + 1], buffers[i]->batch);
+    }
+
+    // every batch is ordered by itself: merge them by the heads' timestamps
+    using head = std::pair<int64_t, size_t>;
+    std::priority_queue<head, std::vector<head>, std::greater<head>> heads;
+    std::vector<size_t> positions(batches.size(), 0);
+    for (size_t i = 0; i < batches.size(); ++i)
+    {
+        if (!batches[i].records.empty())
+        {
+            heads.emplace(batches[i].records.front().timestamp, i);
+        }
+    }
+
+    std::vector<std::string> outputs(_targets.size());
+    while (!heads.empty())
+    {
+        auto const batch_index = heads.top().second;
+        heads.pop();
+
+        auto &batch = batches[batch_index];
+        auto const &merged = batch.records[positions[batch_index]];
+
+        if (merged.timestamp > cutoff)
+        {
+            _carried_over.records.push_back(record{merged.timestamp, merged.severity, _carried_over.text.size(), merged.size});
+            _carried_over.text.append(batch.text, merged.offset, merged.size);
+        }
+        else
+        {
+            for (size_t i = 0; i < _targets.size(); ++i)
+            {
+                if (_targets[i].second.count(merged.severity) != 0)
+                {
+                    outputs[i].append(batch.text, merged.offset, merged.size);
+                }
+            }
+        }
+
+        if (++positions[batch_index] < batch.records.size())
+        {
+            heads.emplace(batch.records[positions[batch_index]].timestamp, batch_index);
+        }
+    }
+
+    for (size_t i = 0; i < _targets.size(); ++i)
+    {
+        if (!outputs[i].empty())
+        {
+            write_to(_targets[i].first, outputs[i]);
+        }
+
+        std::lock_guard<std::mutex> lock(_targets[i].first->guard);
+        _targets[i].first->stream->flush();
+    }
+}
+
+client_logger::buffered_writer::thread_buffer &client_logger::buffered_writer::get_thread_buffer()
+{
+    // keyed by writer id rather than address: a new writer may reuse a destroyed one's address
+    thread_local std::unordered_map<uint64_t, std::shared_ptr<thread_buffer>> thread_buffers;
+
+    auto found = thread_buffers.find(_id);
+    if (found != thread_buffers.end())
+    {
+        return *found->second;
+    }
+
+    for (auto iterator = thread_buffers.begin(); iterator != thread_buffers.end();)
+    {
+        iterator = iterator->second->is_orphaned.load(std::memory_order_relaxed)
+            ? thread_buffers.erase(iterator)
+            : std::next(iterator);
+    }
+
+    auto created = std::make_shared<thread_buffer>();
+    created->is_orphaned.store(false, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(_buffers_guard);
+        _buffers.push_back(created);
+    }
+    thread_buffers.emplace(_id, created);
+
+    return *created;
+}
+
+void client_logger::buffered_writer::flush_periodically(
+    std::chrono::milliseconds flush_interval) noexcept
+{
+    std::unique_lock<std::mutex> lock(_flusher_guard);
+
+    while (true)
+    {
+        _flusher_wakeup.wait_for(lock, flush_interval, [this]()
+        {
+            return _is_stopping || _is_flush_requested.load(std::memory_order_relaxed);
+        });
+        if (_is_stopping)
+        {
+            return;
+        }
+
+        _is_flush_requested.store(false, std::memory_order_relaxed);
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
 client_logger::client_logger(
-    client_logger const &other)
+    std::map<std::string, std::set<logger::severity>> const &file_streams,
+    std::map<std::string, std::set<logger::severity>> const &binary_file_streams,
+    std::set<logger::severity> const &console_stream_severities,
+    logger::datetime_precision datetime_precision,
+    std::map<logger::severity, log_rate_limiter::policy> const &rate_policies,
+    std::map<std::string, std::pair<file_rotation_policy, std::set<logger::severity>>> const &rotating_file_streams,
+    size_t thread_buffer_size,
+    std::chrono::milliseconds flush_interval):
+        _console_stream(console_stream_severities.empty()
+            ? nullptr
+            : streams_registry::instance().get_console_stream()),
+        _console_stream_severities(console_stream_severities),
+        _datetime_precision(datetime_precision),
+        _rate_limiter(rate_policies.empty()
+            ? nullptr
+            : new log_rate_limiter(rate_policies)),
+        _thread_buffer_size(thread_buffer_size),
+        _flush_interval(flush_interval)
+{
+    acquire_streams(file_streams, binary_file_streams, rotating_file_streams);
+    start_buffering();
+}
+
+client_logger::client_logger(
+    client_logger const &other):
+        _console_stream(other._console_stream),
+        _console_stream_severities(other._console_stream_severities),
+        _datetime_precision(other._datetime_precision),
+        _rate_limiter(other._rate_limiter == nullptr
+            ? nullptr
+            : new log_rate_limiter(*other._rate_limiter)),
+        _thread_buffer_size(other._thread_buffer_size),
+        _flush_interval(other._flush_interval)
 {
-    throw not_implemented("client_logger::client_logger(client_logger const &other)", "your code should be here...");
+    std::map<std::string, std::set<logger::severity>> file_streams;
+    std::map<std::string, std::set<logger::severity>> binary_file_streams;
+    std::map<std::string, std::pair<file_rotation_policy, std::set<logger::severity>>> rotating_file_streams;
+
+    for (auto &file_stream: other._file_streams)
+    {
+        auto const &rotation = file_stream.second.first->rotation;
+        if (rotation.is_enabled())
+        {
+            rotating_file_streams.emplace(file_stream.first, std::make_pair(rotation, file_stream.second.second));
+        }
+        else
+        {
+            file_streams.emplace(file_stream.first, file_stream.second.second);
+        }
+    }
+    for (auto &binary_file_stream: other._binary_file_streams)
+    {
+        binary_file_streams.emplace(binary_file_stream.first, binary_file_stream.second.second);
+    }
+
+    acquire_streams(file_streams, binary_file_streams, rotating_file_streams);
+    start_buffering();
 }
 
 client_logger &client_logger::operator=(
     client_logger const &other)
 {
-    throw not_implemented("client_logger &client_logger::operator=(client_logger const &other)", "your code should be here...");
+    if (this != &other)
+    {
+        client_logger copy(other);
+        *this = std::move(copy);
+    }
+
+    return *this;
 }
 
 client_logger::client_logger(
-    client_logger &&other) noexcept
+    client_logger &&other) noexcept:
+        _file_streams(std::move(other._file_streams)),
+        _binary_file_streams(std::move(other._binary_file_streams)),
+        _console_stream(other._console_stream),
+        _console_stream_severities(std::move(other._console_stream_severities)),
+        _datetime_precision(other._datetime_precision),
+        _rate_limiter(std::move(other._rate_limiter)),
+        _thread_buffer_size(other._thread_buffer_size),
+        _flush_interval(other._flush_interval),
+        _buffered_writer(std::move(other._buffered_writer))
 {
-    throw not_implemented("client_logger::client_logger(client_logger &&other) noexcept", "your code should be here...");
+    other._file_streams.clear();
+    other._binary_file_streams.clear();
+    other._console_stream = nullptr;
 }
 
 client_logger &client_logger::operator=(
     client_logger &&other) noexcept
 {
-    throw not_implemented("client_logger &client_logger::operator=(client_logger &&other) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        // buffered lines are written before their streams are released
+        _buffered_writer.reset();
+        release_streams();
+
+        _file_streams = std::move(other._file_streams);
+        _binary_file_streams = std::move(other._binary_file_streams);
+        _console_stream = other._console_stream;
+        _console_stream_severities = std::move(other._console_stream_severities);
+        _datetime_precision = other._datetime_precision;
+        _rate_limiter = std::move(other._rate_limiter);
+        _thread_buffer_size = other._thread_buffer_size;
+        _flush_interval = other._flush_interval;
+        _buffered_writer = std::move(other._buffered_writer);
+
+        other._file_streams.clear();
+        other._binary_file_streams.clear();
+        other._console_stream = nullptr;
+    }
+
+    return *this;
 }
 
 client_logger::~client_logger() noexcept
 {
-    throw not_implemented("client_logger::~client_logger() noexcept", "your code should be here...");
+    _buffered_writer.reset();
+    release_streams();
 }
 
 logger const *client_logger::log(
     const std::string &text,
     logger::severity severity) const noexcept
 {
-    throw not_implemented("logger const *client_logger::log(const std::string &text, logger::severity severity) const noexcept", "your code should be here...");
-}
\ No newline at end of file
+    return log(logger::message_view(text).with_call_site(__builtin_return_address(0)), severity);
+}
+
+logger const *client_logger::log(
+    logger::message_view text,
+    logger::severity severity) const noexcept
+{
+    if (!admit(severity, text.with_call_site(__builtin_return_address(0)).get_call_site()))
+    {
+        return this;
+    }
+
+    write_text(severity, text);
+
+    if (!_binary_file_streams.empty())
+    {
+        logger::format_argument const message(text.data(), text.size());
+        write_binary(severity, nullptr, &message, 1);
+    }
+
+    return this;
+}
+
+logger const *client_logger::log_structured(
+    logger::severity severity,
+    char const *format,
+    logger::format_argument const *arguments,
+    size_t arguments_count) const noexcept
+{
+    if (!admit(severity, format))
+    {
+        return this;
+    }
+
+    bool text_is_needed = _console_stream != nullptr && _console_stream_severities.count(severity) != 0;
+    for (auto &file_stream: _file_streams)
+    {
+        text_is_needed = text_is_needed || file_stream.second.second.count(severity) != 0;
+    }
+
+    if (text_is_needed)
+    {
+        write_text(severity, render_format(format, arguments, arguments_count));
+    }
+
+    write_binary(severity, format, arguments, arguments_count);
+
+    return this;
+}
+
+unsigned long long client_logger::get_suppressed_count(
+    logger::severity severity) const noexcept
+{
+    return _rate_limiter == nullptr
+        ? 0
+        : _rate_limiter->get_suppressed_count(severity);
+}
+
+logger const *client_logger::flush() const noexcept
+{
+    // the buffered writer covers the text streams only
+    if (_buffered_writer != nullptr)
+    {
+        _buffered_writer->flush();
+    }
+
+    auto flush_stream = [](shared_stream *target)
+    {
+        std::lock_guard<std::mutex> lock(target->guard);
+        target->stream->flush();
+    };
+
+    for (auto &file_stream: _file_streams)
+    {
+        flush_stream(file_stream.second.first);
+    }
+    for (auto &binary_file_stream: _binary_file_streams)
+    {
+        flush_stream(binary_file_stream.second.first);
+    }
+    if (_console_stream != nullptr)
+    {
+        flush_stream(_console_stream);
+    }
+
+    return this;
+}
+
+void client_logger::start_buffering()
+{
+    if (_thread_buffer_size == 0)
+    {
+        return;
+    }
+
+    std::vector<std::pair<shared_stream *, std::set<logger::severity>>> targets;
+    for (auto &file_stream: _file_streams)
+    {
+        targets.push_back(file_stream.second);
+    }
+    if (_console_stream != nullptr)
+    {
+        targets.emplace_back(_console_stream, _console_stream_severities);
+    }
+
+    try
+    {
+        _buffered_writer.reset(new buffered_writer(targets, _thread_buffer_size, _flush_interval));
+    }
+    catch (...)
+    {
+        release_streams();
+        throw;
+    }
+}
+
+bool client_logger::admit(
+    logger::severity severity,
+    void const *message_template) const noexcept
+{
+    if (_rate_limiter == nullptr)
+    {
+        return true;
+    }
+
+    if (!_rate_limiter->admit(severity, message_template))
+    {
+        return false;
+    }
+
+    auto const suppressed = _rate_limiter->take_unreported(severity);
+    if (suppressed != 0)
+    {
+        auto const notice = std::to_string(suppressed) + " lines suppressed by rate limiting";
+        write_text(severity, notice);
+
+        logger::format_argument const notice_argument(notice);
+        write_binary(severity, nullptr, &notice_argument, 1);
+    }
+
+    return true;
+}
+
+void client_logger::acquire_streams(
+    std::map<std::string, std::set<logger::severity>> const &file_streams,
+    std::map<std::string, std::set<logger::severity>> const &binary_file_streams,
+    std::map<std::string, std::pair<file_rotation_policy, std::set<logger::severity>>> const &rotating_file_streams)
+{
+    // two spellings of one file's path share its stream and get the union of their severities
+    auto add_stream = [](
+        std::map<std::string, std::pair<shared_stream *, std::set<logger::severity>>> &streams,
+        std::string const &stream_file_path,
+        shared_stream *acquired,
+        std::set<logger::severity> const &severities)
+    {
+        for (auto &stream: streams)
+        {
+            if (stream.second.first == acquired)
+            {
+                streams_registry::instance().release(acquired);
+                stream.second.second.insert(severities.begin(), severities.end());
+                return;
+            }
+        }
+
+        streams.emplace(stream_file_path, std::make_pair(acquired, severities));
+    };
+
+    try
+    {
+        for (auto &file_stream: file_streams)
+        {
+            add_stream(_file_streams, file_stream.first, streams_registry::instance().acquire(file_stream.first, false), file_stream.second);
+        }
+
+        for (auto &rotating_file_stream: rotating_file_streams)
+        {
+            if (_file_streams.count(rotating_file_stream.first) != 0)
+            {
+                throw std::logic_error("file stream \"" + rotating_file_stream.first + "\" is configured both with and without rotation");
+            }
+
+            add_stream(
+                _file_streams,
+                rotating_file_stream.first,
+                streams_registry::instance().acquire(rotating_file_stream.first, false, rotating_file_stream.second.first),
+                rotating_file_stream.second.second);
+        }
+
+        for (auto &binary_file_stream: binary_file_streams)
+        {
+            add_stream(
+                _binary_file_streams,
+                binary_file_stream.first,
+                streams_registry::instance().acquire(binary_file_stream.first, true),
+                binary_file_stream.second);
+        }
+    }
+    catch (...)
+    {
+        release_streams();
+        throw;
+    }
+}
+
+void client_logger::release_streams() noexcept
+{
+    for (auto &file_stream: _file_streams)
+    {
+        streams_registry::instance().release(file_stream.second.first);
+    }
+    for (auto &binary_file_stream: _binary_file_streams)
+    {
+        streams_registry::instance().release(binary_file_stream.second.first);
+    }
+
+    _file_streams.clear();
+    _binary_file_streams.clear();
+}
+
+void client_logger::write_text(
+    logger::severity severity,
+    logger::message_view message) const noexcept
+{
+    // reused between calls, so steady-state logging does not allocate
+    thread_local std::string line;
+    bool is_formatted = false;
+
+    auto formatted_line = [this, &is_formatted, message, severity]() -> std::string const &
+    {
+        if (!is_formatted)
+        {
+            line.clear();
+            line += '[';
+            append_current_datetime(line, _datetime_precision);
+            line += "][";
+            line += severity_to_c_string(severity);
+            line += "] ";
+            line.append(message.data(), message.size());
+            line += '\n';
+            is_formatted = true;
+        }
+
+        return line;
+    };
+
+    if (_buffered_writer != nullptr)
+    {
+        if (_buffered_writer->accepts(severity))
+        {
+            _buffered_writer->append(severity, formatted_line());
+        }
+
+        return;
+    }
+
+    for (auto &file_stream: _file_streams)
+    {
+        if (file_stream.second.second.count(severity) != 0)
+        {
+            write_to(file_stream.second.first, formatted_line());
+        }
+    }
+
+    if (_console_stream != nullptr && _console_stream_severities.count(severity) != 0)
+    {
+        write_to(_console_stream, formatted_line());
+    }
+}
+
+void client_logger::write_binary(
+    logger::severity severity,
+    char const *format,
+    logger::format_argument const *arguments,
+    size_t arguments_count) const noexcept
+{
+    if (_binary_file_streams.empty())
+    {
+        return;
+    }
+
+    // reused between calls, so steady-state binary logging does not allocate
+    thread_local std::string record;
+
+    auto const timestamp = binary_log_format::current_timestamp();
+
+    for (auto &binary_file_stream: _binary_file_streams)
+    {
+        if (binary_file_stream.second.second.count(severity) == 0)
+        {
+            continue;
+        }
+
+        auto *target = binary_file_stream.second.first;
+        std::lock_guard<std::mutex> lock(target->guard);
+
+        record.clear();
+        auto const format_id = format == nullptr
+            ? binary_log_format::raw_message_format_id
+            : target->formats.intern(record, format);
+        binary_log_format::append_record(record, timestamp, severity, format_id, arguments, arguments_count);
+
+        target->stream->write(record.data(), static_cast<std::streamsize>(record.size()));
+    }
+}
+
+void client_logger::write_to(
+    shared_stream *target,
+    std::string const &line) noexcept
+{
+    bool is_rotation_due = false;
+
+    {
+        std::lock_guard<std::mutex> lock(target->guard);
+        target->stream->write(line.data(), static_cast<std::streamsize>(line.size()));
+
+        if (target->rotation.is_enabled())
+        {
+            target->written_size += line.size();
+            if (target->rotation.max_file_size != 0
+                && target->written_size >= target->rotation.max_file_size
+                && !target->is_rotation_requested)
+            {
+                target->is_rotation_requested = true;
+                is_rotation_due = true;
+            }
+        }
+    }
+
+    // outside of the stream's mutex: the worker locks the registry before any stream
+    if (is_rotation_due)
+    {
+        streams_registry::instance().request_rotation(target);
+    }
+}
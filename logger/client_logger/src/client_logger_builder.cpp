@@ -1,67 +1,147 @@
-#include <not_implemented.h>
+#include <logger_configuration.h>
 
 #include "../include/client_logger_builder.h"
+#include "../include/client_logger.h"
 
-client_logger_builder::client_logger_builder()
+client_logger_builder::client_logger_builder():
+    _datetime_precision(logger::datetime_precision::seconds),
+    _thread_buffer_size(0),
+    _flush_interval(0)
 {
-    throw not_implemented("client_logger_builder::client_logger_builder()", "your code should be here...");
+
 }
 
 client_logger_builder::client_logger_builder(
-    client_logger_builder const &other)
+    client_logger_builder const &other) = default;
+
+client_logger_builder &client_logger_builder::operator=(
+    client_logger_builder const &other) = default;
+
+client_logger_builder::client_logger_builder(
+    client_logger_builder &&other) noexcept = default;
+
+client_logger_builder &client_logger_builder::operator=(
+    client_logger_builder &&other) noexcept = default;
+
+client_logger_builder::~client_logger_builder() noexcept = default;
+
+logger_builder *client_logger_builder::add_file_stream(
+    std::string const &stream_file_path,
+    logger::severity severity)
 {
-    throw not_implemented("client_logger_builder::client_logger_builder(client_logger_builder const &other)", "your code should be here...");
+    _file_streams[stream_file_path].insert(severity);
+
+    return this;
 }
 
-client_logger_builder &client_logger_builder::operator=(
-    client_logger_builder const &other)
+logger_builder *client_logger_builder::add_console_stream(
+    logger::severity severity)
 {
-    throw not_implemented("client_logger_builder &client_logger_builder::operator=(client_logger_builder const &other)", "your code should be here...");
+    _console_stream_severities.insert(severity);
+
+    return this;
 }
 
-client_logger_builder::client_logger_builder(
-    client_logger_builder &&other) noexcept
+client_logger_builder *client_logger_builder::add_binary_file_stream(
+    std::string const &stream_file_path,
+    logger::severity severity)
 {
-    throw not_implemented("client_logger_builder::client_logger_builder(client_logger_builder &&other) noexcept", "your code should be here...");
+    _binary_file_streams[stream_file_path].insert(severity);
+
+    return this;
 }
 
-client_logger_builder &client_logger_builder::operator=(
-    client_logger_builder &&other) noexcept
+client_logger_builder *client_logger_builder::add_rotating_file_stream(
+    std::string const &stream_file_path,
+    logger::severity severity,
+    file_rotation_policy const &rotation)
 {
-    throw not_implemented("client_logger_builder &client_logger_builder::operator=(client_logger_builder &&other) noexcept", "your code should be here...");
+    auto &rotating_file_stream = _rotating_file_streams[stream_file_path];
+    rotating_file_stream.first = rotation;
+    rotating_file_stream.second.insert(severity);
+
+    return this;
 }
 
-client_logger_builder::~client_logger_builder() noexcept
+client_logger_builder *client_logger_builder::set_datetime_precision(
+    logger::datetime_precision precision)
 {
-    throw not_implemented("client_logger_builder::~client_logger_builder() noexcept", "your code should be here...");
+    _datetime_precision = precision;
+
+    return this;
 }
 
-logger_builder *client_logger_builder::add_file_stream(
-    std::string const &stream_file_path,
-    logger::severity severity)
+client_logger_builder *client_logger_builder::set_rate_limit(
+    logger::severity severity,
+    double lines_per_second,
+    size_t burst)
 {
-    throw not_implemented("logger_builder *client_logger_builder::add_file_stream(std::string const &stream_file_path, logger::severity severity)", "your code should be here...");
+    auto &policy = _rate_policies[severity];
+    policy.lines_per_second = lines_per_second;
+    policy.burst = burst;
+
+    return this;
 }
 
-logger_builder *client_logger_builder::add_console_stream(
-    logger::severity severity)
+client_logger_builder *client_logger_builder::set_sampling(
+    logger::severity severity,
+    size_t period)
+{
+    _rate_policies[severity].sampling_period = period;
+
+    return this;
+}
+
+client_logger_builder *client_logger_builder::set_thread_buffering(
+    size_t max_thread_buffer_size,
+    std::chrono::milliseconds flush_interval)
 {
-    throw not_implemented("logger_builder *client_logger_builder::add_console_stream(logger::severity severity)", "your code should be here...");
+    _thread_buffer_size = max_thread_buffer_size;
+    _flush_interval = flush_interval;
+
+    return this;
 }
 
 logger_builder* client_logger_builder::transform_with_configuration(
     std::string const &configuration_file_path,
     std::string const &configuration_path)
 {
-    throw not_implemented("logger_builder* client_logger_builder::transform_with_configuration(std::string const &configuration_file_path, std::string const &configuration_path)", "your code should be here...");
+    auto const configuration = logger_configuration::load(configuration_file_path, configuration_path);
+
+    for (auto &file_stream: configuration.get_file_streams())
+    {
+        _file_streams[file_stream.first].insert(file_stream.second.begin(), file_stream.second.end());
+    }
+    for (auto &binary_file_stream: configuration.get_binary_file_streams())
+    {
+        _binary_file_streams[binary_file_stream.first].insert(binary_file_stream.second.begin(), binary_file_stream.second.end());
+    }
+    _console_stream_severities.insert(
+        configuration.get_console_stream_severities().begin(),
+        configuration.get_console_stream_severities().end());
+    if (configuration.has_datetime_precision())
+    {
+        _datetime_precision = configuration.get_datetime_precision();
+    }
+
+    return this;
 }
 
 logger_builder *client_logger_builder::clear()
 {
-    throw not_implemented("logger_builder *client_logger_builder::clear()", "your code should be here...");
+    _file_streams.clear();
+    _binary_file_streams.clear();
+    _rotating_file_streams.clear();
+    _console_stream_severities.clear();
+    _datetime_precision = logger::datetime_precision::seconds;
+    _rate_policies.clear();
+    _thread_buffer_size = 0;
+    _flush_interval = std::chrono::milliseconds(0);
+
+    return this;
 }
 
 logger *client_logger_builder::build() const
 {
-    throw not_implemented("logger *client_logger_builder::build() const", "your code should be here...");
-}
\ No newline at end of file
+    return new client_logger(_file_streams, _binary_file_streams, _console_stream_severities, _datetime_precision, _rate_policies, _rotating_file_streams, _thread_buffer_size, _flush_interval);
+}
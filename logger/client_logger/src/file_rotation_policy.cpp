@@ -0,0 +1,30 @@
+#include "../include/file_rotation_policy.h"
+
+file_rotation_policy::file_rotation_policy() noexcept:
+    max_file_size(0),
+    max_file_age(0),
+    kept_segments_count(0),
+    is_compressed(false)
+{
+
+}
+
+bool file_rotation_policy::is_enabled() const noexcept
+{
+    return max_file_size != 0 || max_file_age.count() != 0;
+}
+
+bool file_rotation_policy::operator==(
+    file_rotation_policy const &other) const noexcept
+{
+    return max_file_size == other.max_file_size
+        && max_file_age == other.max_file_age
+        && kept_segments_count == other.kept_segments_count
+        && is_compressed == other.is_compressed;
+}
+
+bool file_rotation_policy::operator!=(
+    file_rotation_policy const &other) const noexcept
+{
+    return !(*this == other);
+}
@@ -1,6 +1,1110 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <thread>
 
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <binary_log_format.h>
+#include <client_logger.h>
+#include <inline_message.h>
+#include <logger_guardant.h>
+#include <reloadable_logger.h>
+
+namespace
+{
+
+    // heap allocations made by the current thread, counted by the replaced operator new below
+    thread_local size_t heap_allocations_count = 0;
+
+}
+
+void *operator new(
+    size_t size)
+{
+    ++heap_allocations_count;
+
+    if (auto *allocated = std::malloc(size == 0
+        ? 1
+        : size))
+    {
+        return allocated;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(
+    void *at) noexcept
+{
+    std::free(at);
+}
+
+void operator delete(
+    void *at,
+    size_t) noexcept
+{
+    std::free(at);
+}
+
+namespace
+{
+
+    class guarded_component final:
+        private logger_guardant
+    {
+
+    private:
+
+        logger *_logger;
+
+    public:
+
+        explicit guarded_component(
+            logger *used_logger):
+                _logger(used_logger)
+        {
+
+        }
+
+    public:
+
+        void report(
+            size_t size) const
+        {
+            inline_message<64> message;
+            message << "reported " << size << " bytes";
+
+            information_with_guard(message);
+            trace_with_guard("not logged");
+        }
+
+        void warn(
+            std::string const &text) const
+        {
+            warning_with_guard(text);
+        }
+
+    private:
+
+        logger *get_logger() const override
+        {
+            return _logger;
+        }
+
+    };
+
+    class sampled_component final:
+        private logger_guardant
+    {
+
+    private:
+
+        logger *_logger;
+
+    public:
+
+        explicit sampled_component(
+            logger *used_logger):
+                _logger(used_logger)
+        {
+
+        }
+
+    public:
+
+        void hot(
+            size_t iteration) const
+        {
+            inline_message<64> message;
+            message << "hot " << iteration;
+
+            information_with_guard(message);
+        }
+
+        void rare() const
+        {
+            information_with_guard("rare");
+        }
+
+    private:
+
+        logger *get_logger() const override
+        {
+            return _logger;
+        }
+
+    };
+
+    std::string current_directory_name()
+    {
+        char working_directory[4096];
+        if (getcwd(working_directory, sizeof(working_directory)) == nullptr)
+        {
+            return std::string();
+        }
+
+        std::string const path(working_directory);
+        return path.substr(path.rfind('/') + 1);
+    }
+
+    std::vector<std::string> read_lines(
+        std::string const &file_path)
+    {
+        std::ifstream stream(file_path);
+        std::vector<std::string> lines;
+        std::string line;
+
+        while (std::getline(stream, line))
+        {
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+
+    /*
+     * Files in the working directory whose names start with prefix, sorted.
+     */
+    std::vector<std::string> list_files(
+        std::string const &prefix)
+    {
+        std::vector<std::string> file_names;
+
+        DIR *directory = opendir(".");
+        while (auto *entry = readdir(directory))
+        {
+            std::string const file_name = entry->d_name;
+            if (file_name.compare(0, prefix.size(), prefix) == 0)
+            {
+                file_names.push_back(file_name);
+            }
+        }
+        closedir(directory);
+
+        std::sort(file_names.begin(), file_names.end());
+
+        return file_names;
+    }
+
+    void remove_files(
+        std::string const &prefix)
+    {
+        for (auto &file_name: list_files(prefix))
+        {
+            std::remove(file_name.c_str());
+        }
+    }
+
+    template<
+        typename predicate>
+    bool wait_until(
+        predicate condition)
+    {
+        for (size_t i = 0; i < 300 && !condition(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return condition();
+    }
+
+    void write_file(
+        std::string const &file_path,
+        std::string const &contents)
+    {
+        // written aside and renamed over the target, as editors do
+        std::string const temporary_file_path = file_path + ".tmp";
+        {
+            std::ofstream stream(temporary_file_path);
+            stream << contents;
+        }
+        std::rename(temporary_file_path.c_str(), file_path.c_str());
+    }
+
+}
+
+TEST(client_logger_tests, severity_filtering)
+{
+    std::string const file_path = "client_logger_tests_severity_filtering.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::warning);
+    builder.add_file_stream(file_path, logger::severity::error);
+
+    logger *built_logger = builder.build();
+    built_logger
+        ->debug("skipped")
+        ->warning("first")
+        ->information("skipped")
+        ->error("second");
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("[WARNING] first"), std::string::npos);
+    EXPECT_NE(lines[1].find("[ERROR] second"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, string_overloads_are_kept)
+{
+    std::string const file_path = "client_logger_tests_string_overloads_are_kept.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.add_file_stream(file_path, logger::severity::warning);
+
+    logger *built_logger = builder.build();
+
+    // the signatures callers compiled against before the message_view overloads
+    logger const *(logger::*information)(std::string const &) const = &logger::information;
+    logger_guardant const *(logger_guardant::*warning_with_guard)(std::string const &) const = &logger_guardant::warning_with_guard;
+    EXPECT_NE(warning_with_guard, nullptr);
+
+    std::string const text = "from std::string";
+    (built_logger->*information)(text);
+    guarded_component(built_logger).warn(text);
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("[INFORMATION] from std::string"), std::string::npos);
+    EXPECT_NE(lines[1].find("[WARNING] from std::string"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, loggers_share_file_stream)
+{
+    std::string const file_path = "client_logger_tests_shared_stream.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+
+    logger *first_logger = builder.build();
+    logger *second_logger = builder.build();
+
+    first_logger->information("first");
+    second_logger->information("second");
+    delete first_logger;
+
+    // the stream is still referenced by the second logger, so it must stay open
+    second_logger->information("third");
+    delete second_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_NE(lines[0].find("first"), std::string::npos);
+    EXPECT_NE(lines[1].find("second"), std::string::npos);
+    EXPECT_NE(lines[2].find("third"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, spellings_of_a_path_share_file_stream)
+{
+    std::string const file_path = "client_logger_tests_spellings.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder first_builder;
+    first_builder.add_file_stream(file_path, logger::severity::information);
+
+    client_logger_builder second_builder;
+    second_builder
+        .add_file_stream("./" + file_path, logger::severity::information)
+        ->add_file_stream("../" + current_directory_name() + "/" + file_path, logger::severity::information);
+
+    logger *first_logger = first_builder.build();
+    logger *second_logger = second_builder.build();
+
+    // with a stream per spelling, the second logger's line would reach the file first, and twice
+    first_logger->information("first");
+    second_logger->information("second");
+    delete second_logger;
+    delete first_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("first"), std::string::npos);
+    EXPECT_NE(lines[1].find("second"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, symbolic_link_shares_file_stream)
+{
+    std::string const file_path = "client_logger_tests_link_target.txt";
+    std::string const link_path = "client_logger_tests_link.txt";
+    std::remove(file_path.c_str());
+    std::remove(link_path.c_str());
+    ASSERT_EQ(symlink(file_path.c_str(), link_path.c_str()), 0);
+
+    // the target doesn't exist yet: the link is keyed by it all the same
+    client_logger_builder builder;
+    builder
+        .add_file_stream(file_path, logger::severity::information)
+        ->add_file_stream(link_path, logger::severity::information);
+
+    logger *built_logger = builder.build();
+    built_logger->information("once");
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_NE(lines[0].find("once"), std::string::npos);
+
+    std::remove(link_path.c_str());
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, missing_directory_fails_without_creating_files)
+{
+    std::string const directory = "client_logger_tests_missing_directory";
+    rmdir(directory.c_str());
+
+    client_logger_builder builder;
+    builder
+        .add_file_stream(directory + "/log.txt", logger::severity::information);
+
+    EXPECT_THROW(delete builder.build(), std::runtime_error);
+
+    struct stat status{};
+    EXPECT_EQ(stat(directory.c_str(), &status), -1);
+}
+
+TEST(client_logger_tests, copied_logger_keeps_stream_alive)
+{
+    std::string const file_path = "client_logger_tests_copied_logger.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+
+    auto *original = dynamic_cast<client_logger *>(builder.build());
+    ASSERT_NE(original, nullptr);
+
+    auto *copy = new client_logger(*original);
+    delete original;
+
+    copy->information("after original destruction");
+    delete copy;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_NE(lines[0].find("after original destruction"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, concurrent_writers_do_not_interleave)
+{
+    std::string const file_path = "client_logger_tests_concurrent_writers.txt";
+    std::remove(file_path.c_str());
+
+    size_t const threads_count = 8;
+    size_t const messages_per_thread = 1000;
+    std::string const message(64, 'x');
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+
+    std::vector<logger *> loggers;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        loggers.push_back(builder.build());
+    }
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        threads.emplace_back([&loggers, &message, messages_per_thread, i]()
+        {
+            for (size_t j = 0; j < messages_per_thread; ++j)
+            {
+                loggers[i]->information(message);
+            }
+        });
+    }
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+    for (auto *built_logger: loggers)
+    {
+        delete built_logger;
+    }
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), threads_count * messages_per_thread);
+    for (auto &line: lines)
+    {
+        ASSERT_EQ(line.substr(line.size() - message.size()), message);
+        ASSERT_NE(line.find("[INFORMATION] "), std::string::npos);
+    }
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, sub_second_datetime_precision)
+{
+    std::string const file_path = "client_logger_tests_datetime_precision.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder
+        .set_datetime_precision(logger::datetime_precision::milliseconds)
+        ->add_file_stream(file_path, logger::severity::information);
+
+    logger *built_logger = builder.build();
+    built_logger->information("first")->information("second");
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 2);
+    for (auto &line: lines)
+    {
+        // [dd.mm.yyyy hh:mm:ss.mmm]
+        ASSERT_GE(line.size(), 25);
+        EXPECT_EQ(line[0], '[');
+        EXPECT_EQ(line[20], '.');
+        EXPECT_EQ(line[24], ']');
+    }
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, binary_stream_decodes_to_text_lines)
+{
+    std::string const file_path = "client_logger_tests_binary_stream.bin";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_binary_file_stream(file_path, logger::severity::information);
+    builder.add_binary_file_stream(file_path, logger::severity::error);
+
+    logger *built_logger = builder.build();
+    built_logger->information("plain message");
+    built_logger->log_format(logger::severity::error, "allocated {} bytes at {} ({})", 64, 0xFFu, "first fit");
+    built_logger->log_format(logger::severity::debug, "filtered {}", 1);
+    built_logger->log_format(logger::severity::information, "ratio {}", 0.5);
+    built_logger->log_format(logger::severity::error, "allocated {} bytes at {} ({})", -1, 0u, std::string("worst fit"));
+    delete built_logger;
+
+    std::ifstream stream(file_path, std::ios::binary);
+    binary_log_format::decoder decoder(stream);
+    std::vector<std::string> lines;
+    std::string line;
+    while (decoder.next(line))
+    {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(lines.size(), 4);
+    EXPECT_NE(lines[0].find("][INFORMATION] plain message"), std::string::npos);
+    EXPECT_NE(lines[1].find("][ERROR] allocated 64 bytes at 255 (first fit)"), std::string::npos);
+    EXPECT_NE(lines[2].find("][INFORMATION] ratio 0.5"), std::string::npos);
+    EXPECT_NE(lines[3].find("][ERROR] allocated -1 bytes at 0 (worst fit)"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, binary_stream_flags_clamped_records)
+{
+    std::string const file_path = "client_logger_tests_binary_clamped.bin";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_binary_file_stream(file_path, logger::severity::information);
+
+    logger *built_logger = builder.build();
+    std::vector<logger::format_argument> const arguments(300, logger::format_argument(7));
+    built_logger->log_structured(logger::severity::information, "{} and {}", arguments.data(), arguments.size());
+
+    // the same format at another address shares its dictionary entry
+    char const format_copy[] = "{} and {}";
+    built_logger->log_format(logger::severity::information, format_copy, 1, 2);
+    delete built_logger;
+
+    std::ifstream stream(file_path, std::ios::binary);
+    binary_log_format::decoder decoder(stream);
+    std::vector<std::string> lines;
+    std::string line;
+    while (decoder.next(line))
+    {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("][INFORMATION] 7 and 7 [truncated]"), std::string::npos);
+    EXPECT_NE(lines[1].find("][INFORMATION] 1 and 2"), std::string::npos);
+    EXPECT_EQ(lines[1].find("[truncated]"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, structured_call_renders_text_streams)
+{
+    std::string const file_path = "client_logger_tests_structured_text.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::warning);
+
+    logger *built_logger = builder.build();
+    built_logger->log_format(logger::severity::warning, "{} of {} blocks free, {}", 3, 8, "ok");
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_NE(lines[0].find("[WARNING] 3 of 8 blocks free, ok"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, rate_limit_suppresses_and_reports_lines)
+{
+    std::string const file_path = "client_logger_tests_rate_limit.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::warning);
+    builder.add_file_stream(file_path, logger::severity::error);
+    builder.set_rate_limit(logger::severity::warning, 20, 3);
+
+    logger *built_logger = builder.build();
+    for (size_t i = 0; i < 10; ++i)
+    {
+        built_logger->warning("flood");
+    }
+    built_logger->error("not limited");
+
+    auto *limited_logger = dynamic_cast<client_logger *>(built_logger);
+    ASSERT_NE(limited_logger, nullptr);
+    EXPECT_EQ(limited_logger->get_suppressed_count(logger::severity::warning), 7);
+    EXPECT_EQ(limited_logger->get_suppressed_count(logger::severity::error), 0);
+
+    // the bucket refills at 20 lines per second
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    built_logger->warning("after refill");
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 6);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_NE(lines[i].find("[WARNING] flood"), std::string::npos);
+    }
+    EXPECT_NE(lines[3].find("[ERROR] not limited"), std::string::npos);
+    EXPECT_NE(lines[4].find("[WARNING] 7 lines suppressed by rate limiting"), std::string::npos);
+    EXPECT_NE(lines[5].find("[WARNING] after refill"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, sampling_passes_one_in_period_per_template)
+{
+    std::string const file_path = "client_logger_tests_sampling.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::debug);
+    builder.set_sampling(logger::severity::debug, 4);
+
+    logger *built_logger = builder.build();
+    for (int i = 0; i < 12; ++i)
+    {
+        built_logger->log_format(logger::severity::debug, "sampled {}", i);
+    }
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 5);
+    EXPECT_NE(lines[0].find("[DEBUG] sampled 0"), std::string::npos);
+    EXPECT_NE(lines[1].find("[DEBUG] 3 lines suppressed by rate limiting"), std::string::npos);
+    EXPECT_NE(lines[2].find("[DEBUG] sampled 4"), std::string::npos);
+    EXPECT_NE(lines[3].find("[DEBUG] 3 lines suppressed by rate limiting"), std::string::npos);
+    EXPECT_NE(lines[4].find("[DEBUG] sampled 8"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, sampling_sequences_are_kept_per_severity)
+{
+    std::string const file_path = "client_logger_tests_sampling_per_severity.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::debug);
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.set_sampling(logger::severity::debug, 2);
+    builder.set_sampling(logger::severity::information, 2);
+
+    logger *built_logger = builder.build();
+
+    // one call site for both severities
+    char const *const format = "sampled {}";
+    for (int i = 0; i < 3; ++i)
+    {
+        built_logger->log_format(logger::severity::debug, format, i);
+        built_logger->log_format(logger::severity::information, format, i);
+    }
+
+    // the text of a plain call differs from line to line, its call site does not
+    for (int i = 0; i < 3; ++i)
+    {
+        built_logger->information("plain " + std::to_string(i));
+    }
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 9);
+    EXPECT_NE(lines[0].find("[DEBUG] sampled 0"), std::string::npos);
+    EXPECT_NE(lines[1].find("[INFORMATION] sampled 0"), std::string::npos);
+    EXPECT_NE(lines[2].find("[DEBUG] 1 lines suppressed by rate limiting"), std::string::npos);
+    EXPECT_NE(lines[3].find("[DEBUG] sampled 2"), std::string::npos);
+    EXPECT_NE(lines[4].find("[INFORMATION] 1 lines suppressed by rate limiting"), std::string::npos);
+    EXPECT_NE(lines[5].find("[INFORMATION] sampled 2"), std::string::npos);
+    EXPECT_NE(lines[6].find("[INFORMATION] plain 0"), std::string::npos);
+    EXPECT_NE(lines[7].find("[INFORMATION] 1 lines suppressed by rate limiting"), std::string::npos);
+    EXPECT_NE(lines[8].find("[INFORMATION] plain 2"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, plain_call_sites_are_sampled_apart)
+{
+    std::string const file_path = "client_logger_tests_sampling_call_sites.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.set_sampling(logger::severity::information, 2);
+
+    logger *built_logger = builder.build();
+    sampled_component const component(built_logger);
+
+    // the hot call site's sequence does not suppress the first call of the rare one
+    component.hot(0);
+    component.hot(1);
+    component.rare();
+    component.hot(2);
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 4);
+    EXPECT_NE(lines[0].find("[INFORMATION] hot 0"), std::string::npos);
+    EXPECT_NE(lines[1].find("[INFORMATION] 1 lines suppressed by rate limiting"), std::string::npos);
+    EXPECT_NE(lines[2].find("[INFORMATION] rare"), std::string::npos);
+    EXPECT_NE(lines[3].find("[INFORMATION] hot 2"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, rotation_by_size_keeps_every_line_whole)
+{
+    std::string const file_path = "client_logger_tests_rotation_size.txt";
+    remove_files(file_path);
+
+    file_rotation_policy rotation;
+    rotation.max_file_size = 1024;
+
+    client_logger_builder builder;
+    builder.add_rotating_file_stream(file_path, logger::severity::information, rotation);
+
+    size_t const lines_count = 200;
+    logger *built_logger = builder.build();
+    for (size_t i = 0; i < lines_count; ++i)
+    {
+        built_logger->information("line " + std::to_string(i));
+        // writers never wait for a rotation: without pauses every line may land in the first segment
+        if (i % 20 == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    delete built_logger;
+
+    // segments are flushed by the rotation worker, which may still be running
+    std::vector<std::string> lines;
+    EXPECT_TRUE(wait_until([&file_path, &lines, lines_count]()
+    {
+        lines.clear();
+        for (auto &segment: list_files(file_path))
+        {
+            auto const segment_lines = read_lines(segment);
+            lines.insert(lines.end(), segment_lines.begin(), segment_lines.end());
+        }
+
+        return lines.size() == lines_count;
+    }));
+
+    EXPECT_GE(list_files(file_path + ".").size(), 3);
+
+    std::set<std::string> messages;
+    for (auto &line: lines)
+    {
+        auto const message_position = line.find("[INFORMATION] line ");
+        ASSERT_NE(message_position, std::string::npos);
+        messages.insert(line.substr(message_position));
+    }
+    EXPECT_EQ(messages.size(), lines_count);
+
+    remove_files(file_path);
+}
+
+TEST(client_logger_tests, rotation_compresses_and_prunes_segments)
+{
+    std::string const file_path = "client_logger_tests_rotation_compressed.txt";
+    remove_files(file_path);
+
+    file_rotation_policy rotation;
+    rotation.max_file_size = 512;
+    rotation.kept_segments_count = 2;
+    rotation.is_compressed = true;
+
+    client_logger_builder builder;
+    builder.add_rotating_file_stream(file_path, logger::severity::information, rotation);
+
+    logger *built_logger = builder.build();
+    for (size_t i = 0; i < 200; ++i)
+    {
+        built_logger->information("line " + std::to_string(i));
+        if (i % 20 == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    delete built_logger;
+
+    EXPECT_TRUE(wait_until([&file_path]()
+    {
+        auto const segments = list_files(file_path + ".");
+        return segments.size() == 2
+            && std::all_of(segments.begin(), segments.end(), [](std::string const &segment)
+            {
+                return segment.size() > 3 && segment.compare(segment.size() - 3, 3, ".gz") == 0;
+            });
+    }));
+
+    remove_files(file_path);
+}
+
+TEST(client_logger_tests, rotation_by_time)
+{
+    std::string const file_path = "client_logger_tests_rotation_time.txt";
+    remove_files(file_path);
+
+    file_rotation_policy rotation;
+    rotation.max_file_age = std::chrono::seconds(1);
+
+    client_logger_builder builder;
+    builder.add_rotating_file_stream(file_path, logger::severity::information, rotation);
+
+    logger *built_logger = builder.build();
+    built_logger->information("first period");
+
+    // the segment's line is flushed when the worker closes it, after the fresh file was swapped in
+    EXPECT_TRUE(wait_until([&file_path]()
+    {
+        auto const segments = list_files(file_path + ".");
+        return segments.size() == 1 && read_lines(segments[0]).size() == 1;
+    }));
+
+    built_logger->information("second period");
+    delete built_logger;
+
+    auto const segments = list_files(file_path + ".");
+    ASSERT_EQ(segments.size(), 1);
+    auto const rotated_lines = read_lines(segments[0]);
+    ASSERT_EQ(rotated_lines.size(), 1);
+    EXPECT_NE(rotated_lines[0].find("first period"), std::string::npos);
+
+    auto const current_lines = read_lines(file_path);
+    ASSERT_EQ(current_lines.size(), 1);
+    EXPECT_NE(current_lines[0].find("second period"), std::string::npos);
+
+    remove_files(file_path);
+}
+
+TEST(client_logger_tests, thread_buffers_merge_in_timestamp_order_on_flush)
+{
+    std::string const file_path = "client_logger_tests_thread_buffers.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.set_thread_buffering(1 << 20, std::chrono::milliseconds(0));
+
+    logger *built_logger = builder.build();
+
+    // every line comes from another thread's buffer, yet the lines are ordered by when they were logged
+    size_t const lines_count = 8;
+    for (size_t i = 0; i < lines_count; ++i)
+    {
+        std::thread([built_logger, i]()
+        {
+            built_logger->information("line " + std::to_string(i));
+        }).join();
+        built_logger->information("main after " + std::to_string(i));
+    }
+
+    EXPECT_TRUE(read_lines(file_path).empty());
+
+    dynamic_cast<client_logger *>(built_logger)->flush();
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 2 * lines_count);
+    for (size_t i = 0; i < lines_count; ++i)
+    {
+        EXPECT_NE(lines[2 * i].find("] line " + std::to_string(i)), std::string::npos);
+        EXPECT_NE(lines[2 * i + 1].find("] main after " + std::to_string(i)), std::string::npos);
+    }
+
+    delete built_logger;
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, flush_with_thread_buffers_flushes_binary_streams)
+{
+    std::string const file_path = "client_logger_tests_thread_buffers_text.txt";
+    std::string const binary_file_path = "client_logger_tests_thread_buffers_binary.bin";
+    std::remove(file_path.c_str());
+    std::remove(binary_file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.add_binary_file_stream(binary_file_path, logger::severity::information);
+    builder.set_thread_buffering(1 << 20, std::chrono::milliseconds(0));
+
+    logger *built_logger = builder.build();
+    built_logger->log_format(logger::severity::information, "{} of {}", 1, 2);
+    dynamic_cast<client_logger *>(built_logger)->flush();
+
+    EXPECT_EQ(read_lines(file_path).size(), 1);
+
+    std::ifstream stream(binary_file_path, std::ios::binary);
+    binary_log_format::decoder decoder(stream);
+    std::string line;
+    ASSERT_TRUE(decoder.next(line));
+    EXPECT_NE(line.find("][INFORMATION] 1 of 2"), std::string::npos);
+
+    delete built_logger;
+    std::remove(file_path.c_str());
+    std::remove(binary_file_path.c_str());
+}
+
+TEST(client_logger_tests, thread_buffers_flush_by_size_and_time)
+{
+    std::string const size_file_path = "client_logger_tests_thread_buffers_size.txt";
+    std::string const time_file_path = "client_logger_tests_thread_buffers_time.txt";
+    std::remove(size_file_path.c_str());
+    std::remove(time_file_path.c_str());
+
+    client_logger_builder size_builder;
+    size_builder.add_file_stream(size_file_path, logger::severity::information);
+    size_builder.set_thread_buffering(256, std::chrono::milliseconds(0));
+
+    client_logger_builder time_builder;
+    time_builder.add_file_stream(time_file_path, logger::severity::information);
+    time_builder.set_thread_buffering(1 << 20, std::chrono::milliseconds(20));
+
+    logger *size_logger = size_builder.build();
+    logger *time_logger = time_builder.build();
+
+    std::thread([size_logger, time_logger]()
+    {
+        for (size_t i = 0; i < 10; ++i)
+        {
+            size_logger->information(std::string(64, 'x'));
+        }
+        time_logger->information("flushed by the timer");
+    }).join();
+
+    // lines of a finished thread stay buffered until the next flush
+    auto size_lines = read_lines(size_file_path);
+    EXPECT_GE(size_lines.size(), 2);
+    EXPECT_LT(size_lines.size(), 10);
+
+    EXPECT_TRUE(wait_until([&time_file_path]()
+    {
+        return read_lines(time_file_path).size() == 1;
+    }));
+
+    delete size_logger;
+    delete time_logger;
+
+    EXPECT_EQ(read_lines(size_file_path).size(), 10);
+
+    std::remove(size_file_path.c_str());
+    std::remove(time_file_path.c_str());
+}
+
+TEST(client_logger_tests, inline_message_formats_without_heap)
+{
+    inline_message<> message;
+    message << "value " << -9223372036854775807LL - 1 << ' ' << 42u << ' ' << true << ' ' << 0.5
+        << ' ' << reinterpret_cast<void const *>(0x1f) << ' ' << std::string("text");
+
+    EXPECT_EQ(std::string(message.data(), message.size()), "value -9223372036854775808 42 true 0.5 0x1f text");
+    EXPECT_FALSE(message.is_truncated());
+
+    inline_message<8> short_message;
+    short_message << "truncated " << 12345;
+
+    EXPECT_EQ(std::string(short_message.data(), short_message.size()), "truncate");
+    EXPECT_TRUE(short_message.is_truncated());
+}
+
+TEST(client_logger_tests, steady_state_logging_does_not_allocate)
+{
+    std::string const file_path = "client_logger_tests_no_allocations.txt";
+    std::remove(file_path.c_str());
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.add_file_stream(file_path, logger::severity::debug);
+
+    logger *built_logger = builder.build();
+    guarded_component const component(built_logger);
+
+    auto log_lines = [built_logger, &component](size_t iteration)
+    {
+        built_logger->information("literal line");
+
+        inline_message<> message;
+        message << "iteration " << iteration << " at " << static_cast<void const *>(&message);
+        built_logger->debug(message);
+
+        component.report(iteration);
+        built_logger->trace("filtered out");
+    };
+
+    // the first calls fill per-thread caches and buffers
+    log_lines(0);
+
+    auto const allocations_count = heap_allocations_count;
+    size_t const iterations_count = 100;
+    for (size_t i = 1; i <= iterations_count; ++i)
+    {
+        log_lines(i);
+    }
+    EXPECT_EQ(heap_allocations_count, allocations_count);
+
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 3 * (iterations_count + 1));
+    EXPECT_NE(lines[3].find("[INFORMATION] literal line"), std::string::npos);
+    EXPECT_NE(lines[4].find("[DEBUG] iteration 1 at 0x"), std::string::npos);
+    EXPECT_NE(lines[5].find("[INFORMATION] reported 1 bytes"), std::string::npos);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(client_logger_tests, configuration_file_adds_streams)
+{
+    std::string const file_path = "client_logger_tests_configuration.txt";
+    std::string const configuration_file_path = "client_logger_tests_configuration.json";
+    std::remove(file_path.c_str());
+
+    write_file(configuration_file_path, R"({
+        "unrelated": { "console": ["trace"], "files": { "unrelated.txt": "trace" } },
+        "loggers": {
+            "skipped": [1, 2.5, null, true, { "nested": [] }],
+            "main": {
+                "files": { "client_logger_tests_configuration.txt": ["warning", "error"] },
+                "datetime_precision": "milliseconds",
+                "comment": "unknown keys are ignored"
+            }
+        }
+    })");
+
+    client_logger_builder builder;
+    builder.add_file_stream(file_path, logger::severity::information);
+    builder.transform_with_configuration(configuration_file_path, "loggers/main");
+
+    logger *built_logger = builder.build();
+    built_logger
+        ->debug("skipped")
+        ->information("from builder")
+        ->error("from configuration");
+    delete built_logger;
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("[INFORMATION] from builder"), std::string::npos);
+    EXPECT_NE(lines[1].find("[ERROR] from configuration"), std::string::npos);
+    // "[dd.mm.yyyy hh:mm:ss.mmm]"
+    EXPECT_EQ(lines[1].find(']'), 24);
+
+    EXPECT_THROW(builder.transform_with_configuration(configuration_file_path, "loggers/missing"), std::runtime_error);
+    EXPECT_THROW(builder.transform_with_configuration("client_logger_tests_missing.json", ""), std::runtime_error);
+
+    write_file(configuration_file_path, R"({ "files": { "client_logger_tests_configuration.txt": ["loud"] } })");
+    EXPECT_THROW(builder.transform_with_configuration(configuration_file_path, ""), std::runtime_error);
+
+    write_file(configuration_file_path, R"({ "console": ["error"] )");
+    EXPECT_THROW(builder.transform_with_configuration(configuration_file_path, ""), std::runtime_error);
+
+    std::remove(file_path.c_str());
+    std::remove(configuration_file_path.c_str());
+}
+
+TEST(client_logger_tests, reloadable_logger_follows_configuration_file)
+{
+    std::string const file_path = "client_logger_tests_reloadable.txt";
+    std::string const configuration_file_path = "client_logger_tests_reloadable.json";
+    std::remove(file_path.c_str());
+
+    write_file(configuration_file_path, R"({ "files": { "client_logger_tests_reloadable.txt": "error" } })");
+
+    {
+        reloadable_logger reloadable(client_logger_builder(), configuration_file_path, "");
+        reloadable
+            .warning("skipped")
+            ->error("first");
+
+        auto wait_for_reloads = [&reloadable](unsigned long long count)
+        {
+            for (size_t i = 0; i < 200 && reloadable.get_reloads_count() < count; ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            return reloadable.get_reloads_count() >= count;
+        };
+
+        write_file(configuration_file_path, R"({ "files": { "client_logger_tests_reloadable.txt": ["warning", "error"] } })");
+        ASSERT_TRUE(wait_for_reloads(1));
+        reloadable.warning("second");
+
+        // a broken configuration keeps the current logger, which reports the failure
+        write_file(configuration_file_path, R"({ "files": )");
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        EXPECT_EQ(reloadable.get_reloads_count(), 1);
+        reloadable.warning("third");
+    }
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 4);
+    EXPECT_NE(lines[0].find("[ERROR] first"), std::string::npos);
+    EXPECT_NE(lines[1].find("[WARNING] second"), std::string::npos);
+    EXPECT_NE(lines[2].find("[ERROR] configuration reload failed"), std::string::npos);
+    EXPECT_NE(lines[3].find("[WARNING] third"), std::string::npos);
+
+    std::remove(file_path.c_str());
+    std::remove(configuration_file_path.c_str());
+}
 
 int main(
     int argc,
@@ -9,4 +1113,4 @@ int main(
     testing::InitGoogleTest(&argc, argv);
 
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
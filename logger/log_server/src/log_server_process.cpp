@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+#include <log_server.h>
+
+/*
+ *     mp_os_lggr_lg_srvr [name = /mp_os_log_server] [capacity = 4194304] [file path...]
+ *
+ * The files are the only ones the server writes; loggers select among them by path.
+ */
+int main(
+    int argc,
+    char *argv[])
+{
+    std::string const name = argc > 1
+        ? argv[1]
+        : log_server::default_name;
+
+    size_t capacity = log_server::default_capacity;
+    if (argc > 2)
+    {
+        char *capacity_end = nullptr;
+        errno = 0;
+        auto const parsed = std::strtoull(argv[2], &capacity_end, 10);
+        if (errno != 0 || capacity_end == argv[2] || *capacity_end != '\0' || argv[2][0] == '-'
+            || parsed < shared_memory_ring::min_capacity || parsed > std::numeric_limits<size_t>::max())
+        {
+            std::cerr << "capacity must be a number of bytes of at least " << shared_memory_ring::min_capacity
+                << ", got \"" << argv[2] << "\"" << std::endl;
+            return 1;
+        }
+
+        capacity = static_cast<size_t>(parsed);
+    }
+
+    std::vector<std::string> const file_paths(argv + std::min(argc, 3), argv + argc);
+
+    // termination signals are taken synchronously, so the server can drain the ring before exiting
+    sigset_t termination_signals;
+    sigemptyset(&termination_signals);
+    sigaddset(&termination_signals, SIGINT);
+    sigaddset(&termination_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &termination_signals, nullptr);
+
+    try
+    {
+        log_server server(name, capacity, file_paths);
+        std::thread worker(&log_server::run, &server);
+
+        int received_signal;
+        sigwait(&termination_signals, &received_signal);
+
+        server.stop();
+        worker.join();
+
+        std::cerr << "log server \"" << name << "\" stopped, "
+            << server.get_processed_records_count() << " records processed" << std::endl;
+    }
+    catch (std::exception const &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOG_FORMAT_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOG_FORMAT_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "logger.h"
+
+/*
+ * Compact record layout written by binary log sinks (all integers in host byte order):
+ *
+ *     file header         "MPOSBLG1"
+ *     format definition   'F' | u32 format id | u32 length | format bytes
+ *     record              'R' | i64 timestamp (ns since epoch) | u8 severity | u32 format id | u8 arguments count | arguments
+ *     argument            u8 type | i64 / u64 / f64 payload, or u32 length | string bytes
+ *
+ * Format id 0 is reserved for plain log(message, severity) calls: the record carries the message
+ * as its single string argument, so dynamic messages never grow the format dictionary.
+ *
+ * A record of more than 255 arguments keeps the first 255, a string argument longer than the u32 length
+ * its first 4 GiB - 1 bytes; the severity byte of such a record has truncated_record_flag set, and the
+ * decoder marks its line.
+ */
+class binary_log_format final
+{
+
+public:
+
+    static constexpr char const *signature = "MPOSBLG1";
+
+    static constexpr size_t signature_size = 8;
+
+    static constexpr uint32_t raw_message_format_id = 0;
+
+    static constexpr unsigned char format_definition_tag = 'F';
+
+    static constexpr unsigned char record_tag = 'R';
+
+    static constexpr unsigned char truncated_record_flag = 0x80;
+
+public:
+
+    /*
+     * Per-file format dictionary: maps format string contents to the ids already written to the file.
+     * Formats are string literals, so they are looked up by address first; the contents are hashed
+     * only the first time an address is seen.
+     */
+    class format_dictionary final
+    {
+
+    private:
+
+        std::unordered_map<char const *, uint32_t> _format_ids_by_address;
+
+        std::unordered_map<std::string, uint32_t> _format_ids;
+
+    public:
+
+        uint32_t intern(
+            std::string &buffer,
+            char const *format);
+
+    };
+
+    class decoder final
+    {
+
+    private:
+
+        std::istream &_stream;
+
+        std::unordered_map<uint32_t, std::string> _formats;
+
+        std::vector<std::string> _string_arguments;
+
+        std::vector<logger::format_argument> _arguments;
+
+    public:
+
+        explicit decoder(
+            std::istream &stream);
+
+    public:
+
+        /*
+         * Reads the next log record and renders it exactly like the text sinks do.
+         * Returns false at the end of the stream; throws std::runtime_error on corrupted input.
+         */
+        bool next(
+            std::string &rendered_line);
+
+    private:
+
+        void read_exactly(
+            void *destination,
+            size_t size);
+
+        template<
+            typename T>
+        T read_value();
+
+    };
+
+public:
+
+    binary_log_format() = delete;
+
+public:
+
+    static int64_t current_timestamp() noexcept;
+
+    static void append_header(
+        std::string &buffer);
+
+    static void append_record(
+        std::string &buffer,
+        int64_t timestamp,
+        logger::severity severity,
+        uint32_t format_id,
+        logger::format_argument const *arguments,
+        size_t arguments_count);
+
+    static std::string render_line(
+        int64_t timestamp,
+        logger::severity severity,
+        std::string const &message);
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOG_FORMAT_H
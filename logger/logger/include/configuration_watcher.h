@@ -0,0 +1,56 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONFIGURATION_WATCHER_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONFIGURATION_WATCHER_H
+
+#include <functional>
+#include <string>
+#include <thread>
+
+/*
+ * Calls on_change from a background thread whenever the file is rewritten or replaced.
+ * The containing directory is watched through inotify, so editors that save by renaming
+ * a temporary file over the original are noticed too. Bursts of events are coalesced
+ * into a single call.
+ */
+class configuration_watcher final
+{
+
+private:
+
+    std::string _directory_path;
+
+    std::string _file_name;
+
+    std::function<void()> _on_change;
+
+    int _inotify_descriptor;
+
+    int _stop_descriptor;
+
+    std::thread _worker;
+
+public:
+
+    configuration_watcher(
+        std::string const &file_path,
+        std::function<void()> on_change);
+
+    ~configuration_watcher() noexcept;
+
+    configuration_watcher(
+        configuration_watcher const &other) = delete;
+
+    configuration_watcher &operator=(
+        configuration_watcher const &other) = delete;
+
+private:
+
+    void watch() noexcept;
+
+    /*
+     * Reads all pending events; returns true if one of them concerns the watched file.
+     */
+    bool read_events() noexcept;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONFIGURATION_WATCHER_H
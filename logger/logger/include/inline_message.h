@@ -0,0 +1,262 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_INLINE_MESSAGE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_INLINE_MESSAGE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#include "logger.h"
+
+/*
+ * Message composed in a fixed buffer on the stack, for hot paths that must not touch the heap:
+ *
+ *     inline_message<> message;
+ *     message << "block of " << size << " bytes at " << address;
+ *     got_logger->debug(message);
+ *
+ * Text beyond the capacity is dropped and the message is marked as truncated. The first literal
+ * written into the message is its call site, for sampling.
+ */
+template<
+    size_t capacity = 256>
+class inline_message final
+{
+
+private:
+
+    char _buffer[capacity];
+
+    size_t _size;
+
+    bool _is_truncated;
+
+    char const *_first_literal;
+
+public:
+
+    inline_message() noexcept;
+
+public:
+
+    inline_message &operator<<(
+        logger::message_view text) noexcept;
+
+    inline_message &operator<<(
+        char const *text) noexcept;
+
+    inline_message &operator<<(
+        char symbol) noexcept;
+
+    inline_message &operator<<(
+        bool value) noexcept;
+
+    template<
+        typename integer,
+        typename = typename std::enable_if<std::is_integral<integer>::value>::type>
+    inline_message &operator<<(
+        integer value) noexcept;
+
+    inline_message &operator<<(
+        double value) noexcept;
+
+    // hexadecimal, as addresses are usually printed
+    inline_message &operator<<(
+        void const *address) noexcept;
+
+public:
+
+    void clear() noexcept;
+
+    [[nodiscard]] char const *data() const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+
+    [[nodiscard]] bool is_truncated() const noexcept;
+
+    operator logger::message_view() const noexcept;
+
+private:
+
+    void append(
+        char const *data,
+        size_t size) noexcept;
+
+    void append_unsigned(
+        unsigned long long value,
+        unsigned int base) noexcept;
+
+};
+
+template<
+    size_t capacity>
+inline_message<capacity>::inline_message() noexcept:
+    _size(0),
+    _is_truncated(false),
+    _first_literal(nullptr)
+{
+
+}
+
+template<
+    size_t capacity>
+inline_message<capacity> &inline_message<capacity>::operator<<(
+    logger::message_view text) noexcept
+{
+    append(text.data(), text.size());
+
+    return *this;
+}
+
+template<
+    size_t capacity>
+inline_message<capacity> &inline_message<capacity>::operator<<(
+    char const *text) noexcept
+{
+    if (_first_literal == nullptr)
+    {
+        _first_literal = text;
+    }
+    append(text, std::strlen(text));
+
+    return *this;
+}
+
+template<
+    size_t capacity>
+inline_message<capacity> &inline_message<capacity>::operator<<(
+    char symbol) noexcept
+{
+    append(&symbol, 1);
+
+    return *this;
+}
+
+template<
+    size_t capacity>
+inline_message<capacity> &inline_message<capacity>::operator<<(
+    bool value) noexcept
+{
+    return *this << (value
+        ? "true"
+        : "false");
+}
+
+template<
+    size_t capacity>
+template<
+    typename integer,
+    typename>
+inline_message<capacity> &inline_message<capacity>::operator<<(
+    integer value) noexcept
+{
+    if (value < 0)
+    {
+        append("-", 1);
+        // negated in the unsigned type, so the minimum value doesn't overflow
+        append_unsigned(0ULL - static_cast<unsigned long long>(value), 10);
+    }
+    else
+    {
+        append_unsigned(static_cast<unsigned long long>(value), 10);
+    }
+
+    return *this;
+}
+
+template<
+    size_t capacity>
+inline_message<capacity> &inline_message<capacity>::operator<<(
+    double value) noexcept
+{
+    char formatted[32];
+    auto const length = std::snprintf(formatted, sizeof(formatted), "%.15g", value);
+    append(formatted, static_cast<size_t>(length));
+
+    return *this;
+}
+
+template<
+    size_t capacity>
+inline_message<capacity> &inline_message<capacity>::operator<<(
+    void const *address) noexcept
+{
+    append("0x", 2);
+    append_unsigned(static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(address)), 16);
+
+    return *this;
+}
+
+template<
+    size_t capacity>
+void inline_message<capacity>::clear() noexcept
+{
+    _size = 0;
+    _is_truncated = false;
+    _first_literal = nullptr;
+}
+
+template<
+    size_t capacity>
+char const *inline_message<capacity>::data() const noexcept
+{
+    return _buffer;
+}
+
+template<
+    size_t capacity>
+size_t inline_message<capacity>::size() const noexcept
+{
+    return _size;
+}
+
+template<
+    size_t capacity>
+bool inline_message<capacity>::is_truncated() const noexcept
+{
+    return _is_truncated;
+}
+
+template<
+    size_t capacity>
+inline_message<capacity>::operator logger::message_view() const noexcept
+{
+    return logger::message_view(_buffer, _size).with_call_site(_first_literal);
+}
+
+template<
+    size_t capacity>
+void inline_message<capacity>::append(
+    char const *data,
+    size_t size) noexcept
+{
+    if (size > capacity - _size)
+    {
+        size = capacity - _size;
+        _is_truncated = true;
+    }
+
+    std::memcpy(_buffer + _size, data, size);
+    _size += size;
+}
+
+template<
+    size_t capacity>
+void inline_message<capacity>::append_unsigned(
+    unsigned long long value,
+    unsigned int base) noexcept
+{
+    char digits[20];
+    size_t digits_count = 0;
+
+    do
+    {
+        digits[sizeof(digits) - ++digits_count] = "0123456789abcdef"[value % base];
+        value /= base;
+    }
+    while (value != 0);
+
+    append(digits + sizeof(digits) - digits_count, digits_count);
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_INLINE_MESSAGE_H
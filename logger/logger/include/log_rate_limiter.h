@@ -0,0 +1,136 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_RATE_LIMITER_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_RATE_LIMITER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+#include "logger.h"
+
+/*
+ * Per-severity admission policies applied before a message is formatted:
+ *
+ *     sampling       1 in sampling_period calls of each message template passes; the template is
+ *                    the format string of a structured call or the call site of a plain one, both
+ *                    keyed by address. Calls of unknown origin share one sampling sequence per severity
+ *     token bucket   at most burst lines at once, refilled at lines_per_second
+ *
+ * Every rejected call is counted. With the bucket alone, a suppressed call costs a relaxed load
+ * and one atomic increment of the suppressed counter; sampling adds one increment of the
+ * template's counter.
+ */
+class log_rate_limiter final
+{
+
+public:
+
+    class policy final
+    {
+
+    public:
+
+        // 0 disables the token bucket
+        double lines_per_second;
+
+        // 0 means one second worth of lines
+        size_t burst;
+
+        // 0 and 1 disable sampling
+        size_t sampling_period;
+
+    public:
+
+        policy() noexcept;
+
+    };
+
+private:
+
+    static constexpr size_t severities_count = static_cast<size_t>(logger::severity::critical) + 1;
+
+    // templates of a severity are hashed into this many counters; colliding templates share a sampling sequence
+    static constexpr size_t sampling_counters_count = 1024;
+
+    struct severity_state final
+    {
+
+        double lines_per_nanosecond;
+
+        uint64_t burst;
+
+        size_t sampling_period;
+
+        std::atomic<uint64_t> consumed_tokens;
+
+        std::atomic<unsigned long long> unreported;
+
+        std::atomic<unsigned long long> reported;
+
+        // allocated for the severities with sampling only
+        std::unique_ptr<std::atomic<uint32_t>[]> sampling_counters;
+
+        // calls of unknown origin
+        std::atomic<uint32_t> plain_calls;
+
+    };
+
+private:
+
+    std::map<logger::severity, policy> _policies;
+
+    std::array<severity_state, severities_count> _states;
+
+    int64_t _started_at;
+
+public:
+
+    explicit log_rate_limiter(
+        std::map<logger::severity, policy> const &policies);
+
+    /*
+     * The copy starts with full buckets and no suppressed lines.
+     */
+    log_rate_limiter(
+        log_rate_limiter const &other);
+
+    log_rate_limiter &operator=(
+        log_rate_limiter const &other) = delete;
+
+    ~log_rate_limiter() noexcept = default;
+
+public:
+
+    /*
+     * message_template is the structured call's format, the plain call's call site, or nullptr if unknown.
+     */
+    bool admit(
+        logger::severity severity,
+        void const *message_template) noexcept;
+
+    /*
+     * Returns the number of lines suppressed since the previous call and resets it,
+     * so the caller can report them along with the next line that passes.
+     */
+    unsigned long long take_unreported(
+        logger::severity severity) noexcept;
+
+    [[nodiscard]] unsigned long long get_suppressed_count(
+        logger::severity severity) const noexcept;
+
+    [[nodiscard]] std::map<logger::severity, policy> const &get_policies() const noexcept;
+
+private:
+
+    bool take_token(
+        severity_state &state) noexcept;
+
+    bool suppress(
+        severity_state &state) noexcept;
+
+    static int64_t current_nanoseconds() noexcept;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_RATE_LIMITER_H
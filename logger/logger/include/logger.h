@@ -1,11 +1,14 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_H
 
+#include <array>
 #include <iostream>
 
 class logger
 {
 
+    friend class binary_log_format;
+
 public:
 
     enum class severity
@@ -18,6 +21,148 @@ public:
         critical
     };
 
+    enum class datetime_precision
+    {
+        seconds,
+        milliseconds,
+        microseconds,
+        nanoseconds
+    };
+
+public:
+
+    /*
+     * Raw argument of a structured log call. Strings are referenced, not copied:
+     * the argument is only valid for the duration of the call.
+     */
+    class format_argument final
+    {
+
+    public:
+
+        enum class type: unsigned char
+        {
+            signed_integer,
+            unsigned_integer,
+            floating_point,
+            string
+        };
+
+    private:
+
+        type _type;
+
+        union
+        {
+            long long _signed_integer;
+            unsigned long long _unsigned_integer;
+            double _floating_point;
+            struct
+            {
+                char const *data;
+                size_t size;
+            } _string;
+        };
+
+    public:
+
+        format_argument(
+            int value) noexcept;
+
+        format_argument(
+            long value) noexcept;
+
+        format_argument(
+            long long value) noexcept;
+
+        format_argument(
+            unsigned int value) noexcept;
+
+        format_argument(
+            unsigned long value) noexcept;
+
+        format_argument(
+            unsigned long long value) noexcept;
+
+        format_argument(
+            double value) noexcept;
+
+        format_argument(
+            char const *value) noexcept;
+
+        format_argument(
+            char const *data,
+            size_t size) noexcept;
+
+        format_argument(
+            std::string const &value) noexcept;
+
+    public:
+
+        [[nodiscard]] type get_type() const noexcept;
+
+        [[nodiscard]] long long get_signed_integer() const noexcept;
+
+        [[nodiscard]] unsigned long long get_unsigned_integer() const noexcept;
+
+        [[nodiscard]] double get_floating_point() const noexcept;
+
+        [[nodiscard]] char const *get_string_data() const noexcept;
+
+        [[nodiscard]] size_t get_string_size() const noexcept;
+
+    };
+
+public:
+
+    /*
+     * Non-owning reference to message text, so literals and fixed buffers reach the sinks without
+     * being copied into a std::string. Valid for the duration of the call only.
+     *
+     * The call site identifies the message template of a plain call the way the format string does
+     * for a structured one, and rate limiting samples each call site on its own. A view of a literal
+     * is keyed by the literal's address; other text by the address of the code that logs it.
+     */
+    class message_view final
+    {
+
+    private:
+
+        char const *_data;
+
+        size_t _size;
+
+        void const *_call_site;
+
+    public:
+
+        message_view(
+            char const *text) noexcept;
+
+        message_view(
+            char const *data,
+            size_t size) noexcept;
+
+        message_view(
+            std::string const &text) noexcept;
+
+    public:
+
+        [[nodiscard]] char const *data() const noexcept;
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        // nullptr if unknown
+        [[nodiscard]] void const *get_call_site() const noexcept;
+
+        /*
+         * The same text attributed to call_site, unless it already has one.
+         */
+        [[nodiscard]] message_view with_call_site(
+            void const *call_site) const noexcept;
+
+    };
+
 public:
 
     virtual ~logger() noexcept = default;
@@ -28,33 +173,141 @@ public:
         std::string const &message,
         logger::severity severity) const noexcept = 0;
 
+    /*
+     * The default implementation copies the text into a std::string; loggers override it
+     * to write the text as is, which keeps steady-state logging free of heap allocations.
+     */
+    virtual logger const *log(
+        logger::message_view message,
+        logger::severity severity) const noexcept;
+
+    logger const *log(
+        char const *message,
+        logger::severity severity) const noexcept;
+
+    /*
+     * Structured log call: every "{}" in the format is substituted by the next argument.
+     * The default implementation renders the text and forwards it to log(message, severity);
+     * loggers with binary sinks store the format and raw arguments instead.
+     */
+    virtual logger const *log_structured(
+        logger::severity severity,
+        char const *format,
+        logger::format_argument const *arguments,
+        size_t arguments_count) const noexcept;
+
+    template<
+        typename ...Args>
+    logger const *log_format(
+        logger::severity severity,
+        char const *format,
+        Args const &... arguments) const noexcept;
+
 public:
 
+    /*
+     * Every overload passes the text to log(message_view, severity) without a copy; text that is not
+     * a literal is attributed to the caller's return address as its call site.
+     */
     logger const *trace(
         std::string const &message) const noexcept;
 
+    logger const *trace(
+        logger::message_view message) const noexcept;
+
+    logger const *trace(
+        char const *message) const noexcept;
+
     logger const *debug(
         std::string const &message) const noexcept;
 
+    logger const *debug(
+        logger::message_view message) const noexcept;
+
+    logger const *debug(
+        char const *message) const noexcept;
+
     logger const *information(
         std::string const &message) const noexcept;
 
+    logger const *information(
+        logger::message_view message) const noexcept;
+
+    logger const *information(
+        char const *message) const noexcept;
+
     logger const *warning(
         std::string const &message) const noexcept;
 
+    logger const *warning(
+        logger::message_view message) const noexcept;
+
+    logger const *warning(
+        char const *message) const noexcept;
+
     logger const *error(
         std::string const &message) const noexcept;
 
+    logger const *error(
+        logger::message_view message) const noexcept;
+
+    logger const *error(
+        char const *message) const noexcept;
+
     logger const *critical(
         std::string const &message) const noexcept;
 
+    logger const *critical(
+        logger::message_view message) const noexcept;
+
+    logger const *critical(
+        char const *message) const noexcept;
+
+public:
+
+    static std::string render_format(
+        char const *format,
+        logger::format_argument const *arguments,
+        size_t arguments_count);
+
 protected:
 
     static std::string severity_to_string(
         logger::severity severity);
 
+    static char const *severity_to_c_string(
+        logger::severity severity) noexcept;
+
     static std::string current_datetime_to_string() noexcept;
 
+    /*
+     * The "dd.mm.yyyy hh:mm:ss" part is cached per thread and reformatted at most once per second;
+     * sub-second precisions append the fractional part of the current second.
+     */
+    static std::string current_datetime_to_string(
+        logger::datetime_precision precision) noexcept;
+
+    static void append_current_datetime(
+        std::string &destination,
+        logger::datetime_precision precision) noexcept;
+
 };
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_H
\ No newline at end of file
+template<
+    typename ...Args>
+logger const *logger::log_format(
+    logger::severity severity,
+    char const *format,
+    Args const &... arguments) const noexcept
+{
+    std::array<logger::format_argument, sizeof...(Args)> const packed_arguments
+    {
+        {
+            logger::format_argument(arguments)...
+        }
+    };
+
+    return log_structured(severity, format, packed_arguments.data(), packed_arguments.size());
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_H
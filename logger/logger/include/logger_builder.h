@@ -6,6 +6,8 @@
 class logger_builder
 {
 
+    friend class logger_configuration;
+
 public:
 
     virtual ~logger_builder() noexcept = default;
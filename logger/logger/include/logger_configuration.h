@@ -0,0 +1,79 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_CONFIGURATION_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_CONFIGURATION_H
+
+#include <map>
+#include <set>
+
+#include "logger.h"
+
+/*
+ * Logger settings read by logger_builder::transform_with_configuration.
+ * The configuration path selects an object inside the JSON file by its keys
+ * ("loggers/main"; an empty path selects the root object), which may contain:
+ *
+ *     {
+ *         "console": ["warning", "error"],
+ *         "files": { "app.log": ["information", "warning"] },
+ *         "binary_files": { "app.bin": "trace" },
+ *         "datetime_precision": "milliseconds",
+ *         "server_name": "/mp_os_log_server"
+ *     }
+ *
+ * Severities are given as one string or an array of strings. Other keys are skipped.
+ */
+class logger_configuration final
+{
+
+private:
+
+    std::map<std::string, std::set<logger::severity>> _file_streams;
+
+    std::map<std::string, std::set<logger::severity>> _binary_file_streams;
+
+    std::set<logger::severity> _console_stream_severities;
+
+    bool _has_datetime_precision;
+
+    logger::datetime_precision _datetime_precision;
+
+    std::string _server_name;
+
+public:
+
+    /*
+     * The file is memory-mapped and parsed as an event stream: nothing outside the selected
+     * object is stored. Throws std::runtime_error if the file can't be read, is not valid JSON,
+     * has no object at the configuration path or holds an invalid value there.
+     */
+    static logger_configuration load(
+        std::string const &configuration_file_path,
+        std::string const &configuration_path);
+
+private:
+
+    logger_configuration();
+
+public:
+
+    [[nodiscard]] std::map<std::string, std::set<logger::severity>> const &get_file_streams() const noexcept;
+
+    [[nodiscard]] std::map<std::string, std::set<logger::severity>> const &get_binary_file_streams() const noexcept;
+
+    [[nodiscard]] std::set<logger::severity> const &get_console_stream_severities() const noexcept;
+
+    [[nodiscard]] bool has_datetime_precision() const noexcept;
+
+    [[nodiscard]] logger::datetime_precision get_datetime_precision() const noexcept;
+
+    /*
+     * Empty if the configuration does not name a log server.
+     */
+    [[nodiscard]] std::string const &get_server_name() const noexcept;
+
+private:
+
+    class parser;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_CONFIGURATION_H
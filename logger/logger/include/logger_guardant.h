@@ -16,24 +16,72 @@ public:
         std::string const &message,
         logger::severity severity) const;
 
+    /*
+     * Takes literals and inline_message alike; neither is copied on the way to the logger. Every call
+     * carries its call site, so the logger's sampling keeps one sequence per call site.
+     */
+    logger_guardant const *log_with_guard(
+        logger::message_view message,
+        logger::severity severity) const;
+
+    logger_guardant const *log_with_guard(
+        char const *message,
+        logger::severity severity) const;
+
     logger_guardant const *trace_with_guard(
         std::string const &message) const;
 
+    logger_guardant const *trace_with_guard(
+        logger::message_view message) const;
+
+    logger_guardant const *trace_with_guard(
+        char const *message) const;
+
     logger_guardant const *debug_with_guard(
         std::string const &message) const;
 
+    logger_guardant const *debug_with_guard(
+        logger::message_view message) const;
+
+    logger_guardant const *debug_with_guard(
+        char const *message) const;
+
     logger_guardant const *information_with_guard(
         std::string const &message) const;
 
+    logger_guardant const *information_with_guard(
+        logger::message_view message) const;
+
+    logger_guardant const *information_with_guard(
+        char const *message) const;
+
     logger_guardant const *warning_with_guard(
         std::string const &message) const;
 
+    logger_guardant const *warning_with_guard(
+        logger::message_view message) const;
+
+    logger_guardant const *warning_with_guard(
+        char const *message) const;
+
     logger_guardant const *error_with_guard(
         std::string const &message) const;
 
+    logger_guardant const *error_with_guard(
+        logger::message_view message) const;
+
+    logger_guardant const *error_with_guard(
+        char const *message) const;
+
     logger_guardant const *critical_with_guard(
         std::string const &message) const;
 
+    logger_guardant const *critical_with_guard(
+        logger::message_view message) const;
+
+    logger_guardant const *critical_with_guard(
+        char const *message) const;
+
 protected:
 
     inline virtual logger *get_logger() const = 0;
@@ -0,0 +1,116 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_RELOADABLE_LOGGER_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_RELOADABLE_LOGGER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "configuration_watcher.h"
+#include "logger.h"
+
+/*
+ * Logger that rebuilds itself whenever its configuration file changes.
+ *
+ * Calls are forwarded to the current logger, which is swapped atomically after a new one
+ * has been built: logging threads never wait for a reload, and a logger replaced in the
+ * middle of a call is destroyed once the last such call returns. If the new configuration
+ * can't be applied, the current logger stays in place and reports the error.
+ */
+class reloadable_logger final:
+    public logger
+{
+
+private:
+
+    std::function<logger *()> _build;
+
+    std::shared_ptr<logger const> _current;
+
+    std::mutex _reload_guard;
+
+    std::atomic<unsigned long long> _reloads_count;
+
+    configuration_watcher _watcher;
+
+public:
+
+    /*
+     * build is called for the initial logger and again on every change of the file.
+     */
+    reloadable_logger(
+        std::function<logger *()> build,
+        std::string const &configuration_file_path);
+
+    /*
+     * Every logger is built by a copy of prototype transformed with the configuration,
+     * so the configuration adds to the streams already set on the prototype.
+     */
+    template<
+        typename builder_type>
+    reloadable_logger(
+        builder_type const &prototype,
+        std::string const &configuration_file_path,
+        std::string const &configuration_path);
+
+    ~reloadable_logger() noexcept override = default;
+
+    reloadable_logger(
+        reloadable_logger const &other) = delete;
+
+    reloadable_logger &operator=(
+        reloadable_logger const &other) = delete;
+
+public:
+
+    using logger::log;
+
+    [[nodiscard]] logger const *log(
+        std::string const &message,
+        logger::severity severity) const noexcept override;
+
+    [[nodiscard]] logger const *log(
+        logger::message_view message,
+        logger::severity severity) const noexcept override;
+
+    logger const *log_structured(
+        logger::severity severity,
+        char const *format,
+        logger::format_argument const *arguments,
+        size_t arguments_count) const noexcept override;
+
+public:
+
+    /*
+     * Rebuilds the logger now; throws if the configuration can't be applied.
+     */
+    void reload();
+
+    [[nodiscard]] unsigned long long get_reloads_count() const noexcept;
+
+private:
+
+    void reload_on_change() noexcept;
+
+};
+
+template<
+    typename builder_type>
+reloadable_logger::reloadable_logger(
+    builder_type const &prototype,
+    std::string const &configuration_file_path,
+    std::string const &configuration_path):
+        reloadable_logger(
+            [prototype, configuration_file_path, configuration_path]()
+            {
+                builder_type builder(prototype);
+                builder.transform_with_configuration(configuration_file_path, configuration_path);
+
+                return builder.build();
+            },
+            configuration_file_path)
+{
+
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_RELOADABLE_LOGGER_H
@@ -0,0 +1,305 @@
+#include "../include/binary_log_format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+constexpr char const *binary_log_format::signature;
+
+constexpr size_t binary_log_format::signature_size;
+
+constexpr uint32_t binary_log_format::raw_message_format_id;
+
+constexpr unsigned char binary_log_format::format_definition_tag;
+
+constexpr unsigned char binary_log_format::record_tag;
+
+constexpr unsigned char binary_log_format::truncated_record_flag;
+
+namespace
+{
+
+    template<
+        typename T>
+    void append_value(
+        std::string &buffer,
+        T value)
+    {
+        buffer.append(reinterpret_cast<char const *>(&value), sizeof(T));
+    }
+
+}
+
+uint32_t binary_log_format::format_dictionary::intern(
+    std::string &buffer,
+    char const *format)
+{
+    auto found_by_address = _format_ids_by_address.find(format);
+    if (found_by_address != _format_ids_by_address.end())
+    {
+        return found_by_address->second;
+    }
+
+    // the same format at another address, as a literal in another translation unit may be
+    auto found = _format_ids.find(format);
+    if (found != _format_ids.end())
+    {
+        _format_ids_by_address.emplace(format, found->second);
+        return found->second;
+    }
+
+    auto const format_id = static_cast<uint32_t>(_format_ids.size() + 1);
+    auto const format_size = static_cast<uint32_t>(std::min<size_t>(std::strlen(format), UINT32_MAX));
+
+    buffer.push_back(static_cast<char>(format_definition_tag));
+    append_value(buffer, format_id);
+    append_value(buffer, format_size);
+    buffer.append(format, format_size);
+
+    _format_ids.emplace(format, format_id);
+    _format_ids_by_address.emplace(format, format_id);
+
+    return format_id;
+}
+
+binary_log_format::decoder::decoder(
+    std::istream &stream):
+        _stream(stream)
+{
+
+}
+
+bool binary_log_format::decoder::next(
+    std::string &rendered_line)
+{
+    while (true)
+    {
+        int tag = _stream.get();
+        if (tag == std::istream::traits_type::eof())
+        {
+            return false;
+        }
+
+        if (tag == signature[0])
+        {
+            char rest_of_signature[signature_size - 1];
+            read_exactly(rest_of_signature, sizeof(rest_of_signature));
+            if (std::memcmp(rest_of_signature, signature + 1, sizeof(rest_of_signature)) != 0)
+            {
+                throw std::runtime_error("binary log: invalid signature");
+            }
+
+            // a new writer session starts its own format dictionary
+            _formats.clear();
+            continue;
+        }
+
+        if (tag == format_definition_tag)
+        {
+            auto const format_id = read_value<uint32_t>();
+            std::string format(read_value<uint32_t>(), '\0');
+            read_exactly(&format[0], format.size());
+            _formats[format_id] = std::move(format);
+            continue;
+        }
+
+        if (tag != record_tag)
+        {
+            throw std::runtime_error("binary log: unknown record tag");
+        }
+
+        auto const timestamp = read_value<int64_t>();
+        auto severity_value = read_value<unsigned char>();
+        bool const is_truncated = (severity_value & truncated_record_flag) != 0;
+        severity_value &= static_cast<unsigned char>(~truncated_record_flag);
+        auto const format_id = read_value<uint32_t>();
+        auto const arguments_count = read_value<unsigned char>();
+
+        if (severity_value > static_cast<unsigned char>(logger::severity::critical))
+        {
+            throw std::runtime_error("binary log: invalid severity");
+        }
+
+        _string_arguments.clear();
+        std::vector<std::pair<logger::format_argument::type, uint64_t>> raw_arguments;
+        for (size_t i = 0; i < arguments_count; ++i)
+        {
+            auto const type = static_cast<logger::format_argument::type>(read_value<unsigned char>());
+            switch (type)
+            {
+                case logger::format_argument::type::signed_integer:
+                case logger::format_argument::type::unsigned_integer:
+                case logger::format_argument::type::floating_point:
+                    raw_arguments.emplace_back(type, read_value<uint64_t>());
+                    break;
+                case logger::format_argument::type::string:
+                    _string_arguments.emplace_back(read_value<uint32_t>(), '\0');
+                    read_exactly(&_string_arguments.back()[0], _string_arguments.back().size());
+                    raw_arguments.emplace_back(type, _string_arguments.size() - 1);
+                    break;
+                default:
+                    throw std::runtime_error("binary log: unknown argument type");
+            }
+        }
+
+        _arguments.clear();
+        for (auto &raw_argument: raw_arguments)
+        {
+            switch (raw_argument.first)
+            {
+                case logger::format_argument::type::signed_integer:
+                    _arguments.emplace_back(static_cast<long long>(raw_argument.second));
+                    break;
+                case logger::format_argument::type::unsigned_integer:
+                    _arguments.emplace_back(static_cast<unsigned long long>(raw_argument.second));
+                    break;
+                case logger::format_argument::type::floating_point:
+                {
+                    double value;
+                    std::memcpy(&value, &raw_argument.second, sizeof(value));
+                    _arguments.emplace_back(value);
+                    break;
+                }
+                case logger::format_argument::type::string:
+                    _arguments.emplace_back(_string_arguments[raw_argument.second]);
+                    break;
+            }
+        }
+
+        std::string message;
+        if (format_id == raw_message_format_id)
+        {
+            if (_arguments.size() != 1 || _arguments[0].get_type() != logger::format_argument::type::string)
+            {
+                throw std::runtime_error("binary log: malformed raw message record");
+            }
+            message.assign(_arguments[0].get_string_data(), _arguments[0].get_string_size());
+        }
+        else
+        {
+            auto format = _formats.find(format_id);
+            if (format == _formats.end())
+            {
+                throw std::runtime_error("binary log: undefined format id " + std::to_string(format_id));
+            }
+            message = logger::render_format(format->second.c_str(), _arguments.data(), _arguments.size());
+        }
+
+        if (is_truncated)
+        {
+            message += " [truncated]";
+        }
+
+        rendered_line = render_line(timestamp, static_cast<logger::severity>(severity_value), message);
+
+        return true;
+    }
+}
+
+void binary_log_format::decoder::read_exactly(
+    void *destination,
+    size_t size)
+{
+    if (!_stream.read(reinterpret_cast<char *>(destination), static_cast<std::streamsize>(size)))
+    {
+        throw std::runtime_error("binary log: unexpected end of stream");
+    }
+}
+
+template<
+    typename T>
+T binary_log_format::decoder::read_value()
+{
+    T value;
+    read_exactly(&value, sizeof(T));
+    return value;
+}
+
+int64_t binary_log_format::current_timestamp() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void binary_log_format::append_header(
+    std::string &buffer)
+{
+    buffer.append(signature, signature_size);
+}
+
+void binary_log_format::append_record(
+    std::string &buffer,
+    int64_t timestamp,
+    logger::severity severity,
+    uint32_t format_id,
+    logger::format_argument const *arguments,
+    size_t arguments_count)
+{
+    bool is_truncated = arguments_count > UINT8_MAX;
+    if (is_truncated)
+    {
+        arguments_count = UINT8_MAX;
+    }
+
+    buffer.push_back(static_cast<char>(record_tag));
+    append_value(buffer, timestamp);
+    auto const severity_offset = buffer.size();
+    append_value(buffer, static_cast<unsigned char>(severity));
+    append_value(buffer, format_id);
+    append_value(buffer, static_cast<unsigned char>(arguments_count));
+
+    for (size_t i = 0; i < arguments_count; ++i)
+    {
+        auto const &argument = arguments[i];
+        append_value(buffer, static_cast<unsigned char>(argument.get_type()));
+
+        switch (argument.get_type())
+        {
+            case logger::format_argument::type::signed_integer:
+                append_value(buffer, static_cast<int64_t>(argument.get_signed_integer()));
+                break;
+            case logger::format_argument::type::unsigned_integer:
+                append_value(buffer, static_cast<uint64_t>(argument.get_unsigned_integer()));
+                break;
+            case logger::format_argument::type::floating_point:
+                append_value(buffer, argument.get_floating_point());
+                break;
+            case logger::format_argument::type::string:
+            {
+                // the payload is exactly as long as the length written before it
+                auto const string_size = static_cast<uint32_t>(std::min<size_t>(argument.get_string_size(), UINT32_MAX));
+                is_truncated = is_truncated || string_size != argument.get_string_size();
+                append_value(buffer, string_size);
+                buffer.append(argument.get_string_data(), string_size);
+                break;
+            }
+        }
+    }
+
+    if (is_truncated)
+    {
+        buffer[severity_offset] = static_cast<char>(static_cast<unsigned char>(severity) | truncated_record_flag);
+    }
+}
+
+std::string binary_log_format::render_line(
+    int64_t timestamp,
+    logger::severity severity,
+    std::string const &message)
+{
+    thread_local std::time_t cached_second = -1;
+    thread_local char cached_datetime[32];
+
+    auto const second = static_cast<std::time_t>(timestamp / 1000000000);
+    if (second != cached_second)
+    {
+        std::tm local_time{};
+        localtime_r(&second, &local_time);
+        std::strftime(cached_datetime, sizeof(cached_datetime), "%d.%m.%Y %H:%M:%S", &local_time);
+        cached_second = second;
+    }
+
+    return std::string("[") + cached_datetime + "][" + logger::severity_to_string(severity) + "] " + message;
+}
@@ -0,0 +1,137 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "../include/configuration_watcher.h"
+
+namespace
+{
+
+    // events arriving within this interval after the first one are merged into a single reload
+    int const settle_milliseconds = 50;
+
+}
+
+configuration_watcher::configuration_watcher(
+    std::string const &file_path,
+    std::function<void()> on_change):
+        _on_change(std::move(on_change)),
+        _inotify_descriptor(-1),
+        _stop_descriptor(-1)
+{
+    auto const separator = file_path.rfind('/');
+    _directory_path = separator == std::string::npos
+        ? "."
+        : file_path.substr(0, separator == 0 ? 1 : separator);
+    _file_name = separator == std::string::npos
+        ? file_path
+        : file_path.substr(separator + 1);
+
+    _inotify_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotify_descriptor == -1)
+    {
+        throw std::runtime_error(std::string("can't initialize inotify: ") + std::strerror(errno));
+    }
+
+    if (inotify_add_watch(_inotify_descriptor, _directory_path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+    {
+        auto const error = errno;
+        ::close(_inotify_descriptor);
+        throw std::runtime_error("can't watch \"" + _directory_path + "\": " + std::strerror(error));
+    }
+
+    _stop_descriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_stop_descriptor == -1)
+    {
+        auto const error = errno;
+        ::close(_inotify_descriptor);
+        throw std::runtime_error(std::string("can't create eventfd: ") + std::strerror(error));
+    }
+
+    _worker = std::thread(&configuration_watcher::watch, this);
+}
+
+configuration_watcher::~configuration_watcher() noexcept
+{
+    uint64_t const stop = 1;
+    if (write(_stop_descriptor, &stop, sizeof(stop)) == -1)
+    {
+        // eventfd only fails on counter overflow, which can't happen with a single write
+    }
+
+    _worker.join();
+
+    ::close(_stop_descriptor);
+    ::close(_inotify_descriptor);
+}
+
+void configuration_watcher::watch() noexcept
+{
+    pollfd descriptors[] =
+    {
+        { _inotify_descriptor, POLLIN, 0 },
+        { _stop_descriptor, POLLIN, 0 }
+    };
+
+    bool is_changed = false;
+
+    while (true)
+    {
+        // once a change is seen, wait for the writer to settle before notifying
+        if (poll(descriptors, 2, is_changed ? settle_milliseconds : -1) == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+
+        if (descriptors[1].revents != 0)
+        {
+            return;
+        }
+
+        if (descriptors[0].revents != 0)
+        {
+            is_changed = read_events() || is_changed;
+            continue;
+        }
+
+        if (is_changed)
+        {
+            is_changed = false;
+            _on_change();
+        }
+    }
+}
+
+bool configuration_watcher::read_events() noexcept
+{
+    alignas(inotify_event) char buffer[4096];
+    bool is_watched_file_changed = false;
+
+    while (true)
+    {
+        auto const read_size = read(_inotify_descriptor, buffer, sizeof(buffer));
+        if (read_size <= 0)
+        {
+            return is_watched_file_changed;
+        }
+
+        for (char const *position = buffer; position < buffer + read_size;)
+        {
+            auto const *event = reinterpret_cast<inotify_event const *>(position);
+            if (event->len != 0 && _file_name == event->name)
+            {
+                is_watched_file_changed = true;
+            }
+            position += sizeof(inotify_event) + event->len;
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <ctime>
+
+#include "../include/log_rate_limiter.h"
+
+log_rate_limiter::policy::policy() noexcept:
+    lines_per_second(0),
+    burst(0),
+    sampling_period(0)
+{
+
+}
+
+log_rate_limiter::log_rate_limiter(
+    std::map<logger::severity, policy> const &policies):
+        _policies(policies),
+        _started_at(current_nanoseconds())
+{
+    for (auto &state: _states)
+    {
+        state.lines_per_nanosecond = 0;
+        state.burst = 0;
+        state.sampling_period = 0;
+        state.consumed_tokens.store(0, std::memory_order_relaxed);
+        state.unreported.store(0, std::memory_order_relaxed);
+        state.reported.store(0, std::memory_order_relaxed);
+        state.plain_calls.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto &severity_policy: _policies)
+    {
+        auto &state = _states[static_cast<size_t>(severity_policy.first)];
+        auto const &configured = severity_policy.second;
+
+        state.lines_per_nanosecond = configured.lines_per_second / 1e9;
+        state.burst = configured.burst != 0
+            ? configured.burst
+            : std::max<uint64_t>(1, static_cast<uint64_t>(configured.lines_per_second));
+        state.sampling_period = configured.sampling_period;
+
+        if (state.sampling_period > 1)
+        {
+            state.sampling_counters.reset(new std::atomic<uint32_t>[sampling_counters_count]);
+            for (size_t i = 0; i < sampling_counters_count; ++i)
+            {
+                state.sampling_counters[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+log_rate_limiter::log_rate_limiter(
+    log_rate_limiter const &other):
+        log_rate_limiter(other._policies)
+{
+
+}
+
+bool log_rate_limiter::admit(
+    logger::severity severity,
+    void const *message_template) noexcept
+{
+    auto &state = _states[static_cast<size_t>(severity)];
+
+    if (state.sampling_period > 1)
+    {
+        // format strings are literals and call sites code addresses, so neither needs its text hashed
+        auto &counter = message_template != nullptr
+            ? state.sampling_counters[(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(message_template)) * 0x9e3779b97f4a7c15ULL) >> 54]
+            : state.plain_calls;
+
+        if (counter.fetch_add(1, std::memory_order_relaxed) % state.sampling_period != 0)
+        {
+            return suppress(state);
+        }
+    }
+
+    if (state.lines_per_nanosecond > 0 && !take_token(state))
+    {
+        return suppress(state);
+    }
+
+    return true;
+}
+
+unsigned long long log_rate_limiter::take_unreported(
+    logger::severity severity) noexcept
+{
+    auto &state = _states[static_cast<size_t>(severity)];
+
+    if (state.unreported.load(std::memory_order_relaxed) == 0)
+    {
+        return 0;
+    }
+
+    auto const unreported = state.unreported.exchange(0, std::memory_order_relaxed);
+    state.reported.fetch_add(unreported, std::memory_order_relaxed);
+
+    return unreported;
+}
+
+unsigned long long log_rate_limiter::get_suppressed_count(
+    logger::severity severity) const noexcept
+{
+    auto const &state = _states[static_cast<size_t>(severity)];
+
+    return state.reported.load(std::memory_order_relaxed) + state.unreported.load(std::memory_order_relaxed);
+}
+
+std::map<logger::severity, log_rate_limiter::policy> const &log_rate_limiter::get_policies() const noexcept
+{
+    return _policies;
+}
+
+bool log_rate_limiter::take_token(
+    severity_state &state) noexcept
+{
+    // tokens produced since construction; the bucket is full at start
+    auto const elapsed = current_nanoseconds() - _started_at;
+    auto const produced = state.burst + static_cast<uint64_t>(state.lines_per_nanosecond * static_cast<double>(elapsed));
+
+    auto consumed = state.consumed_tokens.load(std::memory_order_relaxed);
+    if (consumed >= produced)
+    {
+        return false;
+    }
+
+    if (produced - consumed > state.burst)
+    {
+        // after an idle period the bucket holds at most burst tokens; losing this race is harmless
+        state.consumed_tokens.compare_exchange_strong(consumed, produced - state.burst, std::memory_order_relaxed);
+    }
+
+    return state.consumed_tokens.fetch_add(1, std::memory_order_relaxed) < produced;
+}
+
+bool log_rate_limiter::suppress(
+    severity_state &state) noexcept
+{
+    state.unreported.fetch_add(1, std::memory_order_relaxed);
+
+    return false;
+}
+
+int64_t log_rate_limiter::current_nanoseconds() noexcept
+{
+    // the coarse clock is read from the vDSO without a syscall; its few milliseconds of resolution are enough here
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+
+    return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
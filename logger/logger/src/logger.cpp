@@ -1,44 +1,358 @@
 #include "../include/logger.h"
-#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+logger::format_argument::format_argument(
+    int value) noexcept:
+        _type(type::signed_integer),
+        _signed_integer(value)
+{
+
+}
+
+logger::format_argument::format_argument(
+    long value) noexcept:
+        _type(type::signed_integer),
+        _signed_integer(value)
+{
+
+}
+
+logger::format_argument::format_argument(
+    long long value) noexcept:
+        _type(type::signed_integer),
+        _signed_integer(value)
+{
+
+}
+
+logger::format_argument::format_argument(
+    unsigned int value) noexcept:
+        _type(type::unsigned_integer),
+        _unsigned_integer(value)
+{
+
+}
+
+logger::format_argument::format_argument(
+    unsigned long value) noexcept:
+        _type(type::unsigned_integer),
+        _unsigned_integer(value)
+{
+
+}
+
+logger::format_argument::format_argument(
+    unsigned long long value) noexcept:
+        _type(type::unsigned_integer),
+        _unsigned_integer(value)
+{
+
+}
+
+logger::format_argument::format_argument(
+    double value) noexcept:
+        _type(type::floating_point),
+        _floating_point(value)
+{
+
+}
+
+logger::format_argument::format_argument(
+    char const *value) noexcept:
+        format_argument(value, std::char_traits<char>::length(value))
+{
+
+}
+
+logger::format_argument::format_argument(
+    char const *data,
+    size_t size) noexcept:
+        _type(type::string)
+{
+    _string.data = data;
+    _string.size = size;
+}
+
+logger::format_argument::format_argument(
+    std::string const &value) noexcept:
+        format_argument(value.data(), value.size())
+{
+
+}
+
+logger::message_view::message_view(
+    char const *text) noexcept:
+        message_view(text, std::char_traits<char>::length(text))
+{
+    // literals live as long as the program, so the address tells their call sites apart
+    _call_site = text;
+}
+
+logger::message_view::message_view(
+    char const *data,
+    size_t size) noexcept:
+        _data(data),
+        _size(size),
+        _call_site(nullptr)
+{
+
+}
+
+logger::message_view::message_view(
+    std::string const &text) noexcept:
+        message_view(text.data(), text.size())
+{
+
+}
+
+char const *logger::message_view::data() const noexcept
+{
+    return _data;
+}
+
+size_t logger::message_view::size() const noexcept
+{
+    return _size;
+}
+
+void const *logger::message_view::get_call_site() const noexcept
+{
+    return _call_site;
+}
+
+logger::message_view logger::message_view::with_call_site(
+    void const *call_site) const noexcept
+{
+    message_view attributed(*this);
+    if (attributed._call_site == nullptr)
+    {
+        attributed._call_site = call_site;
+    }
+
+    return attributed;
+}
+
+logger::format_argument::type logger::format_argument::get_type() const noexcept
+{
+    return _type;
+}
+
+long long logger::format_argument::get_signed_integer() const noexcept
+{
+    return _signed_integer;
+}
+
+unsigned long long logger::format_argument::get_unsigned_integer() const noexcept
+{
+    return _unsigned_integer;
+}
+
+double logger::format_argument::get_floating_point() const noexcept
+{
+    return _floating_point;
+}
+
+char const *logger::format_argument::get_string_data() const noexcept
+{
+    return _string.data;
+}
+
+size_t logger::format_argument::get_string_size() const noexcept
+{
+    return _string.size;
+}
+
+logger const *logger::log(
+    logger::message_view message,
+    logger::severity severity) const noexcept
+{
+    return log(std::string(message.data(), message.size()), severity);
+}
+
+logger const *logger::log(
+    char const *message,
+    logger::severity severity) const noexcept
+{
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), severity);
+}
+
+logger const *logger::log_structured(
+    logger::severity severity,
+    char const *format,
+    logger::format_argument const *arguments,
+    size_t arguments_count) const noexcept
+{
+    return log(render_format(format, arguments, arguments_count), severity);
+}
 
 logger const *logger::trace(
     std::string const &message) const noexcept
 {
-    return log(message, logger::severity::trace);
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::trace);
+}
+
+logger const *logger::trace(
+    logger::message_view message) const noexcept
+{
+    return log(message.with_call_site(__builtin_return_address(0)), logger::severity::trace);
+}
+
+logger const *logger::trace(
+    char const *message) const noexcept
+{
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::trace);
 }
 
 logger const *logger::debug(
     std::string const &message) const noexcept
 {
-    return log(message, logger::severity::debug);
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::debug);
+}
+
+logger const *logger::debug(
+    logger::message_view message) const noexcept
+{
+    return log(message.with_call_site(__builtin_return_address(0)), logger::severity::debug);
+}
+
+logger const *logger::debug(
+    char const *message) const noexcept
+{
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::debug);
 }
 
 logger const *logger::information(
     std::string const &message) const noexcept
 {
-    return log(message, logger::severity::information);
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::information);
+}
+
+logger const *logger::information(
+    logger::message_view message) const noexcept
+{
+    return log(message.with_call_site(__builtin_return_address(0)), logger::severity::information);
+}
+
+logger const *logger::information(
+    char const *message) const noexcept
+{
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::information);
 }
 
 logger const *logger::warning(
     std::string const &message) const noexcept
 {
-    return log(message, logger::severity::warning);
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::warning);
+}
+
+logger const *logger::warning(
+    logger::message_view message) const noexcept
+{
+    return log(message.with_call_site(__builtin_return_address(0)), logger::severity::warning);
+}
+
+logger const *logger::warning(
+    char const *message) const noexcept
+{
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::warning);
 }
 
 logger const *logger::error(
     std::string const &message) const noexcept
 {
-    return log(message, logger::severity::error);
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::error);
+}
+
+logger const *logger::error(
+    logger::message_view message) const noexcept
+{
+    return log(message.with_call_site(__builtin_return_address(0)), logger::severity::error);
+}
+
+logger const *logger::error(
+    char const *message) const noexcept
+{
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::error);
 }
 
 logger const *logger::critical(
     std::string const &message) const noexcept
 {
-    return log(message, logger::severity::critical);
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::critical);
+}
+
+logger const *logger::critical(
+    logger::message_view message) const noexcept
+{
+    return log(message.with_call_site(__builtin_return_address(0)), logger::severity::critical);
+}
+
+logger const *logger::critical(
+    char const *message) const noexcept
+{
+    return log(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::critical);
+}
+
+std::string logger::render_format(
+    char const *format,
+    logger::format_argument const *arguments,
+    size_t arguments_count)
+{
+    std::string result;
+    size_t argument_index = 0;
+
+    for (char const *current = format; *current != '\0'; ++current)
+    {
+        if (current[0] != '{' || current[1] != '}' || argument_index == arguments_count)
+        {
+            result.push_back(*current);
+            continue;
+        }
+
+        auto const &argument = arguments[argument_index++];
+        switch (argument.get_type())
+        {
+            case logger::format_argument::type::signed_integer:
+                result += std::to_string(argument.get_signed_integer());
+                break;
+            case logger::format_argument::type::unsigned_integer:
+                result += std::to_string(argument.get_unsigned_integer());
+                break;
+            case logger::format_argument::type::floating_point:
+            {
+                char buffer[32];
+                std::snprintf(buffer, sizeof(buffer), "%.15g", argument.get_floating_point());
+                result += buffer;
+                break;
+            }
+            case logger::format_argument::type::string:
+                result.append(argument.get_string_data(), argument.get_string_size());
+                break;
+        }
+
+        ++current;
+    }
+
+    return result;
 }
 
 std::string logger::severity_to_string(
     logger::severity severity)
+{
+    auto const *name = severity_to_c_string(severity);
+    if (name == nullptr)
+    {
+        throw std::out_of_range("Invalid severity value");
+    }
+
+    return name;
+}
+
+char const *logger::severity_to_c_string(
+    logger::severity severity) noexcept
 {
     switch (severity)
     {
@@ -56,15 +370,75 @@ std::string logger::severity_to_string(
             return "CRITICAL";
     }
 
-    throw std::out_of_range("Invalid severity value");
+    return nullptr;
 }
 
 std::string logger::current_datetime_to_string() noexcept
 {
-    auto time = std::time(nullptr);
+    return current_datetime_to_string(logger::datetime_precision::seconds);
+}
+
+std::string logger::current_datetime_to_string(
+    logger::datetime_precision precision) noexcept
+{
+    std::string result;
+    append_current_datetime(result, precision);
+
+    return result;
+}
+
+void logger::append_current_datetime(
+    std::string &destination,
+    logger::datetime_precision precision) noexcept
+{
+    size_t const datetime_length = 19;
+
+    thread_local std::time_t cached_second = -1;
+    thread_local char cached_datetime[datetime_length + 1];
+
+    auto const nanoseconds_since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    auto const second = static_cast<std::time_t>(nanoseconds_since_epoch / 1000000000);
+
+    if (second != cached_second)
+    {
+        std::tm local_time{};
+        localtime_r(&second, &local_time);
+        std::strftime(cached_datetime, sizeof(cached_datetime), "%d.%m.%Y %H:%M:%S", &local_time);
+        cached_second = second;
+    }
+
+    size_t fraction_digits = 0;
+    switch (precision)
+    {
+        case logger::datetime_precision::seconds:
+            destination.append(cached_datetime, datetime_length);
+            return;
+        case logger::datetime_precision::milliseconds:
+            fraction_digits = 3;
+            break;
+        case logger::datetime_precision::microseconds:
+            fraction_digits = 6;
+            break;
+        case logger::datetime_precision::nanoseconds:
+            fraction_digits = 9;
+            break;
+    }
 
-    std::ostringstream result_stream;
-    result_stream << std::put_time(std::localtime(&time), "%d.%m.%Y %H:%M:%S");
+    char result[datetime_length + 10];
+    std::memcpy(result, cached_datetime, datetime_length);
+    result[datetime_length] = '.';
 
-    return result_stream.str();
-}
\ No newline at end of file
+    auto fraction = static_cast<unsigned long>(nanoseconds_since_epoch % 1000000000);
+    for (size_t i = 9; i > fraction_digits; --i)
+    {
+        fraction /= 10;
+    }
+    for (size_t i = fraction_digits; i > 0; --i)
+    {
+        result[datetime_length + i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+
+    destination.append(result, datetime_length + 1 + fraction_digits);
+}
@@ -0,0 +1,478 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include "../include/logger_builder.h"
+#include "../include/logger_configuration.h"
+
+namespace
+{
+
+    class mapped_file final
+    {
+
+    private:
+
+        void *_data;
+
+        size_t _size;
+
+    public:
+
+        explicit mapped_file(
+            std::string const &file_path):
+                _data(nullptr),
+                _size(0)
+        {
+            int descriptor = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (descriptor == -1)
+            {
+                throw std::runtime_error("can't open configuration file \"" + file_path + "\": " + std::strerror(errno));
+            }
+
+            struct stat file_status{};
+            if (fstat(descriptor, &file_status) == -1)
+            {
+                ::close(descriptor);
+                throw std::runtime_error("can't stat configuration file \"" + file_path + "\": " + std::strerror(errno));
+            }
+
+            _size = static_cast<size_t>(file_status.st_size);
+            if (_size != 0)
+            {
+                _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (_data == MAP_FAILED)
+                {
+                    ::close(descriptor);
+                    throw std::runtime_error("can't map configuration file \"" + file_path + "\": " + std::strerror(errno));
+                }
+                madvise(_data, _size, MADV_SEQUENTIAL);
+            }
+
+            ::close(descriptor);
+        }
+
+        ~mapped_file() noexcept
+        {
+            if (_data != nullptr)
+            {
+                munmap(_data, _size);
+            }
+        }
+
+        mapped_file(
+            mapped_file const &other) = delete;
+
+        mapped_file &operator=(
+            mapped_file const &other) = delete;
+
+    public:
+
+        [[nodiscard]] char const *begin() const noexcept
+        {
+            return static_cast<char const *>(_data);
+        }
+
+        [[nodiscard]] char const *end() const noexcept
+        {
+            return begin() + _size;
+        }
+
+    };
+
+    std::vector<std::string> split_configuration_path(
+        std::string const &configuration_path)
+    {
+        std::vector<std::string> keys;
+        size_t key_begin = 0;
+
+        while (key_begin <= configuration_path.size())
+        {
+            auto key_end = configuration_path.find('/', key_begin);
+            if (key_end == std::string::npos)
+            {
+                key_end = configuration_path.size();
+            }
+            if (key_end != key_begin)
+            {
+                keys.emplace_back(configuration_path, key_begin, key_end - key_begin);
+            }
+            key_begin = key_end + 1;
+        }
+
+        return keys;
+    }
+
+    logger::datetime_precision string_to_datetime_precision(
+        std::string const &precision_string)
+    {
+        if (precision_string == "seconds")
+        {
+            return logger::datetime_precision::seconds;
+        }
+        if (precision_string == "milliseconds")
+        {
+            return logger::datetime_precision::milliseconds;
+        }
+        if (precision_string == "microseconds")
+        {
+            return logger::datetime_precision::microseconds;
+        }
+        if (precision_string == "nanoseconds")
+        {
+            return logger::datetime_precision::nanoseconds;
+        }
+
+        throw std::runtime_error("invalid datetime precision \"" + precision_string + "\"");
+    }
+
+}
+
+/*
+ * SAX handler: tracks the key of every enclosing object and only stores the values
+ * found inside the object at the configuration path.
+ */
+class logger_configuration::parser final:
+    public nlohmann::json_sax<nlohmann::json>
+{
+
+private:
+
+    struct frame final
+    {
+
+        bool is_array;
+
+        std::string key;
+
+    };
+
+private:
+
+    logger_configuration &_configuration;
+
+    std::vector<std::string> const _target_keys;
+
+    std::vector<frame> _frames;
+
+    size_t _target_depth;
+
+    bool _is_target_found;
+
+    bool _is_target_open;
+
+public:
+
+    parser(
+        logger_configuration &configuration,
+        std::string const &configuration_path):
+            _configuration(configuration),
+            _target_keys(split_configuration_path(configuration_path)),
+            _target_depth(0),
+            _is_target_found(false),
+            _is_target_open(false)
+    {
+
+    }
+
+public:
+
+    [[nodiscard]] bool is_target_found() const noexcept
+    {
+        return _is_target_found;
+    }
+
+public:
+
+    bool null() override
+    {
+        return value_is_not_stored();
+    }
+
+    bool boolean(
+        bool) override
+    {
+        return value_is_not_stored();
+    }
+
+    bool number_integer(
+        number_integer_t) override
+    {
+        return value_is_not_stored();
+    }
+
+    bool number_unsigned(
+        number_unsigned_t) override
+    {
+        return value_is_not_stored();
+    }
+
+    bool number_float(
+        number_float_t,
+        string_t const &) override
+    {
+        return value_is_not_stored();
+    }
+
+    bool string(
+        string_t &value) override
+    {
+        if (!is_inside_target())
+        {
+            return true;
+        }
+
+        auto const nested_depth = _frames.size() - _target_depth - 1;
+        auto const &section = _frames[_target_depth].key;
+
+        if (section == "console" && is_severities_value(nested_depth, 0))
+        {
+            _configuration._console_stream_severities.insert(to_severity(value));
+        }
+        else if ((section == "files" || section == "binary_files")
+            && is_severities_value(nested_depth, 1)
+            && !_frames[_target_depth + 1].is_array)
+        {
+            auto &file_streams = section == "files"
+                ? _configuration._file_streams
+                : _configuration._binary_file_streams;
+            file_streams[_frames[_target_depth + 1].key].insert(to_severity(value));
+        }
+        else if (section == "datetime_precision" && nested_depth == 0)
+        {
+            _configuration._has_datetime_precision = true;
+            _configuration._datetime_precision = string_to_datetime_precision(value);
+        }
+        else if (section == "server_name" && nested_depth == 0)
+        {
+            _configuration._server_name = value;
+        }
+        else
+        {
+            return value_is_not_stored();
+        }
+
+        return true;
+    }
+
+    bool binary(
+        binary_t &) override
+    {
+        return value_is_not_stored();
+    }
+
+    bool start_object(
+        std::size_t) override
+    {
+        if (!_is_target_found && is_at_target())
+        {
+            _is_target_found = true;
+            _is_target_open = true;
+            _target_depth = _frames.size();
+        }
+        else if (is_inside_target() && !is_files_section())
+        {
+            value_is_not_stored();
+        }
+
+        _frames.push_back(frame{false, std::string()});
+
+        return true;
+    }
+
+    bool key(
+        string_t &value) override
+    {
+        _frames.back().key = value;
+
+        return true;
+    }
+
+    bool end_object() override
+    {
+        _frames.pop_back();
+        if (_is_target_open && _frames.size() == _target_depth)
+        {
+            _is_target_open = false;
+        }
+
+        return true;
+    }
+
+    bool start_array(
+        std::size_t) override
+    {
+        if (is_inside_target() && _frames.back().is_array)
+        {
+            value_is_not_stored();
+        }
+
+        _frames.push_back(frame{true, std::string()});
+
+        return true;
+    }
+
+    bool end_array() override
+    {
+        _frames.pop_back();
+
+        return true;
+    }
+
+    bool parse_error(
+        std::size_t,
+        std::string const &,
+        nlohmann::detail::exception const &error) override
+    {
+        throw std::runtime_error(error.what());
+    }
+
+private:
+
+    /*
+     * True while the parser is at the position of the configuration path's value.
+     */
+    [[nodiscard]] bool is_at_target() const noexcept
+    {
+        if (_frames.size() != _target_keys.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < _frames.size(); ++i)
+        {
+            if (_frames[i].is_array || _frames[i].key != _target_keys[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool is_inside_target() const noexcept
+    {
+        return _is_target_open;
+    }
+
+    [[nodiscard]] bool is_files_section() const noexcept
+    {
+        return _frames.size() == _target_depth + 1
+            && (_frames.back().key == "files" || _frames.back().key == "binary_files");
+    }
+
+    /*
+     * Severities are a string directly under their key or elements of an array there.
+     */
+    [[nodiscard]] bool is_severities_value(
+        size_t nested_depth,
+        size_t key_depth) const noexcept
+    {
+        return nested_depth == key_depth
+            || (nested_depth == key_depth + 1 && _frames.back().is_array);
+    }
+
+    /*
+     * Values outside the target object are skipped; known keys inside it must have the documented shape.
+     */
+    bool value_is_not_stored() const
+    {
+        if (!is_inside_target())
+        {
+            return true;
+        }
+
+        auto const &section = _frames[_target_depth].key;
+        if (section == "console" || section == "files" || section == "binary_files"
+            || section == "datetime_precision" || section == "server_name")
+        {
+            throw std::runtime_error("invalid value of \"" + section + "\"");
+        }
+
+        return true;
+    }
+
+    static logger::severity to_severity(
+        std::string const &severity_string)
+    {
+        try
+        {
+            return logger_builder::string_to_severity(severity_string);
+        }
+        catch (std::out_of_range const &)
+        {
+            throw std::runtime_error("invalid severity \"" + severity_string + "\"");
+        }
+    }
+
+};
+
+logger_configuration logger_configuration::load(
+    std::string const &configuration_file_path,
+    std::string const &configuration_path)
+{
+    logger_configuration configuration;
+    parser configuration_parser(configuration, configuration_path);
+
+    try
+    {
+        mapped_file file(configuration_file_path);
+        nlohmann::json::sax_parse(file.begin(), file.end(), &configuration_parser);
+    }
+    catch (std::exception const &error)
+    {
+        throw std::runtime_error("can't load logger configuration \"" + configuration_file_path + "\": " + error.what());
+    }
+
+    if (!configuration_parser.is_target_found())
+    {
+        throw std::runtime_error("logger configuration \"" + configuration_file_path + "\" has no object at \"" + configuration_path + "\"");
+    }
+
+    return configuration;
+}
+
+logger_configuration::logger_configuration():
+    _has_datetime_precision(false),
+    _datetime_precision(logger::datetime_precision::seconds)
+{
+
+}
+
+std::map<std::string, std::set<logger::severity>> const &logger_configuration::get_file_streams() const noexcept
+{
+    return _file_streams;
+}
+
+std::map<std::string, std::set<logger::severity>> const &logger_configuration::get_binary_file_streams() const noexcept
+{
+    return _binary_file_streams;
+}
+
+std::set<logger::severity> const &logger_configuration::get_console_stream_severities() const noexcept
+{
+    return _console_stream_severities;
+}
+
+bool logger_configuration::has_datetime_precision() const noexcept
+{
+    return _has_datetime_precision;
+}
+
+logger::datetime_precision logger_configuration::get_datetime_precision() const noexcept
+{
+    return _datetime_precision;
+}
+
+std::string const &logger_configuration::get_server_name() const noexcept
+{
+    return _server_name;
+}
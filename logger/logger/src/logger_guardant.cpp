@@ -3,48 +3,134 @@
 logger_guardant const *logger_guardant::log_with_guard(
     std::string const &message,
     logger::severity severity) const
+{
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), severity);
+}
+
+logger_guardant const *logger_guardant::log_with_guard(
+    logger::message_view message,
+    logger::severity severity) const
 {
     logger *got_logger = get_logger();
     if (got_logger != nullptr)
     {
-        got_logger->log(message, severity);
+        got_logger->log(message.with_call_site(__builtin_return_address(0)), severity);
     }
 
     return this;
 }
 
+logger_guardant const *logger_guardant::log_with_guard(
+    char const *message,
+    logger::severity severity) const
+{
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), severity);
+}
+
 logger_guardant const *logger_guardant::trace_with_guard(
     std::string const &message) const
 {
-    return log_with_guard(message, logger::severity::trace);
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::trace);
+}
+
+logger_guardant const *logger_guardant::trace_with_guard(
+    logger::message_view message) const
+{
+    return log_with_guard(message.with_call_site(__builtin_return_address(0)), logger::severity::trace);
+}
+
+logger_guardant const *logger_guardant::trace_with_guard(
+    char const *message) const
+{
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::trace);
 }
 
 logger_guardant const *logger_guardant::debug_with_guard(
     std::string const &message) const
 {
-    return log_with_guard(message, logger::severity::debug);
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::debug);
+}
+
+logger_guardant const *logger_guardant::debug_with_guard(
+    logger::message_view message) const
+{
+    return log_with_guard(message.with_call_site(__builtin_return_address(0)), logger::severity::debug);
+}
+
+logger_guardant const *logger_guardant::debug_with_guard(
+    char const *message) const
+{
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::debug);
 }
 
 logger_guardant const *logger_guardant::information_with_guard(
     std::string const &message) const
 {
-    return log_with_guard(message, logger::severity::information);
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::information);
+}
+
+logger_guardant const *logger_guardant::information_with_guard(
+    logger::message_view message) const
+{
+    return log_with_guard(message.with_call_site(__builtin_return_address(0)), logger::severity::information);
+}
+
+logger_guardant const *logger_guardant::information_with_guard(
+    char const *message) const
+{
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::information);
 }
 
 logger_guardant const *logger_guardant::warning_with_guard(
     std::string const &message) const
 {
-    return log_with_guard(message, logger::severity::warning);
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::warning);
+}
+
+logger_guardant const *logger_guardant::warning_with_guard(
+    logger::message_view message) const
+{
+    return log_with_guard(message.with_call_site(__builtin_return_address(0)), logger::severity::warning);
+}
+
+logger_guardant const *logger_guardant::warning_with_guard(
+    char const *message) const
+{
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::warning);
 }
 
 logger_guardant const *logger_guardant::error_with_guard(
     std::string const &message) const
 {
-    return log_with_guard(message, logger::severity::error);
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::error);
+}
+
+logger_guardant const *logger_guardant::error_with_guard(
+    logger::message_view message) const
+{
+    return log_with_guard(message.with_call_site(__builtin_return_address(0)), logger::severity::error);
+}
+
+logger_guardant const *logger_guardant::error_with_guard(
+    char const *message) const
+{
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::error);
 }
 
 logger_guardant const *logger_guardant::critical_with_guard(
     std::string const &message) const
 {
-    return log_with_guard(message, logger::severity::critical);
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::critical);
+}
+
+logger_guardant const *logger_guardant::critical_with_guard(
+    logger::message_view message) const
+{
+    return log_with_guard(message.with_call_site(__builtin_return_address(0)), logger::severity::critical);
+}
+
+logger_guardant const *logger_guardant::critical_with_guard(
+    char const *message) const
+{
+    return log_with_guard(logger::message_view(message).with_call_site(__builtin_return_address(0)), logger::severity::critical);
 }
\ No newline at end of file
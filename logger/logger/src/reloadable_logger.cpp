@@ -0,0 +1,74 @@
+#include <stdexcept>
+
+#include "../include/reloadable_logger.h"
+
+reloadable_logger::reloadable_logger(
+    std::function<logger *()> build,
+    std::string const &configuration_file_path):
+        _build(std::move(build)),
+        _current(_build()),
+        _reloads_count(0),
+        _watcher(configuration_file_path, [this]() { reload_on_change(); })
+{
+
+}
+
+logger const *reloadable_logger::log(
+    std::string const &message,
+    logger::severity severity) const noexcept
+{
+    // holding a reference keeps the logger alive even if a reload replaces it during the call
+    auto const current = std::atomic_load(&_current);
+    current->log(logger::message_view(message).with_call_site(__builtin_return_address(0)), severity);
+
+    return this;
+}
+
+logger const *reloadable_logger::log(
+    logger::message_view message,
+    logger::severity severity) const noexcept
+{
+    auto const current = std::atomic_load(&_current);
+    current->log(message.with_call_site(__builtin_return_address(0)), severity);
+
+    return this;
+}
+
+logger const *reloadable_logger::log_structured(
+    logger::severity severity,
+    char const *format,
+    logger::format_argument const *arguments,
+    size_t arguments_count) const noexcept
+{
+    auto const current = std::atomic_load(&_current);
+    current->log_structured(severity, format, arguments, arguments_count);
+
+    return this;
+}
+
+void reloadable_logger::reload()
+{
+    std::lock_guard<std::mutex> lock(_reload_guard);
+
+    std::shared_ptr<logger const> rebuilt(_build());
+    std::atomic_store(&_current, std::move(rebuilt));
+
+    ++_reloads_count;
+}
+
+unsigned long long reloadable_logger::get_reloads_count() const noexcept
+{
+    return _reloads_count.load();
+}
+
+void reloadable_logger::reload_on_change() noexcept
+{
+    try
+    {
+        reload();
+    }
+    catch (std::exception const &error)
+    {
+        std::atomic_load(&_current)->error(std::string("configuration reload failed, keeping the previous one: ") + error.what());
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_SERVER_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_SERVER_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <logger.h>
+#include "shared_memory_ring.h"
+
+/*
+ * Consumer side of server_logger: owns the file sinks and writes the records
+ * that client processes push into the shared memory ring.
+ *
+ * The server writes only the files it was started with. A logger's paths are absolute,
+ * as resolved by the client process, and select among those files; any other path is ignored.
+ *
+ * Messages (each one ring record, integers in host byte order):
+ *
+ *     open logger    'O' | u64 logger id | u8 console severities mask | u32 streams count | { u8 severities mask | u32 path length | path }
+ *     close logger   'C' | u64 logger id
+ *     record         'R' | u64 logger id | i64 timestamp (ns since epoch) | u8 severity | message bytes
+ */
+class log_server final
+{
+
+public:
+
+    static constexpr unsigned char open_logger_message = 'O';
+
+    static constexpr unsigned char close_logger_message = 'C';
+
+    static constexpr unsigned char record_message = 'R';
+
+    static constexpr char const *default_name = "/mp_os_log_server";
+
+    static constexpr size_t default_capacity = 1 << 22;
+
+private:
+
+    struct logger_streams final
+    {
+
+        std::vector<std::pair<std::ofstream *, unsigned char>> file_sinks;
+
+        unsigned char console_severities_mask;
+
+    };
+
+private:
+
+    shared_memory_ring _ring;
+
+    // by canonical path, so that every spelling of a file's path selects the same stream
+    std::map<std::string, std::ofstream *> _file_sinks;
+
+    std::unordered_map<uint64_t, logger_streams> _loggers;
+
+    unsigned long long _processed_records_count;
+
+public:
+
+    /*
+     * Opens file_paths for appending; throws std::runtime_error if one can't be opened
+     * or a server is already running under the name.
+     */
+    explicit log_server(
+        std::string const &name = default_name,
+        size_t capacity = default_capacity,
+        std::vector<std::string> const &file_paths = {});
+
+    ~log_server() noexcept;
+
+    log_server(
+        log_server const &other) = delete;
+
+    log_server &operator=(
+        log_server const &other) = delete;
+
+public:
+
+    /*
+     * Processes messages until stop() is called, then drains what is left in the ring.
+     */
+    void run();
+
+    void stop() noexcept;
+
+    [[nodiscard]] unsigned long long get_processed_records_count() const noexcept;
+
+public:
+
+    static unsigned char severity_to_mask(
+        logger::severity severity) noexcept;
+
+private:
+
+    void process(
+        char const *message,
+        size_t message_size);
+
+    void open_logger(
+        uint64_t logger_id,
+        char const *message,
+        char const *message_end);
+
+    void close_logger(
+        uint64_t logger_id) noexcept;
+
+    void write_record(
+        uint64_t logger_id,
+        int64_t timestamp,
+        logger::severity severity,
+        char const *text,
+        size_t text_size);
+
+    void flush() noexcept;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_SERVER_H
@@ -1,13 +1,53 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_H
 
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <set>
+
 #include <logger.h>
 #include "server_logger_builder.h"
+#include "shared_memory_ring.h"
 
+/*
+ * Ships records through a shared memory ring to a log_server process, which owns the sinks:
+ * logging from the application never touches a file. A record that finds the ring full is dropped
+ * and counted, unless the builder set a time to wait for free space.
+ */
 class server_logger final:
     public logger
 {
 
+    friend class server_logger_builder;
+
+private:
+
+    std::string _server_name;
+
+    std::shared_ptr<shared_memory_ring> _ring;
+
+    uint64_t _logger_id;
+
+    std::map<std::string, std::set<logger::severity>> _file_streams;
+
+    std::set<logger::severity> _console_stream_severities;
+
+    unsigned char _severities_mask;
+
+    std::chrono::milliseconds _push_timeout;
+
+    mutable std::atomic<unsigned long long> _dropped_records_count;
+
+private:
+
+    server_logger(
+        std::string const &server_name,
+        std::map<std::string, std::set<logger::severity>> const &file_streams,
+        std::set<logger::severity> const &console_stream_severities,
+        std::chrono::milliseconds push_timeout);
+
 public:
 
     server_logger(
@@ -26,10 +66,35 @@ public:
 
 public:
 
+    using logger::log;
+
     [[nodiscard]] logger const *log(
         const std::string &message,
         logger::severity severity) const noexcept override;
 
+    [[nodiscard]] logger const *log(
+        logger::message_view message,
+        logger::severity severity) const noexcept override;
+
+public:
+
+    /*
+     * Records this logger dropped because the ring was full so far.
+     */
+    [[nodiscard]] unsigned long long get_dropped_records_count() const noexcept;
+
+private:
+
+    void open();
+
+    void close() noexcept;
+
+    static std::shared_ptr<shared_memory_ring> connect(
+        std::string const &server_name);
+
+    static unsigned char severities_to_mask(
+        std::set<logger::severity> const &severities) noexcept;
+
 };
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_H
@@ -1,12 +1,26 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_BUILDER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_BUILDER_H
 
+#include <chrono>
+#include <map>
+#include <set>
+
 #include <logger_builder.h>
 
 class server_logger_builder final:
     public logger_builder
 {
 
+private:
+
+    std::string _server_name;
+
+    std::map<std::string, std::set<logger::severity>> _file_streams;
+
+    std::set<logger::severity> _console_stream_severities;
+
+    std::chrono::milliseconds _push_timeout;
+
 public:
 
     server_logger_builder();
@@ -27,6 +41,10 @@ public:
 
 public:
 
+    /*
+     * A relative path is taken from this process's working directory. The log server writes the file
+     * only if it was started with it.
+     */
     logger_builder *add_file_stream(
         std::string const &stream_file_path,
         logger::severity severity) override;
@@ -34,6 +52,19 @@ public:
     logger_builder *add_console_stream(
         logger::severity severity) override;
 
+    /*
+     * Shared memory segment name the log server was started with.
+     */
+    server_logger_builder *set_server_name(
+        std::string const &server_name);
+
+    /*
+     * How long a record waits for free space in a full ring before it is dropped; 0, the default,
+     * drops it at once, so logging never stalls the calling thread.
+     */
+    server_logger_builder *set_push_timeout(
+        std::chrono::milliseconds push_timeout);
+
     logger_builder* transform_with_configuration(
         std::string const &configuration_file_path,
         std::string const &configuration_path) override;
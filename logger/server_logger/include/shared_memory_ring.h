@@ -0,0 +1,127 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_SHARED_MEMORY_RING_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_SHARED_MEMORY_RING_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/*
+ * Multi-producer, single-consumer byte ring in a POSIX shared memory segment.
+ * Records are length-prefixed and pushed whole under a process-shared robust mutex,
+ * so a consumer always pops a batch of complete records.
+ */
+class shared_memory_ring final
+{
+
+public:
+
+    // a quarter of it bounds the size of a record
+    static constexpr size_t min_capacity = 4096;
+
+private:
+
+    struct control_block;
+
+private:
+
+    std::string _name;
+
+    control_block *_control_block;
+
+    size_t _mapping_size;
+
+    // the capacity the mapping was sized for; the control block's copy is writable by every client
+    size_t _capacity;
+
+    bool _is_owner;
+
+    unsigned long long _resets_count;
+
+public:
+
+    /*
+     * Creates the segment, readable and writable by the calling user only; the owner unlinks it on destruction.
+     * Throws std::invalid_argument if capacity is below min_capacity, std::runtime_error if a running process
+     * owns a segment of that name; one left by a process that has died is replaced.
+     */
+    static shared_memory_ring create(
+        std::string const &name,
+        size_t capacity);
+
+    /*
+     * Attaches to a segment created by another process; throws std::runtime_error if there is none.
+     */
+    static shared_memory_ring open(
+        std::string const &name);
+
+private:
+
+    shared_memory_ring(
+        std::string const &name,
+        control_block *mapped_control_block,
+        size_t mapping_size,
+        size_t capacity,
+        bool is_owner) noexcept;
+
+public:
+
+    ~shared_memory_ring() noexcept;
+
+    shared_memory_ring(
+        shared_memory_ring const &other) = delete;
+
+    shared_memory_ring &operator=(
+        shared_memory_ring const &other) = delete;
+
+    shared_memory_ring(
+        shared_memory_ring &&other) noexcept;
+
+    shared_memory_ring &operator=(
+        shared_memory_ring &&other) noexcept;
+
+public:
+
+    [[nodiscard]] size_t get_max_record_size() const noexcept;
+
+    /*
+     * Waits up to timeout for free space, not at all for a zero one; returns false if the record was dropped.
+     */
+    bool push(
+        char const *record,
+        size_t record_size,
+        std::chrono::milliseconds timeout) noexcept;
+
+    /*
+     * Moves every complete record currently in the ring into batch (each prefixed by its uint32_t size).
+     * A ring whose positions don't fit its capacity was corrupted by a client; its contents are discarded
+     * and the reset is counted. Returns false once the ring is closed and drained.
+     */
+    bool pop(
+        std::string &batch,
+        std::chrono::milliseconds timeout);
+
+    void close() noexcept;
+
+    [[nodiscard]] unsigned long long get_dropped_records_count() const noexcept;
+
+    [[nodiscard]] unsigned long long get_resets_count() const noexcept;
+
+private:
+
+    void lock() const noexcept;
+
+    void unlock() const noexcept;
+
+    char *get_data() const noexcept;
+
+    static size_t get_data_offset() noexcept;
+
+    /*
+     * Whether the segment is a ring whose creating process no longer exists.
+     */
+    static bool is_abandoned(
+        std::string const &name) noexcept;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SHARED_MEMORY_RING_H
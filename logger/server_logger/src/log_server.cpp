@@ -0,0 +1,304 @@
+#include "../include/log_server.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+#include <binary_log_format.h>
+
+constexpr unsigned char log_server::open_logger_message;
+
+constexpr unsigned char log_server::close_logger_message;
+
+constexpr unsigned char log_server::record_message;
+
+constexpr char const *log_server::default_name;
+
+constexpr size_t log_server::default_capacity;
+
+namespace
+{
+
+    template<
+        typename T>
+    bool read_value(
+        char const *&position,
+        char const *end,
+        T &value) noexcept
+    {
+        if (static_cast<size_t>(end - position) < sizeof(T))
+        {
+            return false;
+        }
+
+        std::memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+
+        return true;
+    }
+
+    /*
+     * The path with symbolic links, "." and ".." resolved, or an empty string if there is no such file.
+     */
+    std::string canonical_path(
+        std::string const &path)
+    {
+        char *resolved = realpath(path.c_str(), nullptr);
+        if (resolved == nullptr)
+        {
+            return std::string();
+        }
+
+        std::string canonical(resolved);
+        std::free(resolved);
+
+        return canonical;
+    }
+
+}
+
+log_server::log_server(
+    std::string const &name,
+    size_t capacity,
+    std::vector<std::string> const &file_paths):
+        _ring(shared_memory_ring::create(name, capacity)),
+        _processed_records_count(0)
+{
+    try
+    {
+        for (auto &file_path: file_paths)
+        {
+            std::unique_ptr<std::ofstream> opened(new std::ofstream(file_path, std::ios::app));
+            auto const canonical = opened->is_open()
+                ? canonical_path(file_path)
+                : std::string();
+            if (canonical.empty())
+            {
+                throw std::runtime_error("log server can't open file \"" + file_path + "\"");
+            }
+
+            if (_file_sinks.emplace(canonical, opened.get()).second)
+            {
+                opened.release();
+            }
+        }
+    }
+    catch (...)
+    {
+        for (auto &file_sink: _file_sinks)
+        {
+            delete file_sink.second;
+        }
+        throw;
+    }
+}
+
+log_server::~log_server() noexcept
+{
+    for (auto &file_sink: _file_sinks)
+    {
+        delete file_sink.second;
+    }
+}
+
+void log_server::run()
+{
+    std::string batch;
+    auto resets_count = _ring.get_resets_count();
+
+    while (true)
+    {
+        bool const is_open = _ring.pop(batch, std::chrono::milliseconds(100));
+
+        if (_ring.get_resets_count() != resets_count)
+        {
+            resets_count = _ring.get_resets_count();
+            std::cerr << "log server ring was corrupted by a client and has been reset, "
+                << resets_count << " resets so far" << std::endl;
+        }
+
+        char const *position = batch.data();
+        char const *const end = position + batch.size();
+        uint32_t message_size;
+        while (read_value(position, end, message_size) && static_cast<size_t>(end - position) >= message_size)
+        {
+            process(position, message_size);
+            position += message_size;
+        }
+
+        if (!batch.empty())
+        {
+            flush();
+        }
+
+        if (!is_open)
+        {
+            return;
+        }
+    }
+}
+
+void log_server::stop() noexcept
+{
+    _ring.close();
+}
+
+unsigned long long log_server::get_processed_records_count() const noexcept
+{
+    return _processed_records_count;
+}
+
+unsigned char log_server::severity_to_mask(
+    logger::severity severity) noexcept
+{
+    return static_cast<unsigned char>(1u << static_cast<unsigned>(severity));
+}
+
+void log_server::process(
+    char const *message,
+    size_t message_size)
+{
+    char const *position = message;
+    char const *const end = message + message_size;
+
+    unsigned char message_type;
+    uint64_t logger_id;
+    if (!read_value(position, end, message_type) || !read_value(position, end, logger_id))
+    {
+        return;
+    }
+
+    switch (message_type)
+    {
+        case open_logger_message:
+            open_logger(logger_id, position, end);
+            break;
+        case close_logger_message:
+            close_logger(logger_id);
+            break;
+        case record_message:
+        {
+            int64_t timestamp;
+            unsigned char severity;
+            if (read_value(position, end, timestamp)
+                && read_value(position, end, severity)
+                && severity <= static_cast<unsigned char>(logger::severity::critical))
+            {
+                write_record(logger_id, timestamp, static_cast<logger::severity>(severity), position, static_cast<size_t>(end - position));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void log_server::open_logger(
+    uint64_t logger_id,
+    char const *message,
+    char const *message_end)
+{
+    close_logger(logger_id);
+
+    logger_streams streams;
+    uint32_t streams_count;
+    if (!read_value(message, message_end, streams.console_severities_mask)
+        || !read_value(message, message_end, streams_count))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < streams_count; ++i)
+    {
+        unsigned char severities_mask;
+        uint32_t path_size;
+        if (!read_value(message, message_end, severities_mask)
+            || !read_value(message, message_end, path_size)
+            || static_cast<size_t>(message_end - message) < path_size)
+        {
+            break;
+        }
+
+        std::string path(message, path_size);
+        message += path_size;
+
+        // a relative path would be resolved against the server's working directory instead of the client's
+        if (path.empty() || path.front() != '/')
+        {
+            continue;
+        }
+
+        auto found = _file_sinks.find(canonical_path(path));
+        if (found == _file_sinks.end())
+        {
+            continue;
+        }
+
+        streams.file_sinks.emplace_back(found->second, severities_mask);
+    }
+
+    _loggers.emplace(logger_id, std::move(streams));
+}
+
+void log_server::close_logger(
+    uint64_t logger_id) noexcept
+{
+    _loggers.erase(logger_id);
+}
+
+void log_server::write_record(
+    uint64_t logger_id,
+    int64_t timestamp,
+    logger::severity severity,
+    char const *text,
+    size_t text_size)
+{
+    auto found = _loggers.find(logger_id);
+    if (found == _loggers.end())
+    {
+        return;
+    }
+
+    auto const mask = severity_to_mask(severity);
+    std::string line;
+
+    auto formatted_line = [&line, timestamp, severity, text, text_size]() -> std::string const &
+    {
+        if (line.empty())
+        {
+            line = binary_log_format::render_line(timestamp, severity, std::string(text, text_size));
+            line.push_back('\n');
+        }
+
+        return line;
+    };
+
+    for (auto &file_sink: found->second.file_sinks)
+    {
+        if ((file_sink.second & mask) != 0)
+        {
+            auto const &rendered = formatted_line();
+            file_sink.first->write(rendered.data(), static_cast<std::streamsize>(rendered.size()));
+        }
+    }
+
+    if ((found->second.console_severities_mask & mask) != 0)
+    {
+        auto const &rendered = formatted_line();
+        std::cout.write(rendered.data(), static_cast<std::streamsize>(rendered.size()));
+    }
+
+    ++_processed_records_count;
+}
+
+void log_server::flush() noexcept
+{
+    for (auto &file_sink: _file_sinks)
+    {
+        file_sink.second->flush();
+    }
+
+    std::cout.flush();
+}
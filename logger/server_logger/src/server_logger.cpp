@@ -1,39 +1,230 @@
-#include <not_implemented.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
 
+#include <unistd.h>
+
+#include <binary_log_format.h>
+
+#include "../include/log_server.h"
 #include "../include/server_logger.h"
 
+namespace
+{
+
+    std::chrono::milliseconds const control_message_timeout(1000);
+
+    template<
+        typename T>
+    void append_value(
+        std::string &buffer,
+        T value)
+    {
+        buffer.append(reinterpret_cast<char const *>(&value), sizeof(T));
+    }
+
+    uint64_t next_logger_id() noexcept
+    {
+        static std::atomic<uint32_t> loggers_count(0);
+
+        return (static_cast<uint64_t>(getpid()) << 32) | ++loggers_count;
+    }
+
+}
+
 server_logger::server_logger(
-    server_logger const &other)
+    std::string const &server_name,
+    std::map<std::string, std::set<logger::severity>> const &file_streams,
+    std::set<logger::severity> const &console_stream_severities,
+    std::chrono::milliseconds push_timeout):
+        _server_name(server_name),
+        _ring(connect(server_name)),
+        _logger_id(next_logger_id()),
+        _file_streams(file_streams),
+        _console_stream_severities(console_stream_severities),
+        _severities_mask(severities_to_mask(console_stream_severities)),
+        _push_timeout(push_timeout),
+        _dropped_records_count(0)
+{
+    for (auto &file_stream: _file_streams)
+    {
+        _severities_mask |= severities_to_mask(file_stream.second);
+    }
+
+    open();
+}
+
+server_logger::server_logger(
+    server_logger const &other):
+        _server_name(other._server_name),
+        _ring(other._ring),
+        _logger_id(next_logger_id()),
+        _file_streams(other._file_streams),
+        _console_stream_severities(other._console_stream_severities),
+        _severities_mask(other._severities_mask),
+        _push_timeout(other._push_timeout),
+        _dropped_records_count(0)
 {
-    throw not_implemented("server_logger::server_logger(server_logger const &other)", "your code should be here...");
+    open();
 }
 
 server_logger &server_logger::operator=(
     server_logger const &other)
 {
-    throw not_implemented("server_logger &server_logger::operator=(server_logger const &other)", "your code should be here...");
+    if (this != &other)
+    {
+        server_logger copy(other);
+        *this = std::move(copy);
+    }
+
+    return *this;
 }
 
 server_logger::server_logger(
-    server_logger &&other) noexcept
+    server_logger &&other) noexcept:
+        _server_name(std::move(other._server_name)),
+        _ring(std::move(other._ring)),
+        _logger_id(other._logger_id),
+        _file_streams(std::move(other._file_streams)),
+        _console_stream_severities(std::move(other._console_stream_severities)),
+        _severities_mask(other._severities_mask),
+        _push_timeout(other._push_timeout),
+        _dropped_records_count(other._dropped_records_count.load(std::memory_order_relaxed))
 {
-    throw not_implemented("server_logger::server_logger(server_logger &&other) noexcept", "your code should be here...");
+    other._severities_mask = 0;
 }
 
 server_logger &server_logger::operator=(
     server_logger &&other) noexcept
 {
-    throw not_implemented("server_logger &server_logger::operator=(server_logger &&other) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        close();
+
+        _server_name = std::move(other._server_name);
+        _ring = std::move(other._ring);
+        _logger_id = other._logger_id;
+        _file_streams = std::move(other._file_streams);
+        _console_stream_severities = std::move(other._console_stream_severities);
+        _severities_mask = other._severities_mask;
+        _push_timeout = other._push_timeout;
+        _dropped_records_count.store(other._dropped_records_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        other._severities_mask = 0;
+    }
+
+    return *this;
 }
 
 server_logger::~server_logger() noexcept
 {
-    throw not_implemented("server_logger::~server_logger() noexcept", "your code should be here...");
+    close();
 }
 
 logger const *server_logger::log(
     const std::string &text,
     logger::severity severity) const noexcept
 {
-    throw not_implemented("logger const *server_logger::log(const std::string &text, logger::severity severity) const noexcept", "your code should be here...");
-}
\ No newline at end of file
+    return log(logger::message_view(text), severity);
+}
+
+logger const *server_logger::log(
+    logger::message_view text,
+    logger::severity severity) const noexcept
+{
+    if ((_severities_mask & log_server::severity_to_mask(severity)) == 0)
+    {
+        return this;
+    }
+
+    // reused between calls, so steady-state logging does not allocate
+    thread_local std::string record;
+
+    record.clear();
+    append_value(record, log_server::record_message);
+    append_value(record, _logger_id);
+    append_value(record, binary_log_format::current_timestamp());
+    append_value(record, static_cast<unsigned char>(severity));
+    record.append(text.data(), std::min(text.size(), _ring->get_max_record_size() - record.size()));
+
+    if (!_ring->push(record.data(), record.size(), _push_timeout))
+    {
+        _dropped_records_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return this;
+}
+
+unsigned long long server_logger::get_dropped_records_count() const noexcept
+{
+    return _dropped_records_count.load(std::memory_order_relaxed);
+}
+
+void server_logger::open()
+{
+    std::string message;
+
+    append_value(message, log_server::open_logger_message);
+    append_value(message, _logger_id);
+    append_value(message, severities_to_mask(_console_stream_severities));
+    append_value(message, static_cast<uint32_t>(_file_streams.size()));
+    for (auto &file_stream: _file_streams)
+    {
+        append_value(message, severities_to_mask(file_stream.second));
+        append_value(message, static_cast<uint32_t>(file_stream.first.size()));
+        message += file_stream.first;
+    }
+
+    if (!_ring->push(message.data(), message.size(), control_message_timeout))
+    {
+        throw std::runtime_error("log server \"" + _server_name + "\" does not accept messages");
+    }
+}
+
+void server_logger::close() noexcept
+{
+    if (_ring == nullptr)
+    {
+        return;
+    }
+
+    char message[sizeof(log_server::close_logger_message) + sizeof(_logger_id)];
+    message[0] = static_cast<char>(log_server::close_logger_message);
+    std::memcpy(message + 1, &_logger_id, sizeof(_logger_id));
+
+    _ring->push(message, sizeof(message), control_message_timeout);
+    _ring.reset();
+}
+
+std::shared_ptr<shared_memory_ring> server_logger::connect(
+    std::string const &server_name)
+{
+    // one mapping per log server and process, released with the last logger using it
+    static std::mutex connections_guard;
+    static std::map<std::string, std::weak_ptr<shared_memory_ring>> connections;
+
+    std::lock_guard<std::mutex> lock(connections_guard);
+
+    auto connection = connections[server_name].lock();
+    if (connection == nullptr)
+    {
+        connection = std::make_shared<shared_memory_ring>(shared_memory_ring::open(server_name));
+        connections[server_name] = connection;
+    }
+
+    return connection;
+}
+
+unsigned char server_logger::severities_to_mask(
+    std::set<logger::severity> const &severities) noexcept
+{
+    unsigned char mask = 0;
+
+    for (auto severity: severities)
+    {
+        mask |= log_server::severity_to_mask(severity);
+    }
+
+    return mask;
+}
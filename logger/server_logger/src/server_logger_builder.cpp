@@ -1,67 +1,136 @@
-#include <not_implemented.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
 
+#include <unistd.h>
+
+#include <logger_configuration.h>
+
+#include "../include/log_server.h"
+#include "../include/server_logger.h"
 #include "../include/server_logger_builder.h"
 
-server_logger_builder::server_logger_builder()
+namespace
 {
-    throw not_implemented("server_logger_builder::server_logger_builder()", "your code should be here...");
+
+    /*
+     * The log server runs in another working directory, so relative paths are resolved here.
+     */
+    std::string absolute_path(
+        std::string const &path)
+    {
+        if (!path.empty() && path.front() == '/')
+        {
+            return path;
+        }
+
+        std::string working_directory(256, '\0');
+        while (getcwd(&working_directory[0], working_directory.size()) == nullptr)
+        {
+            if (errno != ERANGE)
+            {
+                throw std::runtime_error("can't resolve log file path \"" + path + "\": " + std::strerror(errno));
+            }
+            working_directory.resize(working_directory.size() * 2);
+        }
+        working_directory.resize(std::strlen(working_directory.c_str()));
+
+        return working_directory + "/" + path;
+    }
+
 }
 
-server_logger_builder::server_logger_builder(
-    server_logger_builder const &other)
+server_logger_builder::server_logger_builder():
+    _server_name(log_server::default_name),
+    _push_timeout(0)
 {
-    throw not_implemented("server_logger_builder::server_logger_builder(server_logger_builder const &other)", "your code should be here...");
+
 }
 
+server_logger_builder::server_logger_builder(
+    server_logger_builder const &other) = default;
+
 server_logger_builder &server_logger_builder::operator=(
-    server_logger_builder const &other)
-{
-    throw not_implemented("server_logger_builder &server_logger_builder::operator=(server_logger_builder const &other)", "your code should be here...");
-}
+    server_logger_builder const &other) = default;
 
 server_logger_builder::server_logger_builder(
-    server_logger_builder &&other) noexcept
-{
-    throw not_implemented("server_logger_builder::server_logger_builder(server_logger_builder &&other) noexcept", "your code should be here...");
-}
+    server_logger_builder &&other) noexcept = default;
 
 server_logger_builder &server_logger_builder::operator=(
-    server_logger_builder &&other) noexcept
-{
-    throw not_implemented("server_logger_builder &server_logger_builder::operator=(server_logger_builder &&other) noexcept", "your code should be here...");
-}
+    server_logger_builder &&other) noexcept = default;
 
-server_logger_builder::~server_logger_builder() noexcept
-{
-    throw not_implemented("server_logger_builder::~server_logger_builder() noexcept", "your code should be here...");
-}
+server_logger_builder::~server_logger_builder() noexcept = default;
 
 logger_builder *server_logger_builder::add_file_stream(
     std::string const &stream_file_path,
     logger::severity severity)
 {
-    throw not_implemented("logger_builder *server_logger_builder::add_file_stream(std::string const &stream_file_path, logger::severity severity)", "your code should be here...");
+    _file_streams[absolute_path(stream_file_path)].insert(severity);
+
+    return this;
 }
 
 logger_builder *server_logger_builder::add_console_stream(
     logger::severity severity)
 {
-    throw not_implemented("logger_builder *server_logger_builder::add_console_stream(logger::severity severity)", "your code should be here...");
+    _console_stream_severities.insert(severity);
+
+    return this;
+}
+
+server_logger_builder *server_logger_builder::set_server_name(
+    std::string const &server_name)
+{
+    _server_name = server_name;
+
+    return this;
+}
+
+server_logger_builder *server_logger_builder::set_push_timeout(
+    std::chrono::milliseconds push_timeout)
+{
+    _push_timeout = push_timeout;
+
+    return this;
 }
 
 logger_builder* server_logger_builder::transform_with_configuration(
     std::string const &configuration_file_path,
     std::string const &configuration_path)
 {
-    throw not_implemented("logger_builder* server_logger_builder::transform_with_configuration(std::string const &configuration_file_path, std::string const &configuration_path)", "your code should be here...");
+    auto const configuration = logger_configuration::load(configuration_file_path, configuration_path);
+
+    if (!configuration.get_binary_file_streams().empty())
+    {
+        throw std::logic_error("server_logger does not support binary file streams");
+    }
+
+    for (auto &file_stream: configuration.get_file_streams())
+    {
+        _file_streams[absolute_path(file_stream.first)].insert(file_stream.second.begin(), file_stream.second.end());
+    }
+    _console_stream_severities.insert(
+        configuration.get_console_stream_severities().begin(),
+        configuration.get_console_stream_severities().end());
+    if (!configuration.get_server_name().empty())
+    {
+        _server_name = configuration.get_server_name();
+    }
+
+    return this;
 }
 
 logger_builder *server_logger_builder::clear()
 {
-    throw not_implemented("logger_builder *server_logger_builder::clear()", "your code should be here...");
+    _server_name = log_server::default_name;
+    _file_streams.clear();
+    _console_stream_severities.clear();
+    _push_timeout = std::chrono::milliseconds(0);
+
+    return this;
 }
 
 logger *server_logger_builder::build() const
 {
-    throw not_implemented("logger *server_logger_builder::build() const", "your code should be here...");
-}
\ No newline at end of file
+    return new server_logger(_server_name, _file_streams, _console_stream_severities, _push_timeout);
+}
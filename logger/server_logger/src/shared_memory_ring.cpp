@@ -0,0 +1,460 @@
+#include "../include/shared_memory_ring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct shared_memory_ring::control_block final
+{
+
+    uint64_t magic;
+
+    // the creating server, so that a later one can tell a live ring from an abandoned one
+    int64_t owner_process_id;
+
+    pthread_mutex_t guard;
+
+    pthread_cond_t not_empty;
+
+    pthread_cond_t not_full;
+
+    uint64_t written;
+
+    uint64_t read;
+
+    uint64_t dropped_records;
+
+    uint32_t is_closed;
+
+};
+
+constexpr size_t shared_memory_ring::min_capacity;
+
+namespace
+{
+
+    uint64_t const ring_magic = 0x474e4952534f504dULL;
+
+    size_t const record_size_prefix = sizeof(uint32_t);
+
+    timespec deadline_after(
+        std::chrono::milliseconds timeout) noexcept
+    {
+        timespec deadline{};
+        clock_gettime(CLOCK_REALTIME, &deadline);
+
+        auto const nanoseconds = deadline.tv_nsec + (timeout.count() % 1000) * 1000000;
+        deadline.tv_sec += static_cast<time_t>(timeout.count() / 1000 + nanoseconds / 1000000000);
+        deadline.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+
+        return deadline;
+    }
+
+    void copy_in(
+        char *data,
+        uint64_t capacity,
+        uint64_t position,
+        char const *source,
+        size_t size) noexcept
+    {
+        auto const offset = static_cast<size_t>(position % capacity);
+        auto const first_part = std::min(size, static_cast<size_t>(capacity) - offset);
+
+        std::memcpy(data + offset, source, first_part);
+        std::memcpy(data, source + first_part, size - first_part);
+    }
+
+    void copy_out(
+        char const *data,
+        uint64_t capacity,
+        uint64_t position,
+        char *destination,
+        size_t size) noexcept
+    {
+        auto const offset = static_cast<size_t>(position % capacity);
+        auto const first_part = std::min(size, static_cast<size_t>(capacity) - offset);
+
+        std::memcpy(destination, data + offset, first_part);
+        std::memcpy(destination + first_part, data, size - first_part);
+    }
+
+}
+
+shared_memory_ring shared_memory_ring::create(
+    std::string const &name,
+    size_t capacity)
+{
+    if (capacity < min_capacity)
+    {
+        throw std::invalid_argument("shared memory ring capacity " + std::to_string(capacity)
+            + " is below the minimum of " + std::to_string(min_capacity));
+    }
+
+    // only the owner's processes may push records: the server writes them into its files
+    int descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (descriptor == -1 && errno == EEXIST && is_abandoned(name))
+    {
+        shm_unlink(name.c_str());
+        descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    if (descriptor == -1)
+    {
+        throw std::runtime_error(errno == EEXIST
+            ? "log server \"" + name + "\" is already running"
+            : "can't create shared memory segment \"" + name + "\": " + std::strerror(errno));
+    }
+
+    auto const mapping_size = get_data_offset() + capacity;
+    if (ftruncate(descriptor, static_cast<off_t>(mapping_size)) == -1)
+    {
+        ::close(descriptor);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("can't resize shared memory segment \"" + name + "\": " + std::strerror(errno));
+    }
+
+    void *mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        throw std::runtime_error("can't map shared memory segment \"" + name + "\": " + std::strerror(errno));
+    }
+
+    auto *created = static_cast<control_block *>(mapping);
+
+    pthread_mutexattr_t mutex_attributes;
+    pthread_mutexattr_init(&mutex_attributes);
+    pthread_mutexattr_setpshared(&mutex_attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutex_attributes, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&created->guard, &mutex_attributes);
+    pthread_mutexattr_destroy(&mutex_attributes);
+
+    pthread_condattr_t condition_attributes;
+    pthread_condattr_init(&condition_attributes);
+    pthread_condattr_setpshared(&condition_attributes, PTHREAD_PROCESS_SHARED);
+    pthread_cond_init(&created->not_empty, &condition_attributes);
+    pthread_cond_init(&created->not_full, &condition_attributes);
+    pthread_condattr_destroy(&condition_attributes);
+
+    created->owner_process_id = static_cast<int64_t>(getpid());
+    created->written = 0;
+    created->read = 0;
+    created->dropped_records = 0;
+    created->is_closed = 0;
+    __atomic_store_n(&created->magic, ring_magic, __ATOMIC_RELEASE);
+
+    return shared_memory_ring(name, created, mapping_size, capacity, true);
+}
+
+shared_memory_ring shared_memory_ring::open(
+    std::string const &name)
+{
+    int descriptor = shm_open(name.c_str(), O_RDWR, 0);
+    if (descriptor == -1)
+    {
+        throw std::runtime_error("log server \"" + name + "\" is not running: " + std::strerror(errno));
+    }
+
+    struct stat segment_status{};
+    if (fstat(descriptor, &segment_status) == -1 || static_cast<size_t>(segment_status.st_size) <= get_data_offset())
+    {
+        ::close(descriptor);
+        throw std::runtime_error("shared memory segment \"" + name + "\" is not initialized");
+    }
+
+    auto const mapping_size = static_cast<size_t>(segment_status.st_size);
+    void *mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("can't map shared memory segment \"" + name + "\": " + std::strerror(errno));
+    }
+
+    auto *opened = static_cast<control_block *>(mapping);
+    if (__atomic_load_n(&opened->magic, __ATOMIC_ACQUIRE) != ring_magic)
+    {
+        munmap(mapping, mapping_size);
+        throw std::runtime_error("shared memory segment \"" + name + "\" is not a log server ring");
+    }
+
+    return shared_memory_ring(name, opened, mapping_size, mapping_size - get_data_offset(), false);
+}
+
+bool shared_memory_ring::is_abandoned(
+    std::string const &name) noexcept
+{
+    int descriptor = shm_open(name.c_str(), O_RDONLY, 0);
+    if (descriptor == -1)
+    {
+        return false;
+    }
+
+    struct stat segment_status{};
+    if (fstat(descriptor, &segment_status) == -1 || static_cast<size_t>(segment_status.st_size) < sizeof(control_block))
+    {
+        // a server still initializing its ring, or not a ring at all: neither is ours to take
+        ::close(descriptor);
+        return false;
+    }
+
+    void *mapping = mmap(nullptr, sizeof(control_block), PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    auto const *existing = static_cast<control_block const *>(mapping);
+    auto const is_ring = __atomic_load_n(&existing->magic, __ATOMIC_ACQUIRE) == ring_magic;
+    auto const owner_process_id = static_cast<pid_t>(existing->owner_process_id);
+    munmap(mapping, sizeof(control_block));
+
+    return is_ring && kill(owner_process_id, 0) == -1 && errno == ESRCH;
+}
+
+shared_memory_ring::shared_memory_ring(
+    std::string const &name,
+    control_block *mapped_control_block,
+    size_t mapping_size,
+    size_t capacity,
+    bool is_owner) noexcept:
+        _name(name),
+        _control_block(mapped_control_block),
+        _mapping_size(mapping_size),
+        _capacity(capacity),
+        _is_owner(is_owner),
+        _resets_count(0)
+{
+
+}
+
+shared_memory_ring::~shared_memory_ring() noexcept
+{
+    if (_control_block == nullptr)
+    {
+        return;
+    }
+
+    munmap(_control_block, _mapping_size);
+    if (_is_owner)
+    {
+        shm_unlink(_name.c_str());
+    }
+}
+
+shared_memory_ring::shared_memory_ring(
+    shared_memory_ring &&other) noexcept:
+        _name(std::move(other._name)),
+        _control_block(other._control_block),
+        _mapping_size(other._mapping_size),
+        _capacity(other._capacity),
+        _is_owner(other._is_owner),
+        _resets_count(other._resets_count)
+{
+    other._control_block = nullptr;
+}
+
+shared_memory_ring &shared_memory_ring::operator=(
+    shared_memory_ring &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (_control_block != nullptr)
+        {
+            munmap(_control_block, _mapping_size);
+            if (_is_owner)
+            {
+                shm_unlink(_name.c_str());
+            }
+        }
+
+        _name = std::move(other._name);
+        _control_block = other._control_block;
+        _mapping_size = other._mapping_size;
+        _capacity = other._capacity;
+        _is_owner = other._is_owner;
+        _resets_count = other._resets_count;
+
+        other._control_block = nullptr;
+    }
+
+    return *this;
+}
+
+size_t shared_memory_ring::get_max_record_size() const noexcept
+{
+    // a single record may take at most a quarter of the ring, so writers never starve each other
+    return _capacity / 4 - record_size_prefix;
+}
+
+bool shared_memory_ring::push(
+    char const *record,
+    size_t record_size,
+    std::chrono::milliseconds timeout) noexcept
+{
+    if (record_size > get_max_record_size())
+    {
+        return false;
+    }
+
+    auto const total_size = record_size_prefix + record_size;
+    auto const prefix = static_cast<uint32_t>(record_size);
+    auto const deadline = deadline_after(timeout);
+
+    lock();
+
+    while (timeout.count() > 0
+        && _control_block->is_closed == 0
+        && _capacity - (_control_block->written - _control_block->read) < total_size)
+    {
+        int result = pthread_cond_timedwait(&_control_block->not_full, &_control_block->guard, &deadline);
+        if (result == EOWNERDEAD)
+        {
+            pthread_mutex_consistent(&_control_block->guard);
+        }
+        else if (result == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+
+    if (_control_block->is_closed != 0
+        || _control_block->written - _control_block->read > _capacity
+        || _capacity - (_control_block->written - _control_block->read) < total_size)
+    {
+        ++_control_block->dropped_records;
+        unlock();
+        return false;
+    }
+
+    auto *data = get_data();
+    copy_in(data, _capacity, _control_block->written, reinterpret_cast<char const *>(&prefix), record_size_prefix);
+    copy_in(data, _capacity, _control_block->written + record_size_prefix, record, record_size);
+
+    bool const was_empty = _control_block->written == _control_block->read;
+    _control_block->written += total_size;
+
+    unlock();
+
+    if (was_empty)
+    {
+        pthread_cond_signal(&_control_block->not_empty);
+    }
+
+    return true;
+}
+
+bool shared_memory_ring::pop(
+    std::string &batch,
+    std::chrono::milliseconds timeout)
+{
+    auto const deadline = deadline_after(timeout);
+
+    batch.clear();
+
+    lock();
+
+    while (_control_block->is_closed == 0 && _control_block->written == _control_block->read)
+    {
+        int result = pthread_cond_timedwait(&_control_block->not_empty, &_control_block->guard, &deadline);
+        if (result == EOWNERDEAD)
+        {
+            pthread_mutex_consistent(&_control_block->guard);
+        }
+        else if (result == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+
+    auto available = _control_block->written - _control_block->read;
+    if (available > _capacity)
+    {
+        // the positions were overwritten; nothing between them can be trusted to be a record
+        _control_block->read = _control_block->written;
+        available = 0;
+        ++_resets_count;
+    }
+
+    bool const is_drained = _control_block->is_closed != 0 && available == 0;
+
+    try
+    {
+        batch.resize(available);
+    }
+    catch (...)
+    {
+        unlock();
+        throw;
+    }
+
+    copy_out(get_data(), _capacity, _control_block->read, &batch[0], available);
+    _control_block->read += available;
+
+    unlock();
+
+    if (available != 0)
+    {
+        pthread_cond_broadcast(&_control_block->not_full);
+    }
+
+    return !is_drained;
+}
+
+void shared_memory_ring::close() noexcept
+{
+    lock();
+    _control_block->is_closed = 1;
+    unlock();
+
+    pthread_cond_broadcast(&_control_block->not_empty);
+    pthread_cond_broadcast(&_control_block->not_full);
+}
+
+unsigned long long shared_memory_ring::get_dropped_records_count() const noexcept
+{
+    lock();
+    auto const dropped_records = _control_block->dropped_records;
+    unlock();
+
+    return dropped_records;
+}
+
+unsigned long long shared_memory_ring::get_resets_count() const noexcept
+{
+    return _resets_count;
+}
+
+void shared_memory_ring::lock() const noexcept
+{
+    if (pthread_mutex_lock(&_control_block->guard) == EOWNERDEAD)
+    {
+        // a writer died while holding the lock: records are pushed whole, so the ring itself is consistent
+        pthread_mutex_consistent(&_control_block->guard);
+    }
+}
+
+void shared_memory_ring::unlock() const noexcept
+{
+    pthread_mutex_unlock(&_control_block->guard);
+}
+
+char *shared_memory_ring::get_data() const noexcept
+{
+    return reinterpret_cast<char *>(_control_block) + get_data_offset();
+}
+
+size_t shared_memory_ring::get_data_offset() noexcept
+{
+    return (sizeof(control_block) + 63) & ~size_t(63);
+}
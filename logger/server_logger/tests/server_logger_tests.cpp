@@ -1,6 +1,312 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+#include <thread>
 
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <log_server.h>
+#include <server_logger.h>
+
+namespace
+{
+
+    std::vector<std::string> read_lines(
+        std::string const &file_path)
+    {
+        std::ifstream stream(file_path);
+        std::vector<std::string> lines;
+        std::string line;
+
+        while (std::getline(stream, line))
+        {
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+
+    std::string server_name(
+        std::string const &test_name)
+    {
+        return "/mp_os_server_logger_tests_" + test_name + "_" + std::to_string(getpid());
+    }
+
+}
+
+TEST(server_logger_tests, records_reach_server_sinks)
+{
+    std::string const name = server_name("records");
+    std::string const file_path = "server_logger_tests_records.txt";
+    std::remove(file_path.c_str());
+
+    log_server server(name, 1 << 16, { file_path });
+    std::thread worker(&log_server::run, &server);
+
+    server_logger_builder builder;
+    builder
+        .set_server_name(name)
+        ->add_file_stream(file_path, logger::severity::warning);
+
+    logger *built_logger = builder.build();
+    built_logger
+        ->information("filtered on the client")
+        ->warning("first")
+        ->warning("second");
+    delete built_logger;
+
+    server.stop();
+    worker.join();
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("][WARNING] first"), std::string::npos);
+    EXPECT_NE(lines[1].find("][WARNING] second"), std::string::npos);
+    EXPECT_EQ(server.get_processed_records_count(), 2);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(server_logger_tests, concurrent_loggers_share_server_sink)
+{
+    std::string const name = server_name("concurrent");
+    std::string const file_path = "server_logger_tests_concurrent.txt";
+    std::remove(file_path.c_str());
+
+    size_t const threads_count = 8;
+    size_t const messages_per_thread = 2000;
+    std::string const message(48, 'x');
+
+    // small ring: writers have to wait for the server to catch up
+    log_server server(name, 1 << 14, { file_path });
+    std::thread worker(&log_server::run, &server);
+
+    server_logger_builder builder;
+    builder
+        .set_server_name(name)
+        ->set_push_timeout(std::chrono::milliseconds(100))
+        ->add_file_stream(file_path, logger::severity::information);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threads_count; ++i)
+    {
+        threads.emplace_back([&builder, &message, messages_per_thread]()
+        {
+            logger *built_logger = builder.build();
+            for (size_t j = 0; j < messages_per_thread; ++j)
+            {
+                built_logger->information(message);
+            }
+            delete built_logger;
+        });
+    }
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+
+    server.stop();
+    worker.join();
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), threads_count * messages_per_thread);
+    for (auto &line: lines)
+    {
+        ASSERT_EQ(line.substr(line.size() - message.size()), message);
+    }
+
+    std::remove(file_path.c_str());
+}
+
+TEST(server_logger_tests, full_ring_drops_records_without_waiting)
+{
+    std::string const name = server_name("full");
+    std::string const file_path = "server_logger_tests_full.txt";
+    std::remove(file_path.c_str());
+
+    // nothing consumes the ring until it has overflowed
+    log_server server(name, shared_memory_ring::min_capacity, { file_path });
+
+    server_logger_builder builder;
+    builder
+        .set_server_name(name)
+        ->add_file_stream(file_path, logger::severity::information);
+
+    auto *built_logger = dynamic_cast<server_logger *>(builder.build());
+    ASSERT_NE(built_logger, nullptr);
+
+    size_t const messages_count = 1000;
+    auto const started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages_count; ++i)
+    {
+        built_logger->information(std::string(64, 'x'));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(500));
+
+    auto const dropped_records_count = built_logger->get_dropped_records_count();
+    EXPECT_GT(dropped_records_count, 0);
+
+    std::thread worker(&log_server::run, &server);
+    delete built_logger;
+    server.stop();
+    worker.join();
+
+    EXPECT_EQ(read_lines(file_path).size() + dropped_records_count, messages_count);
+
+    std::remove(file_path.c_str());
+}
+
+TEST(server_logger_tests, configuration_selects_server_and_sinks)
+{
+    std::string const name = server_name("configuration");
+    std::string const file_path = "server_logger_tests_configuration.txt";
+    std::string const configuration_file_path = "server_logger_tests_configuration.json";
+    std::remove(file_path.c_str());
+
+    {
+        std::ofstream configuration(configuration_file_path);
+        configuration << R"({ "server": { "server_name": ")" << name << R"(", "files": { ")" << file_path << R"(": "error" } } })";
+    }
+
+    log_server server(name, 1 << 16, { file_path });
+    std::thread worker(&log_server::run, &server);
+
+    server_logger_builder builder;
+    builder.transform_with_configuration(configuration_file_path, "server");
+
+    logger *built_logger = builder.build();
+    built_logger
+        ->warning("skipped")
+        ->error("configured");
+    delete built_logger;
+
+    server.stop();
+    worker.join();
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_NE(lines[0].find("][ERROR] configured"), std::string::npos);
+
+    std::remove(file_path.c_str());
+    std::remove(configuration_file_path.c_str());
+}
+
+TEST(server_logger_tests, server_writes_only_its_own_files)
+{
+    std::string const name = server_name("own_files");
+    std::string const file_path = "server_logger_tests_own_files.txt";
+    std::string const other_file_path = "server_logger_tests_other_files.txt";
+    std::remove(file_path.c_str());
+    std::remove(other_file_path.c_str());
+
+    log_server server(name, 1 << 16, { file_path });
+    std::thread worker(&log_server::run, &server);
+
+    server_logger_builder builder;
+    builder
+        .set_server_name(name)
+        ->add_file_stream("./" + file_path, logger::severity::information)
+        ->add_file_stream(other_file_path, logger::severity::information);
+
+    logger *built_logger = builder.build();
+    built_logger->information("allowed");
+    delete built_logger;
+
+    server.stop();
+    worker.join();
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_NE(lines[0].find("][INFORMATION] allowed"), std::string::npos);
+    EXPECT_FALSE(std::ifstream(other_file_path).is_open());
+
+    std::remove(file_path.c_str());
+}
+
+TEST(server_logger_tests, relative_paths_are_resolved_by_client)
+{
+    std::string const name = server_name("relative");
+    std::string const file_path = "server_logger_tests_relative.txt";
+    std::string const directory = "server_logger_tests_relative";
+    std::remove(file_path.c_str());
+    mkdir(directory.c_str(), 0700);
+
+    log_server server(name, 1 << 16, { file_path });
+    std::thread worker(&log_server::run, &server);
+
+    // the client's working directory differs from the one the server resolved its files in
+    ASSERT_EQ(chdir(directory.c_str()), 0);
+    server_logger_builder builder;
+    builder
+        .set_server_name(name)
+        ->add_file_stream("../" + file_path, logger::severity::information);
+    ASSERT_EQ(chdir(".."), 0);
+
+    logger *built_logger = builder.build();
+    built_logger->information("resolved");
+    delete built_logger;
+
+    server.stop();
+    worker.join();
+
+    auto lines = read_lines(file_path);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_NE(lines[0].find("][INFORMATION] resolved"), std::string::npos);
+
+    std::remove(file_path.c_str());
+    rmdir(directory.c_str());
+}
+
+TEST(server_logger_tests, abandoned_ring_is_replaced)
+{
+    std::string const name = server_name("abandoned");
+
+    // the child exits without destroying its server, as a crashed one would
+    pid_t server_process = fork();
+    if (server_process == 0)
+    {
+        log_server server(name, 1 << 16);
+        _exit(0);
+    }
+    ASSERT_NE(server_process, -1);
+    waitpid(server_process, nullptr, 0);
+
+    EXPECT_NO_THROW(log_server replacement(name, 1 << 16));
+}
+
+TEST(server_logger_tests, second_server_fails_under_same_name)
+{
+    std::string const name = server_name("second");
+
+    log_server server(name, 1 << 16);
+
+    EXPECT_THROW(log_server second(name, 1 << 16), std::runtime_error);
+}
+
+TEST(server_logger_tests, small_capacity_is_rejected)
+{
+    std::string const name = server_name("small");
+
+    EXPECT_THROW(shared_memory_ring::create(name, 0), std::invalid_argument);
+    EXPECT_THROW(log_server server(name, shared_memory_ring::min_capacity - 1), std::invalid_argument);
+
+    // nothing was created under the name
+    EXPECT_THROW(shared_memory_ring::open(name), std::runtime_error);
+    EXPECT_NO_THROW(log_server server(name, shared_memory_ring::min_capacity));
+}
+
+TEST(server_logger_tests, build_fails_without_server)
+{
+    server_logger_builder builder;
+    builder
+        .set_server_name(server_name("missing"))
+        ->add_console_stream(logger::severity::information);
+
+    EXPECT_THROW(delete builder.build(), std::runtime_error);
+}
 
 int main(
     int argc,
@@ -9,4 +315,4 @@ int main(
     testing::InitGoogleTest(&argc, argv);
 
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}